@@ -0,0 +1,97 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <atomic>
+#include <cstdlib> //getenv
+
+//x86-64 kernels are compiled with target attributes and selected at runtime
+#if defined(__GNUC__) && defined(__x86_64__)
+#  define CPU_FEATURES_X86
+#  include <immintrin.h>
+#endif
+
+/***********************************************************************
+ * Runtime CPU feature checks for the SIMD kernel dispatch.
+ *
+ * The CPU is probed once, and every check also honors the force scalar
+ * switch, so that the scalar reference code can be tested on any CPU.
+ * The switch starts set when the POTHOS_COMMS_FORCE_SCALAR environment
+ * variable is defined, and tests can flip it with setForceScalar().
+ * SSE2 is part of x86-64, so it is only turned off by the switch.
+ **********************************************************************/
+class CpuFeatures
+{
+public:
+    //! Use the scalar code paths regardless of the CPU
+    static void setForceScalar(const bool forceScalar)
+    {
+        forceScalarFlag().store(forceScalar, std::memory_order_relaxed);
+    }
+
+    static bool getForceScalar(void)
+    {
+        return forceScalarFlag().load(std::memory_order_relaxed);
+    }
+
+    #ifdef CPU_FEATURES_X86
+    static bool sse2(void)
+    {
+        return not getForceScalar();
+    }
+
+    static bool ssse3(void)
+    {
+        static const bool ssse3 = __builtin_cpu_supports("ssse3");
+        return ssse3 and not getForceScalar();
+    }
+
+    //! Carry-less multiply, with SSSE3 for the byte shuffles around it
+    static bool pclmul(void)
+    {
+        static const bool pclmul = __builtin_cpu_supports("pclmul") and __builtin_cpu_supports("ssse3");
+        return pclmul and not getForceScalar();
+    }
+
+    static bool avx2(void)
+    {
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2 and not getForceScalar();
+    }
+
+    //! Fast pdep/pext: they are microcoded and slower than scalar code on AMD family 17h
+    static bool bmi2(void)
+    {
+        static const bool bmi2 = __builtin_cpu_supports("bmi2") and not __builtin_cpu_is("amdfam17h");
+        return bmi2 and not getForceScalar();
+    }
+    #endif //CPU_FEATURES_X86
+
+private:
+    static std::atomic<bool> &forceScalarFlag(void)
+    {
+        static std::atomic<bool> flag(std::getenv("POTHOS_COMMS_FORCE_SCALAR") != nullptr);
+        return flag;
+    }
+};
+
+/***********************************************************************
+ * Force the scalar code paths for the lifetime of a scope
+ **********************************************************************/
+class CpuForceScalarScope
+{
+public:
+    CpuForceScalarScope(const bool forceScalar = true):
+        _previous(CpuFeatures::getForceScalar())
+    {
+        CpuFeatures::setForceScalar(forceScalar);
+    }
+
+    ~CpuForceScalarScope(void)
+    {
+        CpuFeatures::setForceScalar(_previous);
+    }
+
+private:
+    const bool _previous;
+};
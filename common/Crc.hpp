@@ -0,0 +1,288 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include "common/CpuFeatures.hpp"
+#include <Pothos/Exception.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> //memcpy
+#include <string>
+#include <vector>
+
+/***********************************************************************
+ * Table and carry-less multiply CRC engine
+ *
+ * A CRC of 8 to 32 bits in the usual parameter model: the polynomial
+ * without the leading term, the initial register, the bit order of the
+ * data (reflected means LSB first), and the final XOR.
+ * The reflected register holds the CRC in the low bits;
+ * the other register holds it in the high bits of 32 bits.
+ *
+ * Long buffers are folded 16 bytes at a time with PCLMULQDQ when the CPU
+ * supports it: the 128-bit remainder is multiplied by x^128 modulo the
+ * polynomial and added to the next block, which keeps the CRC unchanged.
+ * The last remainder and the tail bytes go through the tables,
+ * which are slicing-by-8 tables for the CPUs without PCLMULQDQ.
+ **********************************************************************/
+class CrcEngine
+{
+public:
+    //! The names of the built-in CRCs
+    static std::vector<std::string> names(void)
+    {
+        std::vector<std::string> out;
+        for (const auto &p : presets()) out.push_back(p.name);
+        return out;
+    }
+
+    //! A built-in CRC by name, like "CRC-32"
+    CrcEngine(const std::string &what, const std::string &name)
+    {
+        for (const auto &p : presets())
+        {
+            if (name != p.name) continue;
+            this->setup(what, p.width, p.poly, p.init, p.reflected, p.xorOut);
+            return;
+        }
+        throw Pothos::InvalidArgumentException(what, "Unknown CRC: " + name);
+    }
+
+    CrcEngine(const std::string &what, const size_t width, const uint32_t poly, const uint32_t init, const bool reflected, const uint32_t xorOut)
+    {
+        this->setup(what, width, poly, init, reflected, xorOut);
+    }
+
+    //! The CRC width in bits
+    size_t width(void) const
+    {
+        return _width;
+    }
+
+    //! The CRC size in bytes
+    size_t bytes(void) const
+    {
+        return (_width+7)/8;
+    }
+
+    //! Is the data and the CRC LSB first?
+    bool reflected(void) const
+    {
+        return _reflected;
+    }
+
+    //! The CRC of a buffer
+    uint32_t compute(const void *data, const size_t len) const
+    {
+        return this->finish(this->update(this->start(), data, len));
+    }
+
+    //! The register before any data, for update() over many buffers
+    uint32_t start(void) const
+    {
+        return _initReg;
+    }
+
+    //! Run more data through the register
+    uint32_t update(uint32_t reg, const void *data, size_t len) const
+    {
+        const uint8_t *p = (const uint8_t *)data;
+        #ifdef CPU_FEATURES_X86
+        if (len >= 64 and CpuFeatures::pclmul())
+        {
+            const size_t n = len & ~size_t(15);
+            reg = this->fold(reg, p, n);
+            p += n;
+            len -= n;
+        }
+        #endif
+        return _reflected?this->updateReflected(reg, p, len):this->updateNormal(reg, p, len);
+    }
+
+    //! The CRC from the register
+    uint32_t finish(const uint32_t reg) const
+    {
+        return (_reflected?reg:(reg >> (32-_width))) ^ _xorOut;
+    }
+
+    //! Write the CRC after the data: LSB first when reflected, otherwise MSB first
+    void store(const uint32_t crc, uint8_t *out) const
+    {
+        const size_t n = this->bytes();
+        for (size_t i = 0; i < n; i++) out[i] = uint8_t(crc >> (_reflected?(8*i):(8*(n-1-i))));
+    }
+
+    //! Read a CRC written by store()
+    uint32_t load(const uint8_t *in) const
+    {
+        const size_t n = this->bytes();
+        uint32_t crc = 0;
+        for (size_t i = 0; i < n; i++) crc |= uint32_t(in[i]) << (_reflected?(8*i):(8*(n-1-i)));
+        return crc;
+    }
+
+private:
+    struct Preset
+    {
+        const char *name;
+        size_t width;
+        uint32_t poly;
+        uint32_t init;
+        bool reflected;
+        uint32_t xorOut;
+    };
+
+    static const std::vector<Preset> &presets(void)
+    {
+        static const std::vector<Preset> p{
+            {"CRC-8", 8, 0x07, 0x00, false, 0x00},
+            {"CRC-8/MAXIM", 8, 0x31, 0x00, true, 0x00},
+            {"CRC-16/CCITT-FALSE", 16, 0x1021, 0xffff, false, 0x0000},
+            {"CRC-16/KERMIT", 16, 0x1021, 0x0000, true, 0x0000},
+            {"CRC-16/ARC", 16, 0x8005, 0x0000, true, 0x0000},
+            {"CRC-32", 32, 0x04c11db7, 0xffffffff, true, 0xffffffff},
+            {"CRC-32C", 32, 0x1edc6f41, 0xffffffff, true, 0xffffffff},
+            {"CRC-32/BZIP2", 32, 0x04c11db7, 0xffffffff, false, 0xffffffff},
+        };
+        return p;
+    }
+
+    static uint32_t reflect(uint32_t x, const size_t bits)
+    {
+        uint32_t r = 0;
+        for (size_t i = 0; i < bits; i++, x >>= 1) r = (r << 1) | (x & 0x1);
+        return r;
+    }
+
+    //! x^n modulo the polynomial, with the bits in the natural order
+    static uint32_t xPowMod(const size_t n, const uint32_t poly, const size_t width)
+    {
+        const uint64_t top = uint64_t(1) << width;
+        uint64_t r = 1;
+        for (size_t i = 0; i < n; i++)
+        {
+            r <<= 1;
+            if (r & top) r ^= top | poly;
+        }
+        return uint32_t(r);
+    }
+
+    void setup(const std::string &what, const size_t width, const uint32_t poly, const uint32_t init, const bool reflected, const uint32_t xorOut)
+    {
+        if (width < 8 or width > 32) throw Pothos::InvalidArgumentException(what, "CRC width must be 8 to 32 bits");
+        const uint32_t mask = uint32_t((uint64_t(1) << width)-1);
+        _width = width;
+        _reflected = reflected;
+        _xorOut = xorOut & mask;
+        _initReg = reflected?reflect(init & mask, width):((init & mask) << (32-width));
+
+        //slicing-by-8 tables, the first table is the CRC of one byte
+        _table.resize(8*256);
+        const uint32_t rpoly = reflect(poly & mask, width);
+        const uint32_t npoly = (poly & mask) << (32-width);
+        for (uint32_t b = 0; b < 256; b++)
+        {
+            uint32_t c = reflected?b:(b << 24);
+            for (size_t i = 0; i < 8; i++)
+            {
+                if (reflected) c = (c & 0x1)?((c >> 1) ^ rpoly):(c >> 1);
+                else c = (c & 0x80000000)?((c << 1) ^ npoly):(c << 1);
+            }
+            _table[b] = c;
+        }
+        for (size_t k = 1; k < 8; k++)
+        {
+            for (size_t b = 0; b < 256; b++)
+            {
+                const uint32_t c = _table[(k-1)*256 + b];
+                _table[k*256 + b] = reflected?((c >> 8) ^ _table[c & 0xff]):((c << 8) ^ _table[c >> 24]);
+            }
+        }
+
+        //folding constants for the high and low 64 bits of the remainder
+        if (reflected)
+        {
+            //the reflected product is one bit short, and the constants are 32-bit reflected
+            _foldHi = reflect(xPowMod(192-33, poly & mask, width), 32);
+            _foldLo = reflect(xPowMod(128-33, poly & mask, width), 32);
+        }
+        else
+        {
+            _foldHi = xPowMod(192, poly & mask, width);
+            _foldLo = xPowMod(128, poly & mask, width);
+        }
+    }
+
+    uint32_t updateReflected(uint32_t reg, const uint8_t *p, size_t len) const
+    {
+        const uint32_t *t = _table.data();
+        for (; len >= 8; len -= 8, p += 8)
+        {
+            const uint32_t a = reg ^ (uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24));
+            const uint32_t b = uint32_t(p[4]) | (uint32_t(p[5]) << 8) | (uint32_t(p[6]) << 16) | (uint32_t(p[7]) << 24);
+            reg = t[7*256 + (a & 0xff)] ^ t[6*256 + ((a >> 8) & 0xff)] ^ t[5*256 + ((a >> 16) & 0xff)] ^ t[4*256 + (a >> 24)] ^
+                  t[3*256 + (b & 0xff)] ^ t[2*256 + ((b >> 8) & 0xff)] ^ t[1*256 + ((b >> 16) & 0xff)] ^ t[0*256 + (b >> 24)];
+        }
+        for (; len > 0; len--, p++) reg = (reg >> 8) ^ t[(reg ^ *p) & 0xff];
+        return reg;
+    }
+
+    uint32_t updateNormal(uint32_t reg, const uint8_t *p, size_t len) const
+    {
+        const uint32_t *t = _table.data();
+        for (; len >= 8; len -= 8, p += 8)
+        {
+            const uint32_t a = reg ^ ((uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]));
+            const uint32_t b = (uint32_t(p[4]) << 24) | (uint32_t(p[5]) << 16) | (uint32_t(p[6]) << 8) | uint32_t(p[7]);
+            reg = t[7*256 + (a >> 24)] ^ t[6*256 + ((a >> 16) & 0xff)] ^ t[5*256 + ((a >> 8) & 0xff)] ^ t[4*256 + (a & 0xff)] ^
+                  t[3*256 + (b >> 24)] ^ t[2*256 + ((b >> 16) & 0xff)] ^ t[1*256 + ((b >> 8) & 0xff)] ^ t[0*256 + (b & 0xff)];
+        }
+        for (; len > 0; len--, p++) reg = (reg << 8) ^ t[(reg >> 24) ^ *p];
+        return reg;
+    }
+
+    #ifdef CPU_FEATURES_X86
+    //! Fold n bytes, a multiple of 16, into a 16 byte remainder, then run it through the tables
+    __attribute__((target("pclmul,ssse3")))
+    uint32_t fold(const uint32_t reg, const uint8_t *p, const size_t n) const
+    {
+        //the non-reflected blocks are byte reversed so that bit 127 is the first bit
+        const __m128i swap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m128i k = _mm_set_epi64x(_foldLo, _foldHi);
+
+        //the register adds to the first bytes like in the tables
+        __m128i x = _mm_loadu_si128((const __m128i *)p);
+        if (_reflected) x = _mm_xor_si128(x, _mm_cvtsi32_si128(int(reg)));
+        else x = _mm_xor_si128(_mm_shuffle_epi8(x, swap), _mm_slli_si128(_mm_cvtsi32_si128(int(reg)), 12));
+
+        for (size_t i = 16; i < n; i += 16)
+        {
+            __m128i d = _mm_loadu_si128((const __m128i *)(p + i));
+            if (_reflected)
+            {
+                //the low 64 bits hold the high degrees
+                x = _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+            }
+            else
+            {
+                d = _mm_shuffle_epi8(d, swap);
+                x = _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x01), _mm_clmulepi64_si128(x, k, 0x10));
+            }
+            x = _mm_xor_si128(x, d);
+        }
+
+        uint8_t rem[16];
+        if (not _reflected) x = _mm_shuffle_epi8(x, swap);
+        _mm_storeu_si128((__m128i *)rem, x);
+        return _reflected?this->updateReflected(0, rem, 16):this->updateNormal(0, rem, 16);
+    }
+    #endif //CPU_FEATURES_X86
+
+    size_t _width;
+    bool _reflected;
+    uint32_t _xorOut;
+    uint32_t _initReg;
+    uint64_t _foldHi;
+    uint64_t _foldLo;
+    std::vector<uint32_t> _table;
+};
@@ -0,0 +1,206 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <Pothos/Framework.hpp>
+#include <cstring> //memcpy
+#include <string>
+#include <algorithm> //min/max
+
+/***********************************************************************
+ * Base class for blocks that transform whole frames of elements
+ *
+ * Input port 0 accepts packet messages and labeled stream frames.
+ * Each packet payload is processed and posted on output port 0
+ * as a packet with the same metadata.
+ *
+ * In the stream, frames are labeled like bursts in the FIR filter.
+ * A frame begins at the frame start label. When the label data is a length,
+ * the frame holds length*label.width elements, like Frame Sync posts.
+ * Otherwise, the frame ends with the element under the frame end label.
+ * The processed frame is posted to the stream with a frame start label
+ * on the first element and a frame end label on the last element,
+ * both with the new frame length as data.
+ * Elements outside of a frame and labels within a frame are dropped.
+ * A frame start label before the current frame ends restarts the frame.
+ *
+ * The derived class implements processFrame() for both forms
+ * and documents the frameStartId and frameEndId parameters.
+ **********************************************************************/
+class FrameBlock : public Pothos::Block
+{
+public:
+    FrameBlock(const Pothos::DType &inType, const Pothos::DType &outType):
+        _outType(outType),
+        _frameStartId("frameStart"),
+        _inFrame(false),
+        _frameLength(0),
+        _frameElems(0)
+    {
+        this->setupInput(0, inType);
+        this->setupOutput(0, outType, this->uid()); //unique domain because of buffer forwarding
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameBlock, setFrameStartId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameBlock, getFrameStartId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameBlock, setFrameEndId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameBlock, getFrameEndId));
+    }
+
+    void setFrameStartId(const std::string &id)
+    {
+        if (id.empty()) throw Pothos::InvalidArgumentException("FrameBlock::setFrameStartId()", "frame start ID cannot be empty");
+        _frameStartId = id;
+    }
+
+    std::string getFrameStartId(void) const
+    {
+        return _frameStartId;
+    }
+
+    void setFrameEndId(const std::string &id)
+    {
+        _frameEndId = id;
+    }
+
+    std::string getFrameEndId(void) const
+    {
+        return _frameEndId;
+    }
+
+    void activate(void)
+    {
+        _inFrame = false;
+        _frame = Pothos::BufferChunk();
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+
+        //process packets, and forward other messages
+        if (inPort->hasMessage())
+        {
+            auto msg = inPort->popMessage();
+            if (msg.type() != typeid(Pothos::Packet)) outPort->postMessage(std::move(msg));
+            else
+            {
+                const auto &pktIn = msg.extract<Pothos::Packet>();
+                Pothos::Packet pktOut;
+                pktOut.metadata = pktIn.metadata;
+                if (this->processFrame(pktIn.payload, pktOut.payload)) outPort->postMessage(std::move(pktOut));
+            }
+        }
+
+        const size_t elems = inPort->elements();
+        if (elems == 0) return;
+        const size_t elemSize = inPort->dtype().size();
+        const char *in = inPort->buffer();
+
+        //visit the frame labels in order, i is the next unhandled element
+        size_t i = 0;
+        for (const auto &label : inPort->labels())
+        {
+            if (label.index >= elems) break;
+            if (label.id == _frameStartId)
+            {
+                this->appendFrame(in + i*elemSize, label.index - i, elemSize);
+                i = label.index;
+                this->beginFrame(label);
+            }
+            else if (_inFrame and not _frameEndId.empty() and label.id == _frameEndId)
+            {
+                const size_t end = std::min<size_t>(label.index + std::max<size_t>(label.width, 1), elems);
+                if (end <= i) continue;
+                this->appendFrame(in + i*elemSize, end - i, elemSize);
+                i = end;
+                if (_inFrame) this->endFrame(); //not already ended by the frame length
+            }
+        }
+        this->appendFrame(in + i*elemSize, elems - i, elemSize);
+        inPort->consume(elems);
+    }
+
+    void propagateLabels(const Pothos::InputPort *)
+    {
+        //don't propagate here, frame labels are posted in work()
+    }
+
+protected:
+    /*!
+     * Process one frame of input elements into a new output buffer.
+     * \return false to drop the frame
+     */
+    virtual bool processFrame(const Pothos::BufferChunk &in, Pothos::BufferChunk &out) = 0;
+
+    const Pothos::DType &outType(void) const
+    {
+        return _outType;
+    }
+
+private:
+    void beginFrame(const Pothos::Label &label)
+    {
+        _inFrame = false;
+        _frameElems = 0;
+        _frameLength = 0;
+        if (label.data.canConvert(typeid(size_t)))
+        {
+            try
+            {
+                _frameLength = label.data.convert<size_t>()*label.width;
+            }
+            catch (const Pothos::Exception &)
+            {
+                _frameLength = 0; //no usable frame length
+            }
+        }
+        if (_frameLength == 0 and _frameEndId.empty()) return; //no way to end the frame
+        _frame = Pothos::BufferChunk(this->input(0)->dtype(), (_frameLength == 0)?1024:_frameLength);
+        _inFrame = true;
+    }
+
+    //! Copy elements into the current frame, posting it when the length is reached
+    void appendFrame(const char *in, size_t num, const size_t elemSize)
+    {
+        if (not _inFrame or num == 0) return;
+        if (_frameLength != 0) num = std::min(num, _frameLength - _frameElems);
+
+        //grow the frame buffer when waiting for the frame end label
+        if ((_frameElems + num)*elemSize > _frame.length)
+        {
+            Pothos::BufferChunk bigger(_frame.dtype, 2*(_frameElems + num));
+            std::memcpy(bigger.as<void *>(), _frame.as<const void *>(), _frameElems*elemSize);
+            _frame = bigger;
+        }
+        std::memcpy(_frame.as<char *>() + _frameElems*elemSize, in, num*elemSize);
+        _frameElems += num;
+        if (_frameElems == _frameLength) this->endFrame();
+    }
+
+    void endFrame(void)
+    {
+        _inFrame = false;
+        Pothos::BufferChunk frame = _frame;
+        frame.length = _frameElems*_frame.dtype.size();
+        _frameElems = 0;
+        Pothos::BufferChunk out;
+        const bool ok = this->processFrame(frame, out);
+        _frame = Pothos::BufferChunk(); //the frame may be referenced by the output
+        if (not ok or out.length == 0) return;
+
+        auto outPort = this->output(0);
+        const size_t length = out.elements();
+        outPort->postLabel(_frameStartId, length, 0);
+        if (not _frameEndId.empty()) outPort->postLabel(_frameEndId, length, length-1);
+        outPort->postBuffer(std::move(out));
+    }
+
+    const Pothos::DType _outType;
+    std::string _frameStartId;
+    std::string _frameEndId;
+    bool _inFrame;
+    size_t _frameLength; //expected elements, or 0 to wait for the frame end label
+    size_t _frameElems; //elements in the current frame
+    Pothos::BufferChunk _frame;
+};
@@ -4,10 +4,13 @@
 #pragma once
 
 #include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
 #include <Pothos/Testing.hpp>
 
 #include <complex>
+#include <cstdlib>
 #include <cstring>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -91,4 +94,115 @@ namespace CommsTests
             epsilon,
             expected.elements());
     }
+
+    // Run the blocks connected in a chain, output port 0 to input port 0,
+    // until the topology is inactive.
+    static void runBlockChain(const std::vector<Pothos::Proxy>& blocks)
+    {
+        Pothos::Topology topology;
+        for(size_t i = 1; i < blocks.size(); ++i)
+        {
+            topology.connect(blocks[i-1], 0, blocks[i], 0);
+        }
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    // Feed the packets through a chain of blocks and return the packets
+    // that come out of the last block.
+    static std::vector<Pothos::Packet> runPacketChain(
+        const std::string& inputType,
+        const std::vector<Pothos::Packet>& packets,
+        const std::vector<Pothos::Proxy>& blocks)
+    {
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", inputType);
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+        for(const auto& packet : packets) feeder.call("feedPacket", packet);
+
+        std::vector<Pothos::Proxy> chain{feeder};
+        chain.insert(chain.end(), blocks.begin(), blocks.end());
+        chain.push_back(collector);
+        runBlockChain(chain);
+
+        return collector.call<std::vector<Pothos::Packet>>("getPackets");
+    }
+
+    // A copy of the packet with its own payload buffer, to insert errors into.
+    static Pothos::Packet copyPacket(const Pothos::Packet& packet)
+    {
+        auto copy = packet;
+        copy.payload = Pothos::BufferChunk(packet.payload.dtype, packet.payload.elements());
+        std::memcpy(
+            reinterpret_cast<void*>(copy.payload.address),
+            reinterpret_cast<const void*>(packet.payload.address),
+            packet.payload.length);
+
+        return copy;
+    }
+
+    // Feed a stream of random frames, each preceded by 10 filler bytes and
+    // a frame start label that holds the frame length. The frame bytes are
+    // masked, so a mask of 1 makes frames of bits. With a frame end ID, the
+    // last byte of each frame also gets a frame end label. Returns the frames
+    // back to back.
+    static std::vector<unsigned char> feedLabeledFrames(
+        const Pothos::Proxy& feeder,
+        const std::vector<size_t>& frameLengths,
+        unsigned char filler,
+        unsigned char mask,
+        const std::string& frameEndId = "")
+    {
+        static const size_t gap = 10;
+        size_t total = 0;
+        for(const auto length : frameLengths) total += gap + length;
+
+        std::vector<unsigned char> frames;
+        Pothos::BufferChunk buff("uint8", total);
+        auto p = buff.as<unsigned char*>();
+        size_t index = 0;
+        for(const auto length : frameLengths)
+        {
+            for(size_t i = 0; i < gap; ++i) p[index++] = filler;
+            feeder.call("feedLabel", Pothos::Label("frameStart", length, index));
+            if(not frameEndId.empty() and length != 0)
+            {
+                feeder.call("feedLabel", Pothos::Label(frameEndId, length, index + length - 1));
+            }
+            for(size_t i = 0; i < length; ++i)
+            {
+                p[index] = std::rand() & mask;
+                frames.push_back(p[index++]);
+            }
+        }
+        feeder.call("feedBuffer", buff);
+
+        return frames;
+    }
+
+    // Test for a frame start label with the frame length at the start of each frame,
+    // where the frames are back to back. With a frame end ID, each frame start
+    // label is followed by a frame end label on the last element of the frame.
+    static void testFrameStartLabels(
+        const std::vector<Pothos::Label>& labels,
+        const std::vector<size_t>& frameLengths,
+        const std::string& frameEndId = "")
+    {
+        const size_t labelsPerFrame = frameEndId.empty() ? 1 : 2;
+        POTHOS_TEST_EQUAL(labels.size(), frameLengths.size()*labelsPerFrame);
+        size_t index = 0;
+        for(size_t i = 0; i < frameLengths.size(); ++i)
+        {
+            const auto& start = labels[i*labelsPerFrame];
+            POTHOS_TEST_EQUAL(start.id, "frameStart");
+            POTHOS_TEST_EQUAL(start.index, index);
+            POTHOS_TEST_EQUAL(start.data.convert<size_t>(), frameLengths[i]);
+            index += frameLengths[i];
+            if(frameEndId.empty()) continue;
+
+            const auto& end = labels[i*labelsPerFrame + 1];
+            POTHOS_TEST_EQUAL(end.id, frameEndId);
+            POTHOS_TEST_EQUAL(end.index, index - 1);
+            POTHOS_TEST_EQUAL(end.data.convert<size_t>(), frameLengths[i]);
+        }
+    }
 }
@@ -0,0 +1,107 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/***********************************************************************
+ * Minimal fork-join thread pool for splitting work() across cores.
+ *
+ * The pool keeps numThreads-1 idle workers, and the calling thread
+ * runs tasks as well. run() hands out task indexes until all tasks
+ * are complete, then returns, so no task outlives the call.
+ **********************************************************************/
+class ThreadPool
+{
+public:
+    ThreadPool(const size_t numThreads):
+        _numTasks(0),
+        _nextTask(0),
+        _doneTasks(0),
+        _generation(0),
+        _shutdown(false)
+    {
+        for (size_t i = 1; i < numThreads; i++)
+        {
+            _threads.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+
+    ~ThreadPool(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _shutdown = true;
+        }
+        _workCond.notify_all();
+        for (auto &thread : _threads) thread.join();
+    }
+
+    //! The number of threads that run tasks, including the caller
+    size_t size(void) const
+    {
+        return _threads.size()+1;
+    }
+
+    //! Run fcn(task) for every task in [0, numTasks) and wait for completion
+    void run(const size_t numTasks, const std::function<void(const size_t)> &fcn)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _fcn = fcn;
+            _numTasks = numTasks;
+            _nextTask = 0;
+            _doneTasks = 0;
+            _generation++;
+        }
+        _workCond.notify_all();
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        this->runTasks(lock);
+        _doneCond.wait(lock, [this]{return _doneTasks == _numTasks;});
+        _fcn = nullptr;
+    }
+
+private:
+    //! Claim and run tasks until none remain, called with the lock held
+    void runTasks(std::unique_lock<std::mutex> &lock)
+    {
+        while (_nextTask < _numTasks)
+        {
+            const size_t task = _nextTask++;
+            lock.unlock();
+            _fcn(task);
+            lock.lock();
+            if (++_doneTasks == _numTasks) _doneCond.notify_all();
+        }
+    }
+
+    void workerLoop(void)
+    {
+        size_t generation = 0;
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true)
+        {
+            _workCond.wait(lock, [&]{return _shutdown or _generation != generation;});
+            if (_shutdown) return;
+            generation = _generation;
+            this->runTasks(lock);
+        }
+    }
+
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _workCond;
+    std::condition_variable _doneCond;
+    std::function<void(const size_t)> _fcn;
+    size_t _numTasks;
+    size_t _nextTask;
+    size_t _doneTasks;
+    size_t _generation;
+    bool _shutdown;
+};
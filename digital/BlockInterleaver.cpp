@@ -0,0 +1,210 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "common/FrameBlock.hpp"
+#include <Pothos/Framework.hpp>
+#include <cstdint>
+#include <algorithm> //min/max
+
+/***********************************************************************
+ * |PothosDoc Block Interleaver
+ *
+ * Interleave frames of elements with a row-column block interleaver,
+ * so that a burst of channel errors is spread over many codewords.
+ * Use a second Block Interleaver in deinterleave mode with the same size to restore the order.
+ *
+ * The interleaver writes each block of rows x columns elements into a matrix row by row,
+ * and reads the matrix column by column. The deinterleaver does the reverse.
+ * The last block of a frame may be partial: its matrix holds the remaining
+ * elements row by row, and the empty cells of the last row are skipped.
+ * The output frame has the same length as the input frame.
+ * A full block is a cache-blocked matrix transpose.
+ *
+ * The element type does not matter to the interleaver:
+ * it can carry bytes, bits one per byte, or soft bits like LLRs.
+ *
+ * <h2>Frames</h2>
+ * Input port 0 accepts packets, and the output packets keep the metadata of the input packets.
+ * Input port 0 also accepts a stream where each frame begins
+ * at the frame start label, labeled like bursts in the FIR Filter block:
+ * the frame start label holds the frame length, or the frame ends at the frame end label.
+ * The first block of a frame starts at the frame start label.
+ * Interleaved frames are posted with frame start and frame end labels that hold the frame length.
+ * Elements outside of a frame and the other labels are dropped.
+ *
+ * |category /Digital
+ * |category /Coding
+ * |keywords interleaver deinterleaver block row column burst
+ *
+ * |param dtype[Data Type] The data type of the elements.
+ * Elements of 1, 2, 4, 8 and 16 bytes are supported.
+ * |widget DTypeChooser(float=1,cfloat=1,int=1,cint=1,uint=1)
+ * |default "uint8"
+ * |preview disable
+ *
+ * |param rows[Rows] The number of rows of the interleaver matrix.
+ * |default 8
+ *
+ * |param columns[Columns] The number of columns of the interleaver matrix.
+ * |default 8
+ *
+ * |param deinterleave[Mode] Interleave or deinterleave the frames.
+ * |option [Interleave] false
+ * |option [Deinterleave] true
+ * |default false
+ *
+ * |param frameStartId[Frame Start ID] The label ID that marks the first element of a frame.
+ * |default "frameStart"
+ * |widget StringEntry()
+ *
+ * |param frameEndId[Frame End ID] The label ID that marks the last element of a frame.
+ * The frame end label is only needed when the frame start label has no length.
+ * |default ""
+ * |widget StringEntry()
+ * |preview valid
+ *
+ * |factory /comms/block_interleaver(dtype)
+ * |setter setRows(rows)
+ * |setter setColumns(columns)
+ * |setter setDeinterleave(deinterleave)
+ * |setter setFrameStartId(frameStartId)
+ * |setter setFrameEndId(frameEndId)
+ **********************************************************************/
+
+//! A 16 byte element like complex_float64, the interleaver only copies it
+struct Element16
+{
+    uint64_t words[2];
+};
+
+/***********************************************************************
+ * Transpose a matrix in tiles that fit in the cache:
+ * out[c*rows + r] = in[r*cols + c]
+ **********************************************************************/
+template <typename Type>
+static void transposeBlock(const Type *in, Type *out, const size_t rows, const size_t cols)
+{
+    static const size_t tile = 32;
+    for (size_t r0 = 0; r0 < rows; r0 += tile)
+    {
+        const size_t r1 = std::min(rows, r0 + tile);
+        for (size_t c0 = 0; c0 < cols; c0 += tile)
+        {
+            const size_t c1 = std::min(cols, c0 + tile);
+            for (size_t c = c0; c < c1; c++)
+            {
+                for (size_t r = r0; r < r1; r++) out[c*rows + r] = in[r*cols + c];
+            }
+        }
+    }
+}
+
+template <typename Type>
+class BlockInterleaver : public FrameBlock
+{
+public:
+    BlockInterleaver(const Pothos::DType &dtype):
+        FrameBlock(dtype, dtype),
+        _rows(8),
+        _cols(8),
+        _deinterleave(false)
+    {
+        this->registerCall(this, POTHOS_FCN_TUPLE(BlockInterleaver, setRows));
+        this->registerCall(this, POTHOS_FCN_TUPLE(BlockInterleaver, getRows));
+        this->registerCall(this, POTHOS_FCN_TUPLE(BlockInterleaver, setColumns));
+        this->registerCall(this, POTHOS_FCN_TUPLE(BlockInterleaver, getColumns));
+        this->registerCall(this, POTHOS_FCN_TUPLE(BlockInterleaver, setDeinterleave));
+        this->registerCall(this, POTHOS_FCN_TUPLE(BlockInterleaver, getDeinterleave));
+    }
+
+    void setRows(const size_t rows)
+    {
+        if (rows == 0) throw Pothos::InvalidArgumentException("BlockInterleaver::setRows()", "rows cannot be zero");
+        _rows = rows;
+    }
+
+    size_t getRows(void) const
+    {
+        return _rows;
+    }
+
+    void setColumns(const size_t cols)
+    {
+        if (cols == 0) throw Pothos::InvalidArgumentException("BlockInterleaver::setColumns()", "columns cannot be zero");
+        _cols = cols;
+    }
+
+    size_t getColumns(void) const
+    {
+        return _cols;
+    }
+
+    void setDeinterleave(const bool deinterleave)
+    {
+        _deinterleave = deinterleave;
+    }
+
+    bool getDeinterleave(void) const
+    {
+        return _deinterleave;
+    }
+
+protected:
+    bool processFrame(const Pothos::BufferChunk &in, Pothos::BufferChunk &out)
+    {
+        const size_t len = in.length/sizeof(Type);
+        if (len == 0) return false;
+        out = Pothos::BufferChunk(this->outType(), len);
+
+        const Type *x = in.as<const Type *>();
+        Type *y = out.as<Type *>();
+        const size_t blockLen = _rows*_cols;
+        size_t i = 0;
+
+        //full blocks: the deinterleaver transposes the columns x rows matrix back
+        for (; i + blockLen <= len; i += blockLen)
+        {
+            if (_deinterleave) transposeBlock(x + i, y + i, _cols, _rows);
+            else transposeBlock(x + i, y + i, _rows, _cols);
+        }
+
+        //the last partial block skips the empty cells of the last row
+        const size_t n = len - i;
+        const size_t fullRows = n/_cols, rem = n%_cols;
+        size_t k = i;
+        for (size_t c = 0; c < _cols; c++)
+        {
+            const size_t numRows = fullRows + ((c < rem)?1:0);
+            for (size_t r = 0; r < numRows; r++, k++)
+            {
+                if (_deinterleave) y[i + r*_cols + c] = x[k];
+                else y[k] = x[i + r*_cols + c];
+            }
+        }
+        return true;
+    }
+
+private:
+    size_t _rows;
+    size_t _cols;
+    bool _deinterleave;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *BlockInterleaverFactory(const Pothos::DType &dtype)
+{
+    switch (dtype.size())
+    {
+    case 1: return new BlockInterleaver<uint8_t>(dtype);
+    case 2: return new BlockInterleaver<uint16_t>(dtype);
+    case 4: return new BlockInterleaver<uint32_t>(dtype);
+    case 8: return new BlockInterleaver<uint64_t>(dtype);
+    case 16: return new BlockInterleaver<Element16>(dtype);
+    }
+    throw Pothos::InvalidArgumentException("BlockInterleaverFactory("+dtype.toString()+")", "unsupported element size");
+}
+
+static Pothos::BlockRegistry registerBlockInterleaver(
+    "/comms/block_interleaver", &BlockInterleaverFactory);
@@ -0,0 +1,155 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ConvolutionalCode.hpp"
+#include <Pothos/Framework.hpp>
+#include <cstdint>
+#include <vector>
+#include <algorithm> //min/max
+
+/***********************************************************************
+ * |PothosDoc Convolutional Encoder
+ *
+ * Encode a stream of bits with a rate 1/2 convolutional code,
+ * and optionally puncture the coded bits to raise the code rate.
+ * The input and output streams carry one bit per byte in the LSB.
+ * Use the Viterbi Decoder block with the same parameters to decode.
+ *
+ * The shift register holds the last K input bits with the newest bit in the LSB.
+ * Each input bit produces one coded bit per polynomial: the parity of the
+ * register masked by the polynomial. The register starts at zero on activation.
+ *
+ * |category /Digital
+ * |category /Coding
+ * |keywords convolutional encoder fec forward error correction puncture
+ *
+ * |param polys[Polynomials] Two generator polynomials in the register bit order.
+ * The constraint length K is the bit length of the largest polynomial, from 3 to 9.
+ * |option [K=7 (0171, 0133)] \[121, 91\]
+ * |option [K=9 (0561, 0753)] \[369, 491\]
+ * |option [K=5 (023, 035)] \[19, 29\]
+ * |option [K=3 (07, 05)] \[7, 5\]
+ * |default [121, 91]
+ * |widget ComboBox(editable=true)
+ *
+ * |param puncture[Puncture Pattern] A repeating pattern over the coded bits,
+ * where a 0 drops the coded bit at that position.
+ * The pattern has an even length; entries alternate between the two polynomials.
+ * |option [Rate 1/2] \[1, 1\]
+ * |option [Rate 2/3] \[1, 1, 1, 0\]
+ * |option [Rate 3/4] \[1, 1, 1, 0, 0, 1\]
+ * |option [Rate 5/6] \[1, 1, 1, 0, 0, 1, 1, 0, 0, 1\]
+ * |default [1, 1]
+ * |widget ComboBox(editable=true)
+ *
+ * |factory /comms/conv_encoder()
+ * |setter setPolynomials(polys)
+ * |setter setPuncture(puncture)
+ **********************************************************************/
+class ConvEncoder : public Pothos::Block
+{
+public:
+    static Block *make(void)
+    {
+        return new ConvEncoder();
+    }
+
+    ConvEncoder(void):
+        _reg(0),
+        _phase(0)
+    {
+        this->setupInput(0, typeid(unsigned char));
+        this->setupOutput(0, typeid(unsigned char));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ConvEncoder, setPolynomials));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ConvEncoder, getPolynomials));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ConvEncoder, setPuncture));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ConvEncoder, getPuncture));
+        this->updateTable();
+    }
+
+    void setPolynomials(const std::vector<int> &polys)
+    {
+        _code.setPolynomials("ConvEncoder::setPolynomials()", polys);
+        this->updateTable();
+    }
+
+    std::vector<int> getPolynomials(void) const
+    {
+        return _code.polys;
+    }
+
+    void setPuncture(const std::vector<int> &pattern)
+    {
+        _code.setPuncture("ConvEncoder::setPuncture()", pattern);
+        _phase = 0;
+    }
+
+    std::vector<int> getPuncture(void) const
+    {
+        return _code.puncture;
+    }
+
+    void activate(void)
+    {
+        _reg = 0;
+        _phase = 0;
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+
+        //each input bit produces at most 2 coded bits
+        const size_t num = std::min(inPort->elements(), outPort->elements()/2);
+        if (num == 0) return;
+
+        const unsigned char *in = inPort->buffer();
+        unsigned char *out = outPort->buffer();
+        const unsigned mask = (1u << _code.K)-1;
+        const int *puncture = _code.puncture.data();
+        const size_t period = _code.puncture.size();
+
+        size_t produced = 0;
+        for (size_t i = 0; i < num; i++)
+        {
+            _reg = ((_reg << 1) | (in[i] & 0x1)) & mask;
+            const unsigned char c = _outputs[_reg];
+            if (puncture[_phase+0] != 0) out[produced++] = (c >> 0) & 0x1;
+            if (puncture[_phase+1] != 0) out[produced++] = (c >> 1) & 0x1;
+            _phase += 2;
+            if (_phase == period) _phase = 0;
+        }
+
+        inPort->consume(num);
+        outPort->produce(produced);
+    }
+
+    void propagateLabels(const Pothos::InputPort *port)
+    {
+        auto outputPort = this->output(0);
+        for (const auto &label : port->labels())
+        {
+            outputPort->postLabel(label.toAdjusted(_code.numKept, _code.periodBits()));
+        }
+    }
+
+private:
+    void updateTable(void)
+    {
+        _outputs.resize(size_t(1) << _code.K);
+        for (size_t reg = 0; reg < _outputs.size(); reg++)
+        {
+            _outputs[reg] = (unsigned char)(_code.outputs(unsigned(reg)));
+        }
+        _reg = 0;
+    }
+
+    ConvolutionalCode _code;
+    std::vector<unsigned char> _outputs; //coded bits for each register value
+    unsigned _reg;
+    size_t _phase; //position in the puncture pattern
+};
+
+static Pothos::BlockRegistry registerConvEncoder(
+    "/comms/conv_encoder", &ConvEncoder::make);
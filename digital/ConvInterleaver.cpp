@@ -0,0 +1,289 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm> //min/max
+
+/***********************************************************************
+ * |PothosDoc Convolutional Interleaver
+ *
+ * Interleave a stream of elements with a convolutional (Forney) interleaver,
+ * so that a burst of channel errors is spread over many codewords.
+ * Use a second Convolutional Interleaver in deinterleave mode with the same parameters to restore the order.
+ *
+ * A commutator cycles over a number of branches, one element per branch.
+ * In the interleaver, branch b is a delay line of b*delay elements.
+ * In the deinterleaver, branch b is a delay line of (branches-1-b)*delay elements,
+ * so that every element is delayed by (branches-1)*delay*branches elements end to end.
+ * The delay lines are rings that start with zeros, which are erasures for soft bits,
+ * and they are processed one branch at a time over cache-sized chunks of the stream.
+ * Compared to a block interleaver with the same spreading,
+ * the end to end delay and memory are about half.
+ *
+ * The element type does not matter to the interleaver:
+ * it can carry bytes, bits one per byte, or soft bits like LLRs.
+ *
+ * <h2>Labels</h2>
+ * A frame start label puts the commutator back on branch 0,
+ * so that the deinterleaver follows the same commutator positions as the interleaver.
+ * The frame lengths should be a multiple of the number of branches,
+ * then the frame start labels only check the commutator position.
+ * The interleaver forwards labels at the same index,
+ * and the deinterleaver delays labels by the end to end delay
+ * so that a frame start label marks the first element of the restored frame.
+ *
+ * |category /Digital
+ * |category /Coding
+ * |keywords interleaver deinterleaver convolutional forney burst
+ *
+ * |param dtype[Data Type] The data type of the elements.
+ * Elements of 1, 2, 4, 8 and 16 bytes are supported.
+ * |widget DTypeChooser(float=1,cfloat=1,int=1,cint=1,uint=1)
+ * |default "uint8"
+ * |preview disable
+ *
+ * |param branches[Branches] The number of branches of the commutator.
+ * |default 12
+ *
+ * |param delay[Delay] The delay step in elements between consecutive branches.
+ * |default 17
+ *
+ * |param deinterleave[Mode] Interleave or deinterleave the stream.
+ * |option [Interleave] false
+ * |option [Deinterleave] true
+ * |default false
+ *
+ * |param frameStartId[Frame Start ID] The label ID that resets the commutator to branch 0.
+ * |default "frameStart"
+ * |widget StringEntry()
+ * |preview valid
+ *
+ * |factory /comms/conv_interleaver(dtype)
+ * |setter setBranches(branches)
+ * |setter setDelay(delay)
+ * |setter setDeinterleave(deinterleave)
+ * |setter setFrameStartId(frameStartId)
+ **********************************************************************/
+
+//! A 16 byte element like complex_float64, the interleaver only copies it
+struct Element16
+{
+    uint64_t words[2];
+};
+
+template <typename Type>
+class ConvInterleaver : public Pothos::Block
+{
+public:
+    ConvInterleaver(const Pothos::DType &dtype):
+        _numBranches(12),
+        _delay(17),
+        _deinterleave(false),
+        _frameStartId("frameStart"),
+        _branch(0),
+        _count(0)
+    {
+        this->setupInput(0, dtype);
+        this->setupOutput(0, dtype);
+        this->registerCall(this, POTHOS_FCN_TUPLE(ConvInterleaver, setBranches));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ConvInterleaver, getBranches));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ConvInterleaver, setDelay));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ConvInterleaver, getDelay));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ConvInterleaver, setDeinterleave));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ConvInterleaver, getDeinterleave));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ConvInterleaver, setFrameStartId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ConvInterleaver, getFrameStartId));
+        this->reset();
+    }
+
+    void setBranches(const size_t branches)
+    {
+        if (branches == 0) throw Pothos::InvalidArgumentException("ConvInterleaver::setBranches()", "branches cannot be zero");
+        _numBranches = branches;
+        this->reset();
+    }
+
+    size_t getBranches(void) const
+    {
+        return _numBranches;
+    }
+
+    void setDelay(const size_t delay)
+    {
+        _delay = delay;
+        this->reset();
+    }
+
+    size_t getDelay(void) const
+    {
+        return _delay;
+    }
+
+    void setDeinterleave(const bool deinterleave)
+    {
+        _deinterleave = deinterleave;
+        this->reset();
+    }
+
+    bool getDeinterleave(void) const
+    {
+        return _deinterleave;
+    }
+
+    void setFrameStartId(const std::string &id)
+    {
+        _frameStartId = id;
+    }
+
+    std::string getFrameStartId(void) const
+    {
+        return _frameStartId;
+    }
+
+    void activate(void)
+    {
+        this->reset();
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+
+        const size_t num = std::min(inPort->elements(), outPort->elements());
+        if (num == 0) return;
+
+        const Type *in = inPort->buffer();
+        Type *out = outPort->buffer();
+
+        //queue the labels at their output position, and restart the commutator on frame starts
+        size_t i = 0;
+        for (const auto &label : inPort->labels())
+        {
+            if (label.index >= num) break;
+            auto delayed = label;
+            delayed.index += _count + _labelDelay;
+            _labels.push_back(delayed);
+            if (_frameStartId.empty() or label.id != _frameStartId) continue;
+            this->commute(in, out, i, label.index);
+            i = label.index;
+            _branch = 0;
+        }
+        this->commute(in, out, i, num);
+
+        //post the queued labels that fall in this output
+        while (not _labels.empty() and _labels.front().index < _count + num)
+        {
+            auto label = _labels.front();
+            label.index -= _count;
+            outPort->postLabel(label);
+            _labels.pop_front();
+        }
+
+        _count += num;
+        inPort->consume(num);
+        outPort->produce(num);
+    }
+
+    void propagateLabels(const Pothos::InputPort *)
+    {
+        //don't propagate here, labels are posted in work()
+    }
+
+private:
+    //! Clear the delay lines for the current parameters
+    void reset(void)
+    {
+        const size_t B = _numBranches;
+        _lengths.resize(B);
+        _offsets.resize(B);
+        _positions.assign(B, 0);
+        size_t total = 0;
+        for (size_t b = 0; b < B; b++)
+        {
+            _lengths[b] = (_deinterleave?(B-1-b):b)*_delay;
+            _offsets[b] = total;
+            total += _lengths[b];
+        }
+        _rings.assign(total, Type());
+        _labelDelay = _deinterleave?(B-1)*_delay*B:0;
+        _labels.clear();
+        _branch = 0;
+        _count = 0;
+    }
+
+    //! Run elements [begin, end) through the delay lines, in chunks that stay in the cache
+    void commute(const Type *in, Type *out, size_t begin, const size_t end)
+    {
+        static const size_t chunk = 16384/sizeof(Type);
+        for (; begin < end; begin += chunk) this->commuteChunk(in, out, begin, std::min(end, begin + chunk));
+    }
+
+    //! One branch at a time, each branch visits every B-th element
+    void commuteChunk(const Type *in, Type *out, const size_t begin, const size_t end)
+    {
+        const size_t B = _numBranches;
+        for (size_t b = 0; b < B; b++)
+        {
+            const size_t i0 = begin + (b + B - _branch) % B;
+            const size_t L = _lengths[b];
+            if (L == 0)
+            {
+                for (size_t i = i0; i < end; i += B) out[i] = in[i];
+                continue;
+            }
+            //runs up to the end of the ring, then wrap around
+            Type *ring = _rings.data() + _offsets[b];
+            size_t p = _positions[b];
+            for (size_t i = i0; i < end;)
+            {
+                const size_t run = std::min(L - p, (end - i + B - 1)/B);
+                for (size_t k = 0; k < run; k++, i += B)
+                {
+                    out[i] = ring[p+k];
+                    ring[p+k] = in[i];
+                }
+                p += run;
+                if (p == L) p = 0;
+            }
+            _positions[b] = p;
+        }
+        _branch = (_branch + (end - begin)) % B;
+    }
+
+    size_t _numBranches;
+    size_t _delay;
+    bool _deinterleave;
+    std::string _frameStartId;
+    std::vector<size_t> _lengths; //delay line length of each branch
+    std::vector<size_t> _offsets; //delay line start in the rings
+    std::vector<size_t> _positions; //oldest element of each delay line
+    std::vector<Type> _rings;
+    size_t _branch; //commutator position of the next element
+    unsigned long long _count; //elements processed since the reset
+    unsigned long long _labelDelay;
+    std::deque<Pothos::Label> _labels; //labels waiting for their output position
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *ConvInterleaverFactory(const Pothos::DType &dtype)
+{
+    switch (dtype.size())
+    {
+    case 1: return new ConvInterleaver<uint8_t>(dtype);
+    case 2: return new ConvInterleaver<uint16_t>(dtype);
+    case 4: return new ConvInterleaver<uint32_t>(dtype);
+    case 8: return new ConvInterleaver<uint64_t>(dtype);
+    case 16: return new ConvInterleaver<Element16>(dtype);
+    }
+    throw Pothos::InvalidArgumentException("ConvInterleaverFactory("+dtype.toString()+")", "unsupported element size");
+}
+
+static Pothos::BlockRegistry registerConvInterleaver(
+    "/comms/conv_interleaver", &ConvInterleaverFactory);
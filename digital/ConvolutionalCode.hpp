@@ -0,0 +1,84 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Exception.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/***********************************************************************
+ * Rate 1/2 convolutional code with an optional puncture pattern
+ *
+ * The shift register holds the last K input bits with the newest bit
+ * in the LSB. Each input bit produces one output bit per polynomial:
+ * the parity of the register masked by the polynomial.
+ * The constraint length K is the bit length of the largest polynomial.
+ *
+ * The puncture pattern repeats over the stream of output bits,
+ * where a 0 entry drops the output bit at that position.
+ **********************************************************************/
+struct ConvolutionalCode
+{
+    static const size_t MIN_K = 3;
+    static const size_t MAX_K = 9;
+
+    ConvolutionalCode(void):
+        K(0),
+        numKept(0)
+    {
+        this->setPolynomials("ConvolutionalCode()", std::vector<int>{0171, 0133});
+        this->setPuncture("ConvolutionalCode()", std::vector<int>{1, 1});
+    }
+
+    void setPolynomials(const std::string &what, const std::vector<int> &p)
+    {
+        if (p.size() != 2) throw Pothos::InvalidArgumentException(what, "Expected two polynomials for a rate 1/2 code");
+        size_t k = 0;
+        for (const auto poly : p)
+        {
+            if (poly <= 0 or poly >= (1 << MAX_K)) throw Pothos::InvalidArgumentException(what, "Polynomial out of range");
+            while ((poly >> k) != 0) k++;
+        }
+        if (k < MIN_K) throw Pothos::InvalidArgumentException(what, "Constraint length must be at least 3");
+        polys = p;
+        K = k;
+    }
+
+    void setPuncture(const std::string &what, const std::vector<int> &pattern)
+    {
+        if (pattern.empty() or (pattern.size() % 2) != 0)
+        {
+            throw Pothos::InvalidArgumentException(what, "Puncture pattern must be a non-empty multiple of 2 in length");
+        }
+        size_t kept = 0;
+        for (const auto p : pattern) if (p != 0) kept++;
+        if (kept == 0) throw Pothos::InvalidArgumentException(what, "Puncture pattern must keep at least one bit");
+        puncture = pattern;
+        numKept = kept;
+    }
+
+    //! The output bits of the register value, output k in bit k
+    unsigned outputs(const unsigned reg) const
+    {
+        unsigned out = 0;
+        for (size_t k = 0; k < polys.size(); k++)
+        {
+            unsigned x = reg & unsigned(polys[k]), parity = 0;
+            while (x != 0) {parity ^= x & 0x1; x >>= 1;}
+            out |= parity << k;
+        }
+        return out;
+    }
+
+    //! Input bits in one period of the puncture pattern
+    size_t periodBits(void) const
+    {
+        return puncture.size()/2;
+    }
+
+    size_t K;
+    std::vector<int> polys;
+    std::vector<int> puncture;
+    size_t numKept; //output bits kept per period
+};
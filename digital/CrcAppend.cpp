@@ -0,0 +1,104 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "common/Crc.hpp"
+#include "common/FrameBlock.hpp"
+#include <Pothos/Framework.hpp>
+#include <cstdint>
+#include <cstring> //memcpy
+
+/***********************************************************************
+ * |PothosDoc CRC Append
+ *
+ * Append a cyclic redundancy check to frames of bytes.
+ * Use the CRC Check block with the same CRC to check and remove it.
+ *
+ * The CRC covers the whole frame and is appended after the last byte:
+ * least significant byte first for the reflected CRCs like CRC-32,
+ * and most significant byte first for the others.
+ * Long frames are folded with carry-less multiplies when the CPU supports them,
+ * otherwise the CRC uses slicing-by-8 tables.
+ *
+ * <h2>Frames</h2>
+ * Input port 0 accepts packets, and the output packets keep the metadata of the input packets.
+ * Input port 0 also accepts a byte stream where each frame begins
+ * at the frame start label, labeled like bursts in the FIR Filter block:
+ * the frame start label holds the frame length, or the frame ends at the frame end label.
+ * Output frames are posted with frame start and frame end labels that hold the new frame length.
+ * Bytes outside of a frame and the other labels are dropped.
+ *
+ * |category /Digital
+ * |category /Coding
+ * |keywords crc checksum cyclic redundancy check packet frame
+ *
+ * |param crc[CRC] The CRC width and parameters.
+ * |option [CRC-8] "CRC-8"
+ * |option [CRC-8/MAXIM] "CRC-8/MAXIM"
+ * |option [CRC-16/CCITT-FALSE] "CRC-16/CCITT-FALSE"
+ * |option [CRC-16/KERMIT] "CRC-16/KERMIT"
+ * |option [CRC-16/ARC] "CRC-16/ARC"
+ * |option [CRC-32] "CRC-32"
+ * |option [CRC-32C] "CRC-32C"
+ * |option [CRC-32/BZIP2] "CRC-32/BZIP2"
+ * |default "CRC-32"
+ *
+ * |param frameStartId[Frame Start ID] The label ID that marks the first byte of a frame.
+ * |default "frameStart"
+ * |widget StringEntry()
+ *
+ * |param frameEndId[Frame End ID] The label ID that marks the last byte of a frame.
+ * The frame end label is only needed when the frame start label has no length.
+ * |default ""
+ * |widget StringEntry()
+ * |preview valid
+ *
+ * |factory /comms/crc_append()
+ * |setter setCrc(crc)
+ * |setter setFrameStartId(frameStartId)
+ * |setter setFrameEndId(frameEndId)
+ **********************************************************************/
+class CrcAppend : public FrameBlock
+{
+public:
+    static Block *make(void)
+    {
+        return new CrcAppend();
+    }
+
+    CrcAppend(void):
+        FrameBlock(typeid(unsigned char), typeid(unsigned char)),
+        _name("CRC-32"),
+        _crc("CrcAppend()", _name)
+    {
+        this->registerCall(this, POTHOS_FCN_TUPLE(CrcAppend, setCrc));
+        this->registerCall(this, POTHOS_FCN_TUPLE(CrcAppend, getCrc));
+    }
+
+    void setCrc(const std::string &name)
+    {
+        _crc = CrcEngine("CrcAppend::setCrc()", name);
+        _name = name;
+    }
+
+    std::string getCrc(void) const
+    {
+        return _name;
+    }
+
+protected:
+    bool processFrame(const Pothos::BufferChunk &in, Pothos::BufferChunk &out)
+    {
+        const size_t len = in.length;
+        out = Pothos::BufferChunk(this->outType(), len + _crc.bytes());
+        std::memcpy(out.as<void *>(), in.as<const void *>(), len);
+        _crc.store(_crc.compute(in.as<const void *>(), len), out.as<uint8_t *>() + len);
+        return true;
+    }
+
+private:
+    std::string _name;
+    CrcEngine _crc;
+};
+
+static Pothos::BlockRegistry registerCrcAppend(
+    "/comms/crc_append", &CrcAppend::make);
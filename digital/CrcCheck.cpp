@@ -0,0 +1,122 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "common/Crc.hpp"
+#include "common/FrameBlock.hpp"
+#include <Pothos/Framework.hpp>
+#include <cstdint>
+
+/***********************************************************************
+ * |PothosDoc CRC Check
+ *
+ * Check and remove the cyclic redundancy check at the end of frames of bytes,
+ * like the CRC Append block adds.
+ * Frames with a CRC mismatch are dropped and counted as errors.
+ *
+ * <h2>Frames</h2>
+ * Input port 0 accepts packets, and the output packets keep the metadata of the input packets.
+ * The output packet payload references the input payload without a copy.
+ * Input port 0 also accepts a byte stream where each frame begins
+ * at the frame start label, labeled like bursts in the FIR Filter block:
+ * the frame start label holds the frame length, or the frame ends at the frame end label.
+ * Output frames are posted with frame start and frame end labels that hold the new frame length.
+ * Bytes outside of a frame and the other labels are dropped.
+ *
+ * |category /Digital
+ * |category /Coding
+ * |keywords crc checksum cyclic redundancy check packet frame
+ *
+ * |param crc[CRC] The CRC width and parameters.
+ * |option [CRC-8] "CRC-8"
+ * |option [CRC-8/MAXIM] "CRC-8/MAXIM"
+ * |option [CRC-16/CCITT-FALSE] "CRC-16/CCITT-FALSE"
+ * |option [CRC-16/KERMIT] "CRC-16/KERMIT"
+ * |option [CRC-16/ARC] "CRC-16/ARC"
+ * |option [CRC-32] "CRC-32"
+ * |option [CRC-32C] "CRC-32C"
+ * |option [CRC-32/BZIP2] "CRC-32/BZIP2"
+ * |default "CRC-32"
+ *
+ * |param frameStartId[Frame Start ID] The label ID that marks the first byte of a frame.
+ * |default "frameStart"
+ * |widget StringEntry()
+ *
+ * |param frameEndId[Frame End ID] The label ID that marks the last byte of a frame.
+ * The frame end label is only needed when the frame start label has no length.
+ * |default ""
+ * |widget StringEntry()
+ * |preview valid
+ *
+ * |factory /comms/crc_check()
+ * |setter setCrc(crc)
+ * |setter setFrameStartId(frameStartId)
+ * |setter setFrameEndId(frameEndId)
+ **********************************************************************/
+class CrcCheck : public FrameBlock
+{
+public:
+    static Block *make(void)
+    {
+        return new CrcCheck();
+    }
+
+    CrcCheck(void):
+        FrameBlock(typeid(unsigned char), typeid(unsigned char)),
+        _name("CRC-32"),
+        _crc("CrcCheck()", _name),
+        _errorCount(0)
+    {
+        this->registerCall(this, POTHOS_FCN_TUPLE(CrcCheck, setCrc));
+        this->registerCall(this, POTHOS_FCN_TUPLE(CrcCheck, getCrc));
+        this->registerCall(this, POTHOS_FCN_TUPLE(CrcCheck, getErrorCount));
+        this->registerProbe("getErrorCount");
+    }
+
+    void setCrc(const std::string &name)
+    {
+        _crc = CrcEngine("CrcCheck::setCrc()", name);
+        _name = name;
+    }
+
+    std::string getCrc(void) const
+    {
+        return _name;
+    }
+
+    //! The number of frames dropped for a CRC mismatch or a frame shorter than the CRC
+    unsigned long long getErrorCount(void) const
+    {
+        return _errorCount;
+    }
+
+protected:
+    bool processFrame(const Pothos::BufferChunk &in, Pothos::BufferChunk &out)
+    {
+        const size_t n = _crc.bytes();
+        if (in.length < n)
+        {
+            _errorCount++;
+            return false;
+        }
+        const size_t len = in.length - n;
+        const uint8_t *data = in.as<const uint8_t *>();
+        if (_crc.compute(data, len) != _crc.load(data + len))
+        {
+            _errorCount++;
+            return false;
+        }
+
+        //the frame without the crc
+        out = in;
+        out.length = len;
+        return true;
+    }
+
+private:
+    std::string _name;
+    CrcEngine _crc;
+    unsigned long long _errorCount;
+};
+
+static Pothos::BlockRegistry registerCrcCheck(
+    "/comms/crc_check", &CrcCheck::make);
@@ -3,6 +3,7 @@
 
 #include <Pothos/Framework.hpp>
 #include <algorithm> //min/max
+#include <string>
 
 /***********************************************************************
  * |PothosDoc Differential Decoder
@@ -15,8 +16,19 @@
  * |param symbols Number of possible symbols encoded in a byte. 
  * |default 2
  *
+ * |param packing[Packing] The bit packing of the input and output streams.
+ * Unpacked streams carry one symbol per byte.
+ * Packed streams carry 8 binary symbols per byte, from the MSB or from the LSB first,
+ * like the bit order of the Bytes to Symbols block. Packed streams require 2 symbols.
+ * Labels stay on the byte that holds the bit they annotate.
+ * |option [Unpacked] "unpacked"
+ * |option [Packed MSBit first] "MSBit"
+ * |option [Packed LSBit first] "LSBit"
+ * |default "unpacked"
+ *
  * |factory /comms/differential_decoder()
  * |setter setSymbols(symbols)
+ * |setter setPacking(packing)
  **********************************************************************/
 class DifferentialDecoder : public Pothos::Block
 {
@@ -27,11 +39,13 @@ public:
         return new DifferentialDecoder();
     }
 
-    DifferentialDecoder(void) : lastSymRecv(0), symbols(2)
+    DifferentialDecoder(void) : lastSymRecv(0), symbols(2), packing(UNPACKED)
     {
         this->setupInput(0, typeid(unsigned char));
         this->setupOutput(0, typeid(unsigned char));
         this->registerCall(this, POTHOS_FCN_TUPLE(DifferentialDecoder, setSymbols));
+        this->registerCall(this, POTHOS_FCN_TUPLE(DifferentialDecoder, setPacking));
+        this->registerCall(this, POTHOS_FCN_TUPLE(DifferentialDecoder, getPacking));
     }
 
     void setSymbols(const size_t symbols)
@@ -39,6 +53,29 @@ public:
         this->symbols = symbols;
     }
 
+    void setPacking(const std::string &packing)
+    {
+        if (packing == "unpacked") this->packing = UNPACKED;
+        else if (packing == "MSBit") this->packing = PACKED_MSBIT;
+        else if (packing == "LSBit") this->packing = PACKED_LSBIT;
+        else throw Pothos::InvalidArgumentException("DifferentialDecoder::setPacking()", "unknown packing: " + packing);
+    }
+
+    std::string getPacking(void) const
+    {
+        if (packing == PACKED_MSBIT) return "MSBit";
+        if (packing == PACKED_LSBIT) return "LSBit";
+        return "unpacked";
+    }
+
+    void activate(void)
+    {
+        if (packing != UNPACKED and symbols != 2)
+        {
+            throw Pothos::InvalidArgumentException("DifferentialDecoder::activate()", "packed streams require 2 symbols");
+        }
+    }
+
     void work(void)
     {
         auto inputPort = this->input(0);
@@ -56,7 +93,20 @@ public:
         auto outBytes = outBuff.as<uint8_t*>();
 
         uint8_t lastRecv = lastSymRecv;
-        for(uint32_t i = 0; i < len; i++)
+        if (packing == PACKED_MSBIT) for(uint32_t i = 0; i < len; i++)
+        {
+            //XOR each bit with the previous bit in time order
+            const uint8_t x = *inBytes++;
+            *outBytes++ = x ^ ((x >> 1) | (lastRecv << 7));
+            lastRecv = x & 0x1;
+        }
+        else if (packing == PACKED_LSBIT) for(uint32_t i = 0; i < len; i++)
+        {
+            const uint8_t x = *inBytes++;
+            *outBytes++ = x ^ ((x << 1) | lastRecv);
+            lastRecv = x >> 7;
+        }
+        else for(uint32_t i = 0; i < len; i++)
         {
             uint8_t last = lastRecv;
             lastRecv = *inBytes++;
@@ -72,6 +122,7 @@ public:
 protected:
     uint8_t lastSymRecv;
     uint32_t symbols;
+    enum {UNPACKED, PACKED_MSBIT, PACKED_LSBIT} packing;
 };
 
 static Pothos::BlockRegistry registerDifferentialDecoder(
@@ -3,6 +3,7 @@
 
 #include <Pothos/Framework.hpp>
 #include <algorithm> //min/max
+#include <string>
 
 /***********************************************************************
  * |PothosDoc Differential Encoder
@@ -15,8 +16,19 @@
  * |param symbols Number of possible symbols encoded in a byte. 
  * |default 2
  *
+ * |param packing[Packing] The bit packing of the input and output streams.
+ * Unpacked streams carry one symbol per byte.
+ * Packed streams carry 8 binary symbols per byte, from the MSB or from the LSB first,
+ * like the bit order of the Bytes to Symbols block. Packed streams require 2 symbols.
+ * Labels stay on the byte that holds the bit they annotate.
+ * |option [Unpacked] "unpacked"
+ * |option [Packed MSBit first] "MSBit"
+ * |option [Packed LSBit first] "LSBit"
+ * |default "unpacked"
+ *
  * |factory /comms/differential_encoder()
  * |setter setSymbols(symbols)
+ * |setter setPacking(packing)
  **********************************************************************/
 class DifferentialEncoder : public Pothos::Block
 {
@@ -27,11 +39,13 @@ public:
         return new DifferentialEncoder();
     }
 
-    DifferentialEncoder(void) : lastSymSent(0), symbols(2)
+    DifferentialEncoder(void) : lastSymSent(0), symbols(2), packing(UNPACKED)
     {
         this->setupInput(0, typeid(unsigned char));
         this->setupOutput(0, typeid(unsigned char));
         this->registerCall(this, POTHOS_FCN_TUPLE(DifferentialEncoder, setSymbols));
+        this->registerCall(this, POTHOS_FCN_TUPLE(DifferentialEncoder, setPacking));
+        this->registerCall(this, POTHOS_FCN_TUPLE(DifferentialEncoder, getPacking));
     }
 
     void setSymbols(const size_t symbols)
@@ -39,6 +53,29 @@ public:
         this->symbols = symbols;
     }
 
+    void setPacking(const std::string &packing)
+    {
+        if (packing == "unpacked") this->packing = UNPACKED;
+        else if (packing == "MSBit") this->packing = PACKED_MSBIT;
+        else if (packing == "LSBit") this->packing = PACKED_LSBIT;
+        else throw Pothos::InvalidArgumentException("DifferentialEncoder::setPacking()", "unknown packing: " + packing);
+    }
+
+    std::string getPacking(void) const
+    {
+        if (packing == PACKED_MSBIT) return "MSBit";
+        if (packing == PACKED_LSBIT) return "LSBit";
+        return "unpacked";
+    }
+
+    void activate(void)
+    {
+        if (packing != UNPACKED and symbols != 2)
+        {
+            throw Pothos::InvalidArgumentException("DifferentialEncoder::activate()", "packed streams require 2 symbols");
+        }
+    }
+
     void work(void)
     {
         auto inputPort = this->input(0);
@@ -56,7 +93,25 @@ public:
         auto outBytes = outBuff.as<uint8_t*>();
 
         uint8_t lastSent = lastSymSent;
-        for(uint32_t i = 0; i < len; i++)
+        if (packing == PACKED_MSBIT) for(uint32_t i = 0; i < len; i++)
+        {
+            //prefix XOR from the MSB down, then apply the last bit sent
+            uint8_t x = *inBytes++;
+            x ^= x >> 1; x ^= x >> 2; x ^= x >> 4;
+            if (lastSent != 0) x = ~x;
+            *outBytes++ = x;
+            lastSent = x & 0x1;
+        }
+        else if (packing == PACKED_LSBIT) for(uint32_t i = 0; i < len; i++)
+        {
+            //prefix XOR from the LSB up, then apply the last bit sent
+            uint8_t x = *inBytes++;
+            x ^= x << 1; x ^= x << 2; x ^= x << 4;
+            if (lastSent != 0) x = ~x;
+            *outBytes++ = x;
+            lastSent = x >> 7;
+        }
+        else for(uint32_t i = 0; i < len; i++)
         {
             lastSent = (*inBytes++ + lastSent + symbols) % symbols;
             *outBytes++ = lastSent;
@@ -71,6 +126,7 @@ public:
 protected:
     uint8_t lastSymSent;
     uint32_t symbols;
+    enum {UNPACKED, PACKED_MSBIT, PACKED_LSBIT} packing;
 };
 
 static Pothos::BlockRegistry registerDifferentialEncoder(
@@ -1,6 +1,7 @@
 // Copyright (c) 2015-2015 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#pragma once
 #include <Pothos/Config.hpp>
 #include <cstddef> //size_t
 #include <cstdint>
@@ -55,24 +56,96 @@ struct FrameHeaderFields
 };
 
 /***********************************************************************
- * Encode a 4 bit word into a 8 bits with parity
+ * Hamming(8,4) lookup tables
  * https://en.wikipedia.org/wiki/Hamming_code
+ *
+ * A codeword is packed into a byte with codeword bit i in bit i.
+ * The encode table maps a 4 bit word to its codeword.
+ * The decode table maps a codeword to its corrected 4 bit word,
+ * with HAMMING84_ERROR set when the error is uncorrectable.
+ **********************************************************************/
+#define HAMMING84_ERROR 0x10
+
+struct Hamming84Tables
+{
+    Hamming84Tables(void)
+    {
+        for (unsigned x = 0; x < 16; x++)
+        {
+            const unsigned d0 = (x >> 0) & 0x1;
+            const unsigned d1 = (x >> 1) & 0x1;
+            const unsigned d2 = (x >> 2) & 0x1;
+            const unsigned d3 = (x >> 3) & 0x1;
+            unsigned c = 0;
+            c |= ((d0 ^ d1 ^ d3) << 0);
+            c |= ((d0 ^ d2 ^ d3) << 1);
+            c |= (d0 << 2);
+            c |= ((d1 ^ d2 ^ d3) << 3);
+            c |= (d1 << 4);
+            c |= (d2 << 5);
+            c |= (d3 << 6);
+            c |= ((d0 ^ d1 ^ d2) << 7);
+            encode[x] = uint8_t(c);
+        }
+
+        for (unsigned c = 0; c < 256; c++)
+        {
+            //the syndrome bits and the overall parity
+            const unsigned p0 = ((c >> 0) ^ (c >> 2) ^ (c >> 4) ^ (c >> 6)) & 0x1;
+            const unsigned p1 = ((c >> 1) ^ (c >> 2) ^ (c >> 5) ^ (c >> 6)) & 0x1;
+            const unsigned p2 = ((c >> 3) ^ (c >> 4) ^ (c >> 5) ^ (c >> 6)) & 0x1;
+            unsigned p3 = 0;
+            for (unsigned i = 0; i < 8; i++) p3 ^= (c >> i) & 0x1;
+            const unsigned parity = (p0 << 0) | (p1 << 1) | (p2 << 2) | (p3 << 3);
+
+            //syndromes 8 through 15 flip bit 7, then bits 0 through 6
+            unsigned b = c;
+            unsigned error = 0;
+            if (parity == 8) b ^= 0x80;
+            else if (parity > 8) b ^= 1 << (parity - 9);
+            else if (parity != 0) error = HAMMING84_ERROR;
+
+            const unsigned x = ((b >> 2) & 0x1) | (((b >> 4) & 0x1) << 1) | (((b >> 5) & 0x1) << 2) | (((b >> 6) & 0x1) << 3);
+            decode[c] = uint8_t(x | error);
+        }
+    }
+
+    uint8_t encode[16];
+    uint8_t decode[256];
+};
+
+static inline const Hamming84Tables &hamming84Tables(void)
+{
+    static const Hamming84Tables tables;
+    return tables;
+}
+
+/***********************************************************************
+ * Encode a 4 bit word into a packed 8 bit codeword
+ **********************************************************************/
+static inline uint8_t encodeHamming84(const unsigned char x)
+{
+    return hamming84Tables().encode[x & 0xf];
+}
+
+/***********************************************************************
+ * Decode a packed 8 bit codeword into a 4 bit word with single bit correction
+ * Set error true when the result is known to be in error
+ **********************************************************************/
+static inline unsigned char decodeHamming84(const uint8_t c, bool &error)
+{
+    const uint8_t d = hamming84Tables().decode[c];
+    if ((d & HAMMING84_ERROR) != 0) error = true;
+    return d & 0xf;
+}
+
+/***********************************************************************
+ * Encode a 4 bit word into a 8 bits with parity
  **********************************************************************/
 static inline void encodeHamming84(const unsigned char x, char *b)
 {
-    auto d0 = (x >> 0) & 0x1;
-    auto d1 = (x >> 1) & 0x1;
-    auto d2 = (x >> 2) & 0x1;
-    auto d3 = (x >> 3) & 0x1;
-
-    b[0] = (d0 + d1 + d3) & 0x1;
-    b[1] = (d0 + d2 + d3) & 0x1;
-    b[2] = (d0) & 0x1;
-    b[3] = (d1 + d2 + d3) & 0x1;
-    b[4] = (d1) & 0x1;
-    b[5] = (d2) & 0x1;
-    b[6] = (d3) & 0x1;
-    b[7] = (d0 + d1 + d2) & 0x1;
+    const uint8_t c = encodeHamming84(x);
+    for (size_t i = 0; i < 8; i++) b[i] = (c >> i) & 0x1;
 }
 
 /***********************************************************************
@@ -81,42 +154,50 @@ static inline void encodeHamming84(const unsigned char x, char *b)
  **********************************************************************/
 static inline unsigned char decodeHamming84(const char *b, bool &error)
 {
-    auto b0 = b[0];
-    auto b1 = b[1];
-    auto b2 = b[2];
-    auto b3 = b[3];
-    auto b4 = b[4];
-    auto b5 = b[5];
-    auto b6 = b[6];
-    auto b7 = b[7];
-
-    auto p0 = (b0 + b2 + b4 + b6) & 0x1;
-    auto p1 = (b1 + b2 + b5 + b6) & 0x1;
-    auto p2 = (b3 + b4 + b5 + b6) & 0x1;
-    auto p3 = (b0 + b1 + b2 + b3 + b4 + b5 + b6 + b7) & 0x1;
-
-    auto parity = (p0 << 0) | (p1 << 1) | (p2 << 2) | (p3 << 3);
-    switch (parity & 0xf)
-    {
-    case 0: break; //no error
-    case 1:
-    case 2:
-    case 3:
-    case 4:
-    case 5:
-    case 6:
-    case 7: error = true; break; //uncorrectable
-    case 8: b7 = (~b7) & 0x1; break;
-    case 9: b0 = (~b0) & 0x1; break;
-    case 10: b1 = (~b1) & 0x1; break;
-    case 11: b2 = (~b2) & 0x1; break;
-    case 12: b3 = (~b3) & 0x1; break;
-    case 13: b4 = (~b4) & 0x1; break;
-    case 14: b5 = (~b5) & 0x1; break;
-    case 15: b6 = (~b6) & 0x1; break;
-    }
+    uint8_t c = 0;
+    for (size_t i = 0; i < 8; i++) c |= uint8_t(b[i] & 0x1) << i;
+    return decodeHamming84(c, error);
+}
 
-    return (b2 << 0) | (b4 << 1) | (b5 << 2) | (b6 << 3);
+/***********************************************************************
+ * Encode header data fields into a packed header word
+ * Header bit i is in bit i of the word, NUM_HEADER_BITS in total:
+ * the 2 time sync bits, then 7 codewords for id, length, and checksum.
+ **********************************************************************/
+static inline uint64_t encodeHeaderPacked(const FrameHeaderFields &hdr)
+{
+    const auto &table = hamming84Tables().encode;
+    uint64_t word = 0x2; //time sync 0 then 1
+    word |= uint64_t(table[(hdr.id >> 0) & 0xf]) << (2+0);
+    word |= uint64_t(table[(hdr.id >> 4) & 0xf]) << (2+8);
+    word |= uint64_t(table[(hdr.length >> 0) & 0xf]) << (2+16);
+    word |= uint64_t(table[(hdr.length >> 4) & 0xf]) << (2+24);
+    word |= uint64_t(table[(hdr.length >> 8) & 0xf]) << (2+32);
+    word |= uint64_t(table[(hdr.chksum >> 0) & 0xf]) << (2+40);
+    word |= uint64_t(table[(hdr.chksum >> 4) & 0xf]) << (2+48);
+    return word;
+}
+
+/***********************************************************************
+ * Decode header data fields from a packed header word
+ * Seven table lookups, the error flags are merged with one OR
+ **********************************************************************/
+static inline void decodeHeaderPacked(const uint64_t word, FrameHeaderFields &hdr)
+{
+    const auto &table = hamming84Tables().decode;
+    const auto c = word >> 2; //skip time sync
+    const uint8_t id0 = table[(c >> 0) & 0xff];
+    const uint8_t id1 = table[(c >> 8) & 0xff];
+    const uint8_t len0 = table[(c >> 16) & 0xff];
+    const uint8_t len1 = table[(c >> 24) & 0xff];
+    const uint8_t len2 = table[(c >> 32) & 0xff];
+    const uint8_t chk0 = table[(c >> 40) & 0xff];
+    const uint8_t chk1 = table[(c >> 48) & 0xff];
+
+    hdr.id = uint8_t((id0 & 0xf) | ((id1 & 0xf) << 4));
+    hdr.length = uint16_t((len0 & 0xf) | ((len1 & 0xf) << 4) | ((len2 & 0xf) << 8));
+    hdr.chksum = uint8_t((chk0 & 0xf) | ((chk1 & 0xf) << 4));
+    hdr.error = ((id0 | id1 | len0 | len1 | len2 | chk0 | chk1) & HAMMING84_ERROR) != 0;
 }
 
 /***********************************************************************
@@ -125,22 +206,8 @@ static inline unsigned char decodeHamming84(const char *b, bool &error)
  **********************************************************************/
 static inline void encodeHeaderWord(char *bits, const FrameHeaderFields &hdr)
 {
-    //insert time sync
-    *bits++ = 0;
-    *bits++ = 1;
-
-    //encode id
-    encodeHamming84(hdr.id >> 0, bits+0);
-    encodeHamming84(hdr.id >> 4, bits+8);
-
-    //encode length
-    encodeHamming84(hdr.length >> 0, bits+16);
-    encodeHamming84(hdr.length >> 4, bits+24);
-    encodeHamming84(hdr.length >> 8, bits+32);
-
-    //encode checksum
-    encodeHamming84(hdr.chksum >> 0, bits+40);
-    encodeHamming84(hdr.chksum >> 4, bits+48);
+    const auto word = encodeHeaderPacked(hdr);
+    for (size_t i = 0; i < NUM_HEADER_BITS; i++) bits[i] = (word >> i) & 0x1;
 }
 
 /***********************************************************************
@@ -149,24 +216,7 @@ static inline void encodeHeaderWord(char *bits, const FrameHeaderFields &hdr)
  **********************************************************************/
 static inline void decodeHeaderWord(const char *bits, FrameHeaderFields &hdr)
 {
-    hdr.error = false;
-
-    //skip time sync
-    bits+=2;
-
-    //decode id
-    hdr.id = 0;
-    hdr.id |= uint8_t(decodeHamming84(bits+0, hdr.error)) << 0;
-    hdr.id |= uint8_t(decodeHamming84(bits+8, hdr.error)) << 4;
-
-    //decode length
-    hdr.length = 0;
-    hdr.length |= uint16_t(decodeHamming84(bits+16, hdr.error)) << 0;
-    hdr.length |= uint16_t(decodeHamming84(bits+24, hdr.error)) << 4;
-    hdr.length |= uint16_t(decodeHamming84(bits+32, hdr.error)) << 8;
-
-    //decode checksum
-    hdr.chksum = 0;
-    hdr.chksum |= uint8_t(decodeHamming84(bits+40, hdr.error)) << 0;
-    hdr.chksum |= uint8_t(decodeHamming84(bits+48, hdr.error)) << 4;
+    uint64_t word = 0;
+    for (size_t i = 0; i < NUM_HEADER_BITS; i++) word |= uint64_t(bits[i] & 0x1) << i;
+    decodeHeaderPacked(word, hdr);
 }
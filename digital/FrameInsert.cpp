@@ -224,7 +224,6 @@ public:
                 auto p = newPreambleBuff.as<Type *>() + _syncWordWidth;
 
                 //encode the header field into bits
-                char headerBits[NUM_HEADER_BITS];
                 FrameHeaderFields headerFields;
                 headerFields.id = _headerId;
                 headerFields.length = 0;
@@ -233,13 +232,13 @@ public:
                     headerFields.length = label.data.template convert<size_t>()*label.width;
                 }
                 headerFields.chksum = headerFields.doChecksum();
-                encodeHeaderWord(headerBits, headerFields);
+                const auto headerWord = encodeHeaderPacked(headerFields);
 
                 //encode header fields as BPSK into the preamble buffer
                 const auto sym = _preamble.back();
                 for (size_t i = 0; i < NUM_HEADER_BITS; i++)
                 {
-                    *p++ = (headerBits[i] != 0)?+sym:-sym;
+                    *p++ = (((headerWord >> i) & 0x1) != 0)?+sym:-sym;
                 }
 
                 //post the preamble buffer
@@ -3,12 +3,18 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "FrameHelper.hpp"
+#include "PhaseRotator.hpp"
+#include "common/ThreadPool.hpp"
 #include <Pothos/Framework.hpp>
 #include <cstring> //memcpy
 #include <iostream>
 #include <algorithm> //min/max
 #include <complex>
 #include <cstdint>
+#include <cmath>
+#include <vector>
+#include <memory>
+#include <chrono>
 
 /***********************************************************************
  * |PothosDoc Frame Sync
@@ -57,6 +63,14 @@
  * The next downstream block may perform symbol detection
  * to remap the recovered symbols into data bits.
  *
+ * <h2>Statistics</h2>
+ *
+ * The frame sync block keeps counters that can be probed at runtime
+ * to tune thresholds and to measure the processing load:
+ * candidate peaks, accepted frames, header rejections by cause,
+ * input samples consumed while searching and while forwarding payload,
+ * and the time spent in each of those two modes.
+ *
  * |category /Digital
  * |keywords preamble frame sync timing offset recover
  * |alias /blocks/frame_sync
@@ -122,6 +136,12 @@
  * |preview valid
  * |tab Labels
  *
+ * |param searchThreads[Search Threads] The number of threads used to search for frames.
+ * With more than one thread, large input buffers are split into overlapping segments
+ * that are searched concurrently, for wideband inputs that one core cannot scan.
+ * |default 1
+ * |preview valid
+ *
  * |param verboseMode[Verbose Mode] Enable debug verbose when frames are discovered.
  * |default false
  * |preview disable
@@ -138,6 +158,7 @@
  * |setter setFrameEndId(frameEndId)
  * |setter setPhaseOffsetID(phaseOffsetID)
  * |setter setInputThreshold(inputThreshold)
+ * |setter setSearchThreads(searchThreads)
  * |setter setVerboseMode(verboseMode)
  **********************************************************************/
 template <typename Type>
@@ -158,7 +179,20 @@ public:
         _syncWordWidth(0),
         _frameWidth(0),
         _inputThreshold(0),
-        _verbose(false)
+        _verbose(false),
+        _peakCount(0),
+        _frameCount(0),
+        _headerErrorCount(0),
+        _checksumErrorCount(0),
+        _wrongIdCount(0),
+        _searchSampleCount(0),
+        _payloadSampleCount(0),
+        _searchTimeNs(0),
+        _payloadTimeNs(0),
+        _searchSegments(0),
+        _searchPosition(0),
+        _searchOffsets(0),
+        _searchThreads(1)
     {
         this->setupInput(0, typeid(Type));
         this->setupOutput(0, typeid(Type));
@@ -180,7 +214,27 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getPhaseOffsetID));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setInputThreshold));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getInputThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setSearchThreads));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getSearchThreads));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setVerboseMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getPeakCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getFrameCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getHeaderErrorCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getChecksumErrorCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getWrongIdCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getSearchSampleCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getPayloadSampleCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getSearchTimeNs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getPayloadTimeNs));
+        this->registerProbe("getPeakCount");
+        this->registerProbe("getFrameCount");
+        this->registerProbe("getHeaderErrorCount");
+        this->registerProbe("getChecksumErrorCount");
+        this->registerProbe("getWrongIdCount");
+        this->registerProbe("getSearchSampleCount");
+        this->registerProbe("getPayloadSampleCount");
+        this->registerProbe("getSearchTimeNs");
+        this->registerProbe("getPayloadTimeNs");
 
         this->setHeaderId(0x55); //initial update
         this->setOutputMode("RAW"); //initial update
@@ -292,6 +346,7 @@ public:
     {
         if (threshold < 0) throw Pothos::InvalidArgumentException("FrameSync::setInputThreshold()", "threshold should be non-negative");
         _inputThreshold = threshold;
+        _searchOffsets = 0; //the kept segment candidates depend on the threshold
     }
 
     RealType getInputThreshold(void) const
@@ -299,11 +354,78 @@ public:
         return _inputThreshold;
     }
 
+    void setSearchThreads(const size_t numThreads)
+    {
+        if (numThreads == 0) throw Pothos::InvalidArgumentException("FrameSync::setSearchThreads()", "number of threads cannot be 0");
+        _searchThreads = numThreads;
+        if (numThreads > 1) _searchPool.reset(new ThreadPool(numThreads));
+        else _searchPool.reset();
+    }
+
+    size_t getSearchThreads(void) const
+    {
+        return _searchThreads;
+    }
+
     void setVerboseMode(const bool enb)
     {
         _verbose = enb;
     }
 
+    //! Number of correlation peaks that were decoded as a frame header
+    unsigned long long getPeakCount(void) const
+    {
+        return _peakCount;
+    }
+
+    //! Number of frames with a valid header that were forwarded
+    unsigned long long getFrameCount(void) const
+    {
+        return _frameCount;
+    }
+
+    //! Number of headers with uncorrectable Hamming code errors
+    unsigned long long getHeaderErrorCount(void) const
+    {
+        return _headerErrorCount;
+    }
+
+    //! Number of headers that failed the checksum
+    unsigned long long getChecksumErrorCount(void) const
+    {
+        return _checksumErrorCount;
+    }
+
+    //! Number of headers rejected for an unexpected header ID
+    unsigned long long getWrongIdCount(void) const
+    {
+        return _wrongIdCount;
+    }
+
+    //! Number of input samples consumed while searching for frames
+    unsigned long long getSearchSampleCount(void) const
+    {
+        return _searchSampleCount;
+    }
+
+    //! Number of input samples consumed while forwarding payload
+    unsigned long long getPayloadSampleCount(void) const
+    {
+        return _payloadSampleCount;
+    }
+
+    //! Time spent in work() while searching for frames
+    unsigned long long getSearchTimeNs(void) const
+    {
+        return _searchTimeNs;
+    }
+
+    //! Time spent in work() while forwarding payload
+    unsigned long long getPayloadTimeNs(void) const
+    {
+        return _payloadTimeNs;
+    }
+
     void work(void);
 
     void propagateLabels(const Pothos::InputPort *)
@@ -330,13 +452,60 @@ public:
         _phase = 0;
         _phaseInc = 0;
         _remainingPayload = 0;
+        _peakCount = 0;
+        _frameCount = 0;
+        _headerErrorCount = 0;
+        _checksumErrorCount = 0;
+        _wrongIdCount = 0;
+        _searchSampleCount = 0;
+        _payloadSampleCount = 0;
+        _searchTimeNs = 0;
+        _payloadTimeNs = 0;
+        _searchOffsets = 0;
     }
 
 private:
 
-    void processEnvelope(const Type *in, RealType &scale);
-    void processFreqSync(const Type *in, RealType &deltaFc);
-    void processSyncWord(const Type *in, const RealType &deltaFc, const RealType &scale, RealType &phaseOff, size_t &corrPeak);
+    //a correlation above the magnitude threshold found by a segment search
+    struct SearchCandidate
+    {
+        size_t offset;
+        RealType scale;
+        RealType deltaFc;
+        RealType phaseOff;
+        size_t corrPeak;
+    };
+
+    //window sums over a range of search offsets, any offset is evaluated in O(1) per sum
+    struct SearchSegment
+    {
+        size_t base; //first offset of the sums, a multiple of the search step
+        size_t begin; //first offset searched by this segment
+        size_t end; //offset after the last offset searched by this segment
+        std::vector<double> ampSums; //prefix sums of the amplitude
+        std::vector<std::complex<double>> lagSums; //prefix sums of the half symbol lag product
+        std::vector<Type> symSums; //sum over one preamble symbol width at every offset
+        std::vector<char> coarseHits; //coarse offsets above the magnitude threshold
+        std::vector<SearchCandidate> candidates; //fine offsets above the magnitude threshold
+
+        //is offset i within one search step of a coarse offset above the threshold?
+        bool refined(const size_t i, const size_t step) const
+        {
+            const size_t k = (i-base)/step;
+            if (coarseHits[k] != 0) return true;
+            return (i % step) != 0 and k+1 < coarseHits.size() and coarseHits[k+1] != 0;
+        }
+    };
+
+    void workPayload(void);
+    void workSearch(void);
+    void initSearchSums(const Type *in, const size_t N, SearchSegment &seg) const;
+    void searchSegment(const Type *in, const size_t N, const size_t begin, const size_t end, const size_t step, SearchSegment &seg) const;
+    void evaluateOffset(const Type *in, const size_t i, const size_t shift, const size_t step, SearchCandidate &c) const;
+    void processOffset(const Type *in, const SearchSegment &seg, const size_t i, RealType &scale, RealType &deltaFc, RealType &phaseOff, size_t &corrPeak) const;
+    void processEnvelope(const Type *in, const SearchSegment &seg, const size_t i, RealType &scale) const;
+    void processFreqSync(const SearchSegment &seg, const size_t i, RealType &deltaFc) const;
+    void processSyncWord(const Type *in, const Type *symSums, const RealType &deltaFc, const RealType &scale, RealType &phaseOff, size_t &corrPeak) const;
     void processHeaderBits(const Type *in, const RealType &deltaFc, const RealType &scale, const RealType &phaseOff, size_t &firstBit, FrameHeaderFields &headerFields);
 
     void updateSettings(void)
@@ -345,6 +514,7 @@ private:
         _frameWidth = _syncWordWidth+(NUM_HEADER_BITS*_dataWidth);
         _corrMagThresh = size_t(_syncWordWidth*CORR_MAG_PERCENT);
         _corrDurThresh = size_t(_syncWordWidth*CORR_DUR_PERCENT);
+        _searchOffsets = 0; //the kept results depend on the widths
     }
 
     //output mode
@@ -382,6 +552,26 @@ private:
     //calculated output offset corrections
     RealType _phase;
     RealType _phaseInc;
+
+    //statistics counters
+    unsigned long long _peakCount;
+    unsigned long long _frameCount;
+    unsigned long long _headerErrorCount;
+    unsigned long long _checksumErrorCount;
+    unsigned long long _wrongIdCount;
+    unsigned long long _searchSampleCount;
+    unsigned long long _payloadSampleCount;
+    unsigned long long _searchTimeNs;
+    unsigned long long _payloadTimeNs;
+
+    //search state for the serial and the parallel segmented search
+    SearchSegment _search;
+    std::vector<SearchSegment> _segments;
+    size_t _searchSegments; //number of segments of the kept results, the serial sums when at most one
+    unsigned long long _searchPosition; //input position of the first offset of the kept results
+    size_t _searchOffsets; //number of offsets covered by the kept results
+    size_t _searchThreads;
+    std::unique_ptr<ThreadPool> _searchPool;
 };
 
 /***********************************************************************
@@ -389,6 +579,24 @@ private:
  **********************************************************************/
 template <typename Type>
 void FrameSync<Type>::work(void)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const bool payloadMode = (_remainingPayload != 0);
+
+    if (payloadMode) this->workPayload();
+    else this->workSearch();
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    if (payloadMode) _payloadTimeNs += elapsed;
+    else _searchTimeNs += elapsed;
+}
+
+/***********************************************************************
+ * Forward the payload of a found frame
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::workPayload(void)
 {
     auto inPort = this->input(0);
     auto outPort = this->output(0);
@@ -407,6 +615,7 @@ void FrameSync<Type>::work(void)
             out[i] = in[i]*_scaleAtMax;
         }
 
+        _payloadSampleCount += N;
         _remainingPayload -= N;
         inPort->consume(N);
         outPort->produce(N);
@@ -420,12 +629,11 @@ void FrameSync<Type>::work(void)
     {
         const auto N = std::min(_remainingPayload, this->workInfo().minElements);
 
-        for (size_t i = 0; i < N; i++)
-        {
-            out[i] = in[i]*std::polar<RealType>(_scaleAtMax, _phase);
-            _phase += _phaseInc;
-        }
+        PhaseRotator<Type> rotator(_scaleAtMax, _phase, _phaseInc);
+        rotator.rotate(in, 1, out, N);
+        _phase = rotator.phase();
 
+        _payloadSampleCount += N;
         _remainingPayload -= N;
         inPort->consume(N);
         outPort->produce(N);
@@ -441,20 +649,29 @@ void FrameSync<Type>::work(void)
         N = std::min(N/_dataWidth, outPort->elements());
         if (N == 0) inPort->setReserve(_dataWidth);
 
-        for (size_t i = 0; i < N; i++)
-        {
-            const auto sym = in[i*_dataWidth];
-            out[i] = sym*std::polar<RealType>(_scaleAtMax, _phase);
-            _phase += _phaseInc*_dataWidth;
-        }
+        PhaseRotator<Type> rotator(_scaleAtMax, _phase, _phaseInc*_dataWidth);
+        rotator.rotate(in, _dataWidth, out, N);
+        _phase = rotator.phase();
 
         const size_t consumed = N*_dataWidth;
+        _payloadSampleCount += consumed;
         _remainingPayload -= consumed;
         inPort->consume(consumed);
         outPort->produce(N);
         //if (_remainingPayload == 0) std::cout << "payload forwarded\n";
         return;
     }
+}
+
+/***********************************************************************
+ * Search the input for a new frame
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::workSearch(void)
+{
+    auto inPort = this->input(0);
+    auto outPort = this->output(0);
+    const Type *in = inPort->buffer();
 
     /***************************************************************
      * Correlation search for a new frame
@@ -467,22 +684,72 @@ void FrameSync<Type>::work(void)
     }
     const auto N = inPort->elements()-requireMin+1;
 
-    for (size_t i = 0; i < N; i++)
+    //Adjacent offsets are redundant because of the oversampling.
+    //While no candidate is tracked, only every searchStep offsets are evaluated.
+    //A coarse offset above the threshold rewinds to the previous coarse offset
+    //and the search continues at full resolution until the peak is resolved.
+    const size_t searchStep = std::max<size_t>(_dataWidth/2, 1);
+    size_t refineEnd = 0;
+
+    //The parallel search splits the offsets into one segment per thread.
+    //Each segment evaluates the coarse offsets and the refine windows in its range.
+    //The sums of a segment extend past its range to the next coarse offset,
+    //plus the frameWidth-1 samples read by the last offset.
+    //The peak tracking below then steps through the offsets exactly like the serial search,
+    //and looks up the segment results instead of evaluating the offsets again.
+    //A peak that is already tracked from the previous call is resolved serially.
+    //The serial sums or the segment results are kept across calls with the input position of their first offset,
+    //so the offsets that the last call did not consume, after a found frame, are not searched again.
+    const auto position = inPort->totalElements();
+    if (position - _searchPosition >= _searchOffsets) //no results kept for this input
     {
-        //process the potential frame to discover these values
-        RealType scale = 0;
-        RealType deltaFc = 0;
-        RealType phaseOff = 0;
-        size_t corrPeak = 0;
+        const size_t numSegments = (_searchPool and _maxCorrPeak == 0)?std::min(_searchPool->size(), N/_frameWidth):0;
+        if (numSegments > 1)
+        {
+            _segments.resize(numSegments);
+            _searchPool->run(numSegments, [&](const size_t seg)
+            {
+                const size_t begin = (N*seg)/numSegments;
+                const size_t end = (N*(seg+1))/numSegments;
+                this->searchSegment(in, N, begin, end, searchStep, _segments[seg]);
+            });
+        }
+        else
+        {
+            //window sums for every offset are computed up front,
+            //so that each offset is evaluated without a loop over samples
+            this->initSearchSums(in, N, _search);
+        }
+        _searchSegments = numSegments;
+        _searchPosition = position;
+        _searchOffsets = N;
+    }
 
-        //calculate the scaling value, and check for consistent envelope
-        this->processEnvelope(in+i, scale);
+    //offset i of this call is offset shift+i of the kept results,
+    //and the search stops at the last kept offset
+    const size_t shift = size_t(position - _searchPosition);
+    const size_t numOffsets = std::min(N, _searchOffsets - shift);
 
-        //calculate the frequency offset as if this was the frame start
-        if (scale != 0) this->processFreqSync(in+i, deltaFc);
+    for (size_t i = 0; i < numOffsets; i++)
+    {
+        const bool refine = _maxCorrPeak != 0 or i < refineEnd;
+        if (not refine)
+        {
+            if ((i % searchStep) != 0) continue;
+            SearchCandidate c;
+            this->evaluateOffset(in, i, shift, searchStep, c);
+            if (c.corrPeak <= _corrMagThresh) continue;
+            refineEnd = i + searchStep;
+            i = (i < searchStep)?0:(i - searchStep + 1);
+        }
 
-        //use the frequency offset to calculate the correlation value
-        if (scale != 0) this->processSyncWord(in+i, deltaFc, scale, phaseOff, corrPeak);
+        //process the potential frame to discover these values
+        SearchCandidate c;
+        this->evaluateOffset(in, i, shift, searchStep, c);
+        const RealType scale = c.scale;
+        const RealType deltaFc = c.deltaFc;
+        const RealType phaseOff = c.phaseOff;
+        const size_t corrPeak = c.corrPeak;
 
         //if this correlation value is larger, record the state
         if (corrPeak > _maxCorrPeak and corrPeak > _corrMagThresh)
@@ -513,6 +780,7 @@ void FrameSync<Type>::work(void)
         }
 
         _maxCorrPeak = 0; //reset for next time
+        _peakCount++;
 
         //now that the frame was found, process the length field
         //and determine sample offset (used in timing recovery mode)
@@ -530,9 +798,21 @@ void FrameSync<Type>::work(void)
             std::cout << " chksum = 0x" << std::hex << int(headerFields.chksum) << std::dec << std::endl;
         }
 
-        if (headerFields.error) continue; //error correction not possible
-        if (headerFields.chksum != headerFields.doChecksum()) continue; //checksum failed
-        if (headerFields.id != _headerId) continue; //reject unknown id
+        if (headerFields.error) //error correction not possible
+        {
+            _headerErrorCount++;
+            continue;
+        }
+        if (headerFields.chksum != headerFields.doChecksum()) //checksum failed
+        {
+            _checksumErrorCount++;
+            continue;
+        }
+        if (headerFields.id != _headerId) //reject unknown id
+        {
+            _wrongIdCount++;
+            continue;
+        }
         if (headerFields.length == 0) continue; //length not provided
         const size_t length = headerFields.length;
 
@@ -582,18 +862,166 @@ void FrameSync<Type>::work(void)
         if (not _frameEndId.empty()) outPort->postLabel(
             _frameEndId, length, labelEnd, labelWidth);
 
+        _frameCount++;
+        _searchSampleCount += payloadOffset;
         inPort->setReserve(0);
         inPort->consume(payloadOffset);
         return;
     }
-    inPort->consume(N);
+    _searchSampleCount += numOffsets;
+    inPort->consume(numOffsets);
+}
+
+/***********************************************************************
+ * Compute the window sums used at every search offset
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::initSearchSums(const Type *in, const size_t N, SearchSegment &seg) const
+{
+    const size_t width = _symbolWidth*_dataWidth;
+    const size_t delta = width/2;
+    const size_t numElems = N + _frameWidth - 1;
+
+    //prefix sums of amplitude used by processEnvelope()
+    auto &ampSums = seg.ampSums;
+    ampSums.resize(numElems+1);
+    ampSums[0] = 0;
+    for (size_t k = 0; k < numElems; k++) ampSums[k+1] = ampSums[k] + std::abs(in[k]);
+
+    //prefix sums of the lag product used by processFreqSync()
+    const size_t numLags = numElems - delta;
+    auto &lagSums = seg.lagSums;
+    lagSums.resize(numLags+1);
+    lagSums[0] = 0;
+    for (size_t k = 0; k < numLags; k++)
+    {
+        lagSums[k+1] = lagSums[k] + std::complex<double>(in[k]*std::conj(in[k+delta]));
+    }
+
+    //sum over one preamble symbol at every offset used by processSyncWord()
+    const size_t numSums = N + width*(_preamble.size()-1);
+    auto &symSums = seg.symSums;
+    symSums.resize(numSums);
+    std::complex<double> acc = 0;
+    for (size_t k = 0; k < width; k++) acc += std::complex<double>(in[k]);
+    symSums[0] = Type(acc);
+    for (size_t j = 1; j < numSums; j++)
+    {
+        acc += std::complex<double>(in[j-1+width]) - std::complex<double>(in[j-1]);
+        symSums[j] = Type(acc);
+    }
+}
+
+/***********************************************************************
+ * Search offsets [begin, end) of N offsets for correlation candidates
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::searchSegment(const Type *in, const size_t N, const size_t begin, const size_t end, const size_t step, SearchSegment &seg) const
+{
+    RealType scale = 0;
+    RealType deltaFc = 0;
+    RealType phaseOff = 0;
+    size_t corrPeak = 0;
+    seg.candidates.clear();
+
+    //the segment covers the coarse offsets on either side of its range,
+    //so that the refine windows are the same as in the serial search
+    const size_t base = (begin/step)*step;
+    const size_t lastCoarse = std::min(((end-1)/step+1)*step, ((N-1)/step)*step);
+    const size_t last = std::max(lastCoarse, end-1);
+    const auto segIn = in + base;
+    seg.base = base;
+    seg.begin = begin;
+    seg.end = end;
+    this->initSearchSums(segIn, last-base+1, seg);
+
+    //coarse search over the aligned offsets
+    seg.coarseHits.assign((lastCoarse-base)/step+1, 0);
+    for (size_t k = 0; k < seg.coarseHits.size(); k++)
+    {
+        this->processOffset(segIn+k*step, seg, k*step, scale, deltaFc, phaseOff, corrPeak);
+        seg.coarseHits[k] = (corrPeak > _corrMagThresh)?1:0;
+    }
+
+    //refine within one step of a coarse offset above the threshold
+    for (size_t i = begin; i < end; i++)
+    {
+        if (not seg.refined(i, step)) continue;
+        this->processOffset(in+i, seg, i-base, scale, deltaFc, phaseOff, corrPeak);
+        if (corrPeak <= _corrMagThresh) continue;
+        SearchCandidate c;
+        c.offset = i;
+        c.scale = scale;
+        c.deltaFc = deltaFc;
+        c.phaseOff = phaseOff;
+        c.corrPeak = corrPeak;
+        seg.candidates.push_back(c);
+    }
+}
+
+/***********************************************************************
+ * Evaluate offset i for the peak tracking in workSearch(),
+ * which is offset shift+i of the kept search results
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::evaluateOffset(const Type *in, const size_t i, const size_t shift, const size_t step, SearchCandidate &c) const
+{
+    c.offset = i;
+    c.scale = 0;
+    c.deltaFc = 0;
+    c.phaseOff = 0;
+    c.corrPeak = 0;
+    if (_searchSegments <= 1) return this->processOffset(in+i, _search, shift+i, c.scale, c.deltaFc, c.phaseOff, c.corrPeak);
+
+    //the segments list the offsets of the input that they were searched in
+    const size_t j = shift+i;
+    size_t s = _searchSegments-1;
+    while (j < _segments[s].begin) s--;
+    const auto &seg = _segments[s];
+
+    //the refine windows were evaluated by the segment, which lists the candidates
+    if (seg.refined(j, step))
+    {
+        const auto it = std::lower_bound(seg.candidates.begin(), seg.candidates.end(), j,
+            [](const SearchCandidate &a, const size_t offset){return a.offset < offset;});
+        if (it != seg.candidates.end() and it->offset == j) c = *it;
+        c.offset = i;
+        return;
+    }
+
+    //the other coarse offsets are below the threshold,
+    //and the offsets that follow a tracked peak are evaluated here
+    if ((j % step) == 0) return;
+    this->processOffset(in+i, seg, j-seg.base, c.scale, c.deltaFc, c.phaseOff, c.corrPeak);
+}
+
+/***********************************************************************
+ * Evaluate the correlation for a frame starting at in,
+ * which is offset i of the window sums in seg
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::processOffset(const Type *in, const SearchSegment &seg, const size_t i, RealType &scale, RealType &deltaFc, RealType &phaseOff, size_t &corrPeak) const
+{
+    scale = 0;
+    deltaFc = 0;
+    phaseOff = 0;
+    corrPeak = 0;
+
+    //calculate the scaling value, and check for consistent envelope
+    this->processEnvelope(in, seg, i, scale);
+
+    //calculate the frequency offset as if this was the frame start
+    if (scale != 0) this->processFreqSync(seg, i, deltaFc);
+
+    //use the frequency offset to calculate the correlation value
+    if (scale != 0) this->processSyncWord(in, seg.symSums.data()+i, deltaFc, scale, phaseOff, corrPeak);
 }
 
 /***********************************************************************
  * Process the envelope of the frame preamble
  **********************************************************************/
 template <typename Type>
-void FrameSync<Type>::processEnvelope(const Type *in, RealType &scale)
+void FrameSync<Type>::processEnvelope(const Type *in, const SearchSegment &seg, const size_t i, RealType &scale) const
 {
     scale = 0;
 
@@ -602,26 +1030,17 @@ void FrameSync<Type>::processEnvelope(const Type *in, RealType &scale)
     if (std::abs(in[_syncWordWidth-_dataWidth]) < _inputThreshold) return;
 
     //get a rough average of amplitude at the beginning
-    RealType sum0 = 0;
     const size_t begin0 = _dataWidth;
     const size_t end0 = (_symbolWidth*_dataWidth/2);
-    for (size_t i = begin0; i < end0; i++)
-    {
-        sum0 += std::abs(in[i]);
-    }
-    sum0 /= (end0-begin0);
+    if (end0 <= begin0) return;
+    RealType sum0 = RealType((seg.ampSums[i+end0]-seg.ampSums[i+begin0])/(end0-begin0));
     if (sum0 < _inputThreshold) return;
     sum0 /= std::abs(_preamble.front());
 
     //get a rough average of amplitude at the end
-    RealType sum1 = 0;
     const size_t begin1 = _syncWordWidth-(_symbolWidth*_dataWidth/2);
     const size_t end1 = _syncWordWidth-_dataWidth;
-    for (size_t i = begin1; i < end1; i++)
-    {
-        sum1 += std::abs(in[i]);
-    }
-    sum1 /= (end1-begin1);
+    RealType sum1 = RealType((seg.ampSums[i+end1]-seg.ampSums[i+begin1])/(end1-begin1));
     if (sum1 < _inputThreshold) return;
     sum1 /= std::abs(_preamble.back());
 
@@ -637,13 +1056,13 @@ void FrameSync<Type>::processEnvelope(const Type *in, RealType &scale)
  * Process the frame sync to find the freq offset
  **********************************************************************/
 template <typename Type>
-void FrameSync<Type>::processFreqSync(const Type *in, RealType &deltaFc)
+void FrameSync<Type>::processFreqSync(const SearchSegment &seg, const size_t i, RealType &deltaFc) const
 {
     //width of a preamble symbol in samples
     const size_t width = _symbolWidth*_dataWidth;
 
     //offset into the start of the final preamble symbol
-    auto syms = in + width*(_preamble.size()-1);
+    const size_t syms = i + width*(_preamble.size()-1);
 
     //difference between any two compare samples
     const size_t delta = width/2;
@@ -652,36 +1071,53 @@ void FrameSync<Type>::processFreqSync(const Type *in, RealType &deltaFc)
     const size_t padding = _dataWidth;
     const size_t begin = padding;
     const size_t end = width - delta - padding;
+    if (end <= begin or end > width) return;
 
     //calculate the frequency offset across multiple
     //pairs of samples that are within the same symbol
-    Type K = 0;
-    for (size_t i = begin; i < end; i++)
-    {
-        K += syms[i] * std::conj(syms[i+delta]);
-    }
-    deltaFc = std::arg(K)/delta;
+    const auto K = seg.lagSums[syms+end] - seg.lagSums[syms+begin];
+    deltaFc = RealType(std::arg(K)/delta);
 }
 
 /***********************************************************************
  * Process the sync word to find the max correlation
  **********************************************************************/
 template <typename Type>
-void FrameSync<Type>::processSyncWord(const Type *in, const RealType &deltaFc, const RealType &scale, RealType &phaseOff, size_t &corrPeak)
+void FrameSync<Type>::processSyncWord(const Type *in, const Type *symSums, const RealType &deltaFc, const RealType &scale, RealType &phaseOff, size_t &corrPeak) const
 {
-    //using scale and frequency offset, calculate correlation
-    Type L = 0;
-    RealType freqCorr = 0;
-    auto frameSyms = in;
+    //The preamble is constant across each symbol, so the frequency corrected
+    //correlation is first estimated from one sum per preamble symbol (see initSearchSums).
+    //Each symbol sum is rotated by the frequency offset at the symbol center.
+    //The residual rotation within a symbol scales every term by the same
+    //Dirichlet gain, which is divided out, so the estimate of a preamble
+    //does not fall with the frequency offset.
     const auto width = _symbolWidth*_dataWidth;
+    const RealType half = deltaFc/2;
+    const RealType den = width*std::sin(half);
+    const RealType gain = (den == 0)?RealType(1):RealType(std::sin(half*width)/den);
+    const RealType minGain = 0.1; //the gain is zero at the edge of the frequency estimate range
+    const Type symbolRot = std::polar<RealType>(1, deltaFc*width);
+    Type rot = std::polar<RealType>(scale/std::max(gain, minGain), deltaFc*(width-1)/2);
+
+    Type L = 0;
     for (size_t i = 0; i < _preamble.size(); i++)
     {
-        const auto sym = std::conj(_preamble[i]);
-        for (size_t j = 0; j < width; j++)
+        L += std::conj(_preamble[i])*symSums[i*width]*rot;
+        rot *= symbolRot;
+    }
+
+    //Only an estimate above the threshold can be a peak. Its correlation is
+    //recomputed with every sample derotated, so a wrong frequency estimate
+    //is not amplified by the gain correction and the peaks rank exactly.
+    if (size_t(std::abs(L)) > _corrMagThresh)
+    {
+        PhaseRotator<Type> rotator(scale, 0, deltaFc);
+        L = 0;
+        auto frameSyms = in;
+        for (size_t i = 0; i < _preamble.size(); i++)
         {
-            auto frameSym = *frameSyms++;
-            L += sym*frameSym*std::polar<RealType>(scale, freqCorr);
-            freqCorr += deltaFc;
+            const auto sym = std::conj(_preamble[i]);
+            for (size_t j = 0; j < width; j++) L += sym*(*frameSyms++)*rotator.next();
         }
     }
 
@@ -708,9 +1144,11 @@ void FrameSync<Type>::processHeaderBits(const Type *in, const RealType &deltaFc,
     //search from the middle of the last symbol to the frame end
     firstBit = _syncWordWidth + _dataWidth/2;
     RealType firstBitPeak = 0;
-    for (size_t i = _syncWordWidth-(_dataWidth*_symbolWidth/2); i < _frameWidth; i++)
+    const size_t searchStart = _syncWordWidth-(_dataWidth*_symbolWidth/2);
+    PhaseRotator<Type> searchRotator(scale, phaseOff + deltaFc*searchStart, deltaFc);
+    for (size_t i = searchStart; i < _frameWidth; i++)
     {
-        auto bit = in[i]*std::polar<RealType>(scale, phaseOff + deltaFc*i)*sym;
+        auto bit = in[i]*searchRotator.next()*sym;
         if (bit.real() > firstBitPeak)
         {
             if (firstBitPeak == 0) continue; //before peak found
@@ -725,21 +1163,20 @@ void FrameSync<Type>::processHeaderBits(const Type *in, const RealType &deltaFc,
 
     //offsets to sampling index of header bits
     auto headerSyms = in + firstBit;
-    RealType freqCorr = phaseOff + deltaFc*(firstBit);
+    PhaseRotator<Type> headerRotator(scale, phaseOff + deltaFc*(firstBit), deltaFc*_dataWidth);
 
-    //decode from BPSK into header field bits
+    //decode from BPSK into a packed header word
     //the bit value is the phase difference with the last symbol
-    char headerBits[NUM_HEADER_BITS];
+    uint64_t headerWord = 0;
     for (size_t i = 0; i < NUM_HEADER_BITS; i++)
     {
-        auto bit = (*headerSyms)*std::polar<RealType>(scale, freqCorr)*sym;
-        headerBits[i] = (bit.real() > 0)?1:0;
-        freqCorr += deltaFc*_dataWidth;
+        auto bit = (*headerSyms)*headerRotator.next()*sym;
+        headerWord |= uint64_t((bit.real() > 0)?1:0) << i;
         headerSyms += _dataWidth;
     }
 
     //decode the bits into header fields
-    decodeHeaderWord(headerBits, headerFields);
+    decodeHeaderPacked(headerWord, headerFields);
 }
 
 /***********************************************************************
@@ -0,0 +1,256 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include "lfsr.h"
+#include <cstdint>
+#include <cstddef>
+#include <cstring> //memcpy
+#include <vector>
+
+/***********************************************************************
+ * Table driven Galois LFSR scrambler for one bit per byte streams,
+ * and for packed streams of 8 bits per byte.
+ *
+ * Every step of the LFSR in lfsr.h is linear over GF(2) in the state
+ * and the input bit, so the outputs and the state after many steps are
+ * the XOR of the contributions from each byte of the state and from the
+ * input bits. The contributions are precomputed by stepping the LFSR.
+ *
+ * Additive mode does not depend on the input, and it advances 64 bits
+ * per step: one lookup per state byte yields 64 bits of keystream.
+ * Multiplicative mode advances 8 bits per step, with one more lookup
+ * for the contribution of the 8 input bits.
+ **********************************************************************/
+class LFSRTable
+{
+public:
+    enum Mode {ADDITIVE, SCRAMBLE, DESCRAMBLE};
+
+    //! One bit of the scrambler, used to build the tables and for the tail
+    static unsigned char stepBit(lfsr_t &lfsr, const Mode mode, const unsigned char in)
+    {
+        const unsigned char ret = GLFSR_next(&lfsr);
+        const unsigned char out = in ^ ret;
+        if (mode == ADDITIVE) return out;
+
+        //multiplicative mode: the output bit (scrambler)
+        //or the input bit (descrambler) becomes the next bit0
+        lfsr.data &= ~lfsr_data_t(0x1);
+        lfsr.data |= (mode == SCRAMBLE)?out:in;
+        return out;
+    }
+
+    LFSRTable(void):
+        _mode(ADDITIVE),
+        _numSlices(0),
+        _stateMask(0)
+    {
+        return;
+    }
+
+    //! Build the tables for the polynomial of lfsr in the given mode
+    void init(const lfsr_t &lfsr, const Mode mode)
+    {
+        _mode = mode;
+
+        //GLFSR_init() sign extends the degree bit, so the mask is every bit from the degree up.
+        //The state is the bits below the degree, other polynomials use the bit serial path.
+        const uint64_t mask = uint64_t(lfsr.mask);
+        const uint64_t poly = uint64_t(lfsr.polynomial);
+        _numSlices = 0;
+        if (mask == 0) return;
+        size_t degree = 0;
+        while (((mask >> degree) & 0x1) == 0) degree++;
+        if (degree == 0 or (poly >> degree) != 1) return;
+        _stateMask = (uint64_t(1) << degree)-1;
+        _numSlices = (degree+7)/8;
+
+        //contributions of each state byte with a zero input
+        const size_t stepBits = (mode == ADDITIVE)?64:8;
+        _stateOut.resize(_numSlices*256);
+        _stateNext.resize(_numSlices*256);
+        for (size_t b = 0; b < _numSlices; b++)
+        {
+            for (size_t v = 0; v < 256; v++)
+            {
+                lfsr_t state(lfsr);
+                state.data = lfsr_data_t((uint64_t(v) << (8*b)) & _stateMask);
+                uint64_t out = 0;
+                for (size_t k = 0; k < stepBits; k++)
+                {
+                    out |= uint64_t(stepBit(state, mode, 0)) << k;
+                }
+                _stateOut[b*256+v] = out;
+                _stateNext[b*256+v] = uint64_t(state.data) & _stateMask;
+            }
+        }
+
+        //contributions of 8 input bits with a zero state
+        if (mode == ADDITIVE) return;
+        _inputOut.resize(256);
+        _inputNext.resize(256);
+        for (size_t v = 0; v < 256; v++)
+        {
+            lfsr_t state(lfsr);
+            state.data = 0;
+            uint64_t out = 0;
+            for (size_t k = 0; k < 8; k++)
+            {
+                out |= uint64_t(stepBit(state, mode, (v >> k) & 0x1)) << k;
+            }
+            _inputOut[v] = out;
+            _inputNext[v] = uint64_t(state.data) & _stateMask;
+        }
+    }
+
+    //! Scramble num bits, one bit per byte, and advance the lfsr state
+    void process(lfsr_t &lfsr, const unsigned char *in, unsigned char *out, const size_t num) const
+    {
+        size_t i = 0;
+
+        //A seed wider than the degree makes GLFSR_next() non-linear:
+        //step bit serial until the extra bits shift out, which may take the whole call.
+        if (_numSlices != 0) for (; i < num and (uint64_t(lfsr.data) & ~_stateMask) != 0; i++)
+        {
+            out[i] = stepBit(lfsr, _mode, in[i] & 0x1);
+        }
+
+        if (_numSlices != 0 and i < num)
+        {
+            uint64_t state = uint64_t(lfsr.data);
+            if (_mode == ADDITIVE) for (; i+64 <= num; i += 64)
+            {
+                uint64_t keystream = 0;
+                state = this->advance(state, keystream);
+                for (size_t j = 0; j < 64; j += 8)
+                {
+                    uint64_t bits;
+                    std::memcpy(&bits, in+i+j, sizeof(bits));
+                    bits = (bits & lowBits()) ^ expand(keystream >> j);
+                    std::memcpy(out+i+j, &bits, sizeof(bits));
+                }
+            }
+            else for (; i+8 <= num; i += 8)
+            {
+                unsigned inBits = 0;
+                for (size_t j = 0; j < 8; j++) inBits |= unsigned(in[i+j] & 0x1) << j;
+                uint64_t outBits = _inputOut[inBits];
+                state = this->advance(state, outBits) ^ _inputNext[inBits];
+                const uint64_t bits = expand(outBits);
+                std::memcpy(out+i, &bits, sizeof(bits));
+            }
+            lfsr.data = lfsr_data_t(state);
+        }
+
+        //bit serial tail and fallback
+        for (; i < num; i++) out[i] = stepBit(lfsr, _mode, in[i] & 0x1);
+    }
+
+    /*!
+     * Scramble num bytes of packed bits, 8 bits per byte, and advance the lfsr state.
+     * The bits of each byte are in time order from the LSB, or from the MSB when msbFirst.
+     */
+    void processPacked(lfsr_t &lfsr, const unsigned char *in, unsigned char *out, const size_t num, const bool msbFirst) const
+    {
+        size_t i = 0;
+
+        //bit serial while the seed is wider than the degree, see process()
+        if (_numSlices != 0) for (; i < num and (uint64_t(lfsr.data) & ~_stateMask) != 0; i++)
+        {
+            out[i] = this->stepByte(lfsr, in[i], msbFirst);
+        }
+
+        if (_numSlices != 0 and i < num)
+        {
+            uint64_t state = uint64_t(lfsr.data);
+            if (_mode == ADDITIVE) for (; i+8 <= num; i += 8)
+            {
+                uint64_t keystream = 0;
+                state = this->advance(state, keystream);
+                for (size_t j = 0; j < 8; j++)
+                {
+                    out[i+j] = in[i+j] ^ order((keystream >> (8*j)) & 0xff, msbFirst);
+                }
+            }
+            else for (; i < num; i++)
+            {
+                const unsigned inBits = order(in[i], msbFirst);
+                uint64_t outBits = _inputOut[inBits];
+                state = this->advance(state, outBits) ^ _inputNext[inBits];
+                out[i] = order((unsigned char)(outBits), msbFirst);
+            }
+            lfsr.data = lfsr_data_t(state);
+        }
+
+        //bit serial tail and fallback
+        for (; i < num; i++) out[i] = this->stepByte(lfsr, in[i], msbFirst);
+    }
+
+private:
+    //! Scramble the 8 bits of one packed byte bit serially
+    unsigned char stepByte(lfsr_t &lfsr, const unsigned char in, const bool msbFirst) const
+    {
+        const unsigned inBits = order(in, msbFirst);
+        unsigned outBits = 0;
+        for (size_t j = 0; j < 8; j++) outBits |= unsigned(stepBit(lfsr, _mode, (inBits >> j) & 0x1)) << j;
+        return order((unsigned char)(outBits), msbFirst);
+    }
+
+    //! Convert between a packed byte and its bits in time order from the LSB
+    static unsigned char order(const unsigned char byte, const bool msbFirst)
+    {
+        static const std::vector<unsigned char> reverse = []{
+            std::vector<unsigned char> t(256);
+            for (size_t v = 0; v < 256; v++)
+            {
+                for (size_t j = 0; j < 8; j++) t[v] |= ((v >> j) & 0x1) << (7-j);
+            }
+            return t;
+        }();
+        return msbFirst?reverse[byte]:byte;
+    }
+
+    //! Advance the state by one table step and XOR the step outputs into out
+    uint64_t advance(const uint64_t state, uint64_t &out) const
+    {
+        uint64_t next = 0;
+        for (size_t b = 0; b < _numSlices; b++)
+        {
+            const size_t v = b*256 + ((state >> (8*b)) & 0xff);
+            out ^= _stateOut[v];
+            next ^= _stateNext[v];
+        }
+        return next;
+    }
+
+    //! The low bit of each byte in a word
+    static uint64_t lowBits(void)
+    {
+        return 0x0101010101010101ull;
+    }
+
+    //! Expand the low 8 bits into a word of 8 bytes, one bit per byte in memory order
+    static uint64_t expand(const uint64_t bits)
+    {
+        static const std::vector<uint64_t> table = []{
+            std::vector<uint64_t> t(256);
+            for (size_t v = 0; v < 256; v++)
+            {
+                unsigned char bytes[8];
+                for (size_t j = 0; j < 8; j++) bytes[j] = (v >> j) & 0x1;
+                std::memcpy(&t[v], bytes, sizeof(bytes));
+            }
+            return t;
+        }();
+        return table[bits & 0xff];
+    }
+
+    Mode _mode;
+    size_t _numSlices; //state bytes, zero for the bit serial path
+    uint64_t _stateMask;
+    std::vector<uint64_t> _stateOut;
+    std::vector<uint64_t> _stateNext;
+    std::vector<uint64_t> _inputOut;
+    std::vector<uint64_t> _inputNext;
+};
@@ -0,0 +1,283 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Exception.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm> //min/max/swap
+
+//provide __popcnt64()
+#ifdef _MSC_VER
+#  include <intrin.h>
+#elif __GNUC__
+#  define __popcnt64 __builtin_popcountll
+#else
+#  error "provide __popcnt64() for this compiler"
+#endif
+
+/***********************************************************************
+ * LDPC code with a quasi-cyclic parity-check matrix
+ *
+ * The parity-check matrix H is made of Z x Z blocks, where each non-zero
+ * block is a cyclically shifted identity matrix: row r of the block has
+ * a 1 in column (r+shift)%Z. Each row of blocks is a layer of Z checks,
+ * and no two checks of a layer share a bit, so a decoder can update
+ * all of the checks of a layer in parallel. Codes from alist files have Z = 1.
+ *
+ * The built-in codes pothos_qc<N>_<rate> have 24 columns of blocks with Z = N/24.
+ * The parity part is dual-diagonal like the IEEE 802.11n codes,
+ * and the information columns have weight 3 with shifts that are generated
+ * from a fixed seed without 4-cycles. They are not the 802.11n base matrices.
+ *
+ * The systematic encoder comes from Gaussian elimination of H, from the last
+ * column to the first. The information bits go to the columns without a pivot,
+ * which are the first K columns of a full rank H with an invertible parity part.
+ * Each parity bit is the parity of a masked set of the packed information bits.
+ **********************************************************************/
+struct LdpcCode
+{
+    //! One non-zero block of H: the block column and the cyclic shift
+    struct Block
+    {
+        size_t col;
+        size_t shift;
+    };
+
+    LdpcCode(void):
+        Z(0),
+        N(0),
+        K(0),
+        genWords(0)
+    {
+        this->setup("LdpcCode()", "pothos_qc648_1/2");
+    }
+
+    //! Load a built-in code by name, or else the parity-check matrix of an alist file
+    void setup(const std::string &what, const std::string &name)
+    {
+        std::vector<std::vector<Block>> newLayers;
+        size_t z = 0, n = 0;
+        if (not builtin(name, newLayers, z, n)) readAlist(what, name, newLayers, z, n);
+        layers = newLayers;
+        Z = z;
+        N = n;
+        this->eliminate();
+    }
+
+    //! Encode K information bits into N codeword bits, one bit per byte
+    void encode(const uint8_t *info, uint8_t *codeword) const
+    {
+        std::vector<uint64_t> packed(genWords, 0);
+        for (size_t k = 0; k < K; k++)
+        {
+            const uint64_t bit = info[k] & 0x1;
+            codeword[infoCols[k]] = uint8_t(bit);
+            packed[k/64] |= bit << (k%64);
+        }
+        const uint64_t *row = parityGen.data();
+        for (size_t i = 0; i < parityCols.size(); i++, row += genWords)
+        {
+            uint64_t x = 0;
+            for (size_t w = 0; w < genWords; w++) x ^= row[w] & packed[w];
+            codeword[parityCols[i]] = uint8_t(__popcnt64(x) & 0x1);
+        }
+    }
+
+    size_t Z; //block size
+    size_t N; //codeword bits
+    size_t K; //information bits
+    std::vector<std::vector<Block>> layers;
+    std::vector<size_t> infoCols; //codeword position of each information bit
+    std::vector<size_t> parityCols; //codeword position of each parity bit
+    std::vector<uint64_t> parityGen; //information bit mask of each parity bit
+    size_t genWords; //words per mask
+
+private:
+    static bool builtin(const std::string &name, std::vector<std::vector<Block>> &layers, size_t &z, size_t &n)
+    {
+        static const char *rates[] = {"1/2", "2/3", "3/4", "5/6"};
+        static const size_t rowBlocks[] = {12, 8, 6, 4};
+        for (const size_t length : {648, 1296, 1944})
+        {
+            for (size_t r = 0; r < 4; r++)
+            {
+                if (name != "pothos_qc" + std::to_string(length) + "_" + rates[r]) continue;
+                z = length/24;
+                n = length;
+                layers = generate(z, 24, rowBlocks[r]);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //! Generate a base matrix of shifts, -1 for a zero block, and convert it to layers
+    static std::vector<std::vector<Block>> generate(const size_t z, const size_t nb, const size_t mb)
+    {
+        const size_t kb = nb - mb;
+        std::vector<std::vector<int>> base(mb, std::vector<int>(nb, -1));
+
+        //dual-diagonal parity part
+        base[0][kb] = 1;
+        base[mb/2][kb] = 0;
+        base[mb-1][kb] = 1;
+        for (size_t j = 0; j+1 < mb; j++) base[j][kb+1+j] = base[j+1][kb+1+j] = 0;
+
+        uint32_t seed = uint32_t(z*nb*mb);
+        auto random = [&seed](const size_t bound)
+        {
+            seed = seed*1664525u + 1013904223u;
+            return size_t(seed >> 8) % bound;
+        };
+
+        std::vector<size_t> rowWeight(mb, 0);
+        for (size_t i = 0; i < mb; i++)
+        {
+            for (size_t j = kb; j < nb; j++) if (base[i][j] >= 0) rowWeight[i]++;
+        }
+
+        for (size_t c = 0; c < kb; c++)
+        {
+            for (size_t w = 0; w < 3; w++)
+            {
+                //the least used row that is not yet in this column, random among ties
+                std::vector<size_t> rows;
+                for (size_t i = 0; i < mb; i++)
+                {
+                    if (base[i][c] >= 0) continue;
+                    if (not rows.empty() and rowWeight[i] < rowWeight[rows.front()]) rows.clear();
+                    if (rows.empty() or rowWeight[i] == rowWeight[rows.front()]) rows.push_back(i);
+                }
+                const size_t i = rows[random(rows.size())];
+
+                //a shift that does not close a 4-cycle with the rows already in this column
+                int shift = -1;
+                for (size_t attempt = 0; attempt < 64 and shift < 0; attempt++)
+                {
+                    const int s = int(random(z));
+                    if (not closesCycle(base, i, c, s, int(z))) shift = s;
+                }
+                if (shift < 0) throw Pothos::AssertionViolationException(
+                    "LdpcCode::generate()", "no shift without a 4-cycle for column " + std::to_string(c));
+                base[i][c] = shift;
+                rowWeight[i]++;
+            }
+        }
+
+        std::vector<std::vector<Block>> layers(mb);
+        for (size_t i = 0; i < mb; i++)
+        {
+            for (size_t j = 0; j < nb; j++)
+            {
+                if (base[i][j] >= 0) layers[i].push_back(Block{j, size_t(base[i][j])});
+            }
+        }
+        return layers;
+    }
+
+    static bool closesCycle(const std::vector<std::vector<int>> &base, const size_t i, const size_t a, const int shift, const int z)
+    {
+        for (size_t j = 0; j < base.size(); j++)
+        {
+            if (j == i or base[j][a] < 0) continue;
+            for (size_t b = 0; b < base[i].size(); b++)
+            {
+                if (b == a or base[i][b] < 0 or base[j][b] < 0) continue;
+                const int d = shift - base[i][b] + base[j][b] - base[j][a];
+                if (((d % z) + z) % z == 0) return true;
+            }
+        }
+        return false;
+    }
+
+    //! Read the columns of an alist file, each check is a layer with Z = 1
+    static void readAlist(const std::string &what, const std::string &path, std::vector<std::vector<Block>> &layers, size_t &z, size_t &n)
+    {
+        std::ifstream file(path);
+        if (not file) throw Pothos::InvalidArgumentException(what, "Unknown code or unreadable alist file: " + path);
+
+        size_t m = 0, maxColWeight = 0, maxRowWeight = 0;
+        file >> n >> m >> maxColWeight >> maxRowWeight;
+        std::vector<size_t> colWeights(n);
+        for (auto &weight : colWeights) file >> weight;
+        for (size_t i = 0; i < m; i++) file >> maxRowWeight; //row weights follow from the columns
+        if (not file or n == 0 or m == 0 or m >= n) throw Pothos::InvalidArgumentException(what, "Bad alist header: " + path);
+
+        //the column lists may be padded with zeros to the largest weight
+        layers.assign(m, std::vector<Block>());
+        for (size_t j = 0; j < n; j++)
+        {
+            for (size_t w = 0; w < colWeights[j];)
+            {
+                size_t row = 0;
+                if (not (file >> row)) throw Pothos::InvalidArgumentException(what, "Truncated alist file: " + path);
+                if (row == 0) continue;
+                if (row > m) throw Pothos::InvalidArgumentException(what, "Row index out of range in alist file: " + path);
+                layers[row-1].push_back(Block{j, 0});
+                w++;
+            }
+        }
+        z = 1;
+    }
+
+    //! Gaussian elimination of H into the systematic encoder
+    void eliminate(void)
+    {
+        const size_t M = layers.size()*Z;
+        const size_t W = (N+63)/64;
+        std::vector<uint64_t> h(M*W, 0);
+        for (size_t l = 0; l < layers.size(); l++)
+        {
+            for (const auto &block : layers[l])
+            {
+                for (size_t r = 0; r < Z; r++)
+                {
+                    const size_t col = block.col*Z + (r + block.shift)%Z;
+                    h[(l*Z + r)*W + col/64] ^= uint64_t(1) << (col%64);
+                }
+            }
+        }
+
+        //reduced row echelon form with pivots from the last column
+        std::vector<bool> isPivot(N, false);
+        parityCols.clear();
+        size_t rank = 0;
+        for (size_t c = N; c-- > 0 and rank < M;)
+        {
+            const uint64_t mask = uint64_t(1) << (c%64);
+            size_t r = rank;
+            while (r < M and (h[r*W + c/64] & mask) == 0) r++;
+            if (r == M) continue;
+            std::swap_ranges(h.begin() + r*W, h.begin() + (r+1)*W, h.begin() + rank*W);
+            const uint64_t *pivot = h.data() + rank*W;
+            for (size_t i = 0; i < M; i++)
+            {
+                if (i == rank or (h[i*W + c/64] & mask) == 0) continue;
+                for (size_t w = 0; w < W; w++) h[i*W + w] ^= pivot[w];
+            }
+            isPivot[c] = true;
+            parityCols.push_back(c);
+            rank++;
+        }
+
+        infoCols.clear();
+        for (size_t c = 0; c < N; c++) if (not isPivot[c]) infoCols.push_back(c);
+        K = infoCols.size();
+
+        //each pivot row gives its parity bit from the information bits
+        genWords = (K+63)/64;
+        parityGen.assign(rank*genWords, 0);
+        for (size_t i = 0; i < rank; i++)
+        {
+            for (size_t k = 0; k < K; k++)
+            {
+                const size_t c = infoCols[k];
+                if ((h[i*W + c/64] >> (c%64)) & 0x1) parityGen[i*genWords + k/64] |= uint64_t(1) << (k%64);
+            }
+        }
+    }
+};
@@ -0,0 +1,471 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "LdpcCode.hpp"
+#include "common/CpuFeatures.hpp"
+#include "common/FrameBlock.hpp"
+#include <Pothos/Framework.hpp>
+#include <cstdint>
+#include <cstdlib> //abs
+#include <cstring> //memcpy
+#include <cmath> //round
+#include <vector>
+#include <algorithm> //min/max
+
+/***********************************************************************
+ * |PothosDoc LDPC Decoder
+ *
+ * Decode frames of soft bits from the LDPC Encoder block
+ * with layered offset min-sum belief propagation.
+ * The code must match the encoder. The output carries one bit per byte in the LSB.
+ *
+ * The input is log-likelihood ratios, where a positive LLR means that the bit
+ * is more likely a 0, like the output of the Soft Demapper block:
+ * <ul>
+ * <li>float32 - LLRs that are multiplied by the input scale and saturated to [-127, 127].</li>
+ * <li>int8 - LLRs already scaled to [-127, 127].</li>
+ * </ul>
+ *
+ * Each frame is split into codewords of N bits, where the last codeword
+ * may be shortened like the encoder does, and the decoded frame holds
+ * the information bits. The decoder stops iterating on a codeword once
+ * all parity checks are satisfied. When a codeword still fails the parity checks
+ * after the maximum number of iterations, the whole frame is dropped
+ * and the error count is incremented.
+ *
+ * The channel LLRs and the check node messages are 8-bit integers.
+ * The posteriors are 16-bit integers with room for the messages of every check,
+ * so that taking a message out of a posterior restores the extrinsic exactly,
+ * and a saturated wrong channel LLR can still be flipped by the checks.
+ * A layer is a row of Z x Z blocks in the quasi-cyclic parity-check matrix,
+ * and the Z checks of a layer are updated together as vector lanes,
+ * with AVX2 selected at runtime on x86-64.
+ *
+ * <h2>Frames</h2>
+ * Input port 0 accepts packets, and the decoded packets keep the metadata of the input packets.
+ * Input port 0 also accepts a stream where each frame begins
+ * at the frame start label, labeled like bursts in the FIR Filter block and Frame Sync:
+ * the frame start label holds the frame length, or the frame ends at the frame end label.
+ * Decoded frames are posted with frame start and frame end labels
+ * that hold the decoded frame length.
+ * Elements outside of a frame and the other labels are dropped.
+ *
+ * |category /Digital
+ * |category /Coding
+ * |keywords ldpc decoder fec forward error correction min-sum belief propagation llr
+ *
+ * |param dtype[Data Type] The type of the soft bit input.
+ * |option [Float32 LLRs] "float32"
+ * |option [Int8 LLRs] "int8"
+ * |default "float32"
+ * |preview disable
+ *
+ * |param code[Code] The name of a built-in code or the path of an alist file.
+ * See the LDPC Encoder block for the built-in codes.
+ * |option [N=648 rate 1/2] "pothos_qc648_1/2"
+ * |option [N=648 rate 2/3] "pothos_qc648_2/3"
+ * |option [N=648 rate 3/4] "pothos_qc648_3/4"
+ * |option [N=648 rate 5/6] "pothos_qc648_5/6"
+ * |option [N=1296 rate 1/2] "pothos_qc1296_1/2"
+ * |option [N=1296 rate 2/3] "pothos_qc1296_2/3"
+ * |option [N=1296 rate 3/4] "pothos_qc1296_3/4"
+ * |option [N=1296 rate 5/6] "pothos_qc1296_5/6"
+ * |option [N=1944 rate 1/2] "pothos_qc1944_1/2"
+ * |option [N=1944 rate 2/3] "pothos_qc1944_2/3"
+ * |option [N=1944 rate 3/4] "pothos_qc1944_3/4"
+ * |option [N=1944 rate 5/6] "pothos_qc1944_5/6"
+ * |default "pothos_qc648_1/2"
+ * |widget ComboBox(editable=true)
+ *
+ * |param iterations[Max Iterations] The maximum number of iterations per codeword.
+ * |default 20
+ * |widget SpinBox(minimum=1)
+ * |preview valid
+ *
+ * |param offset[Offset] The offset subtracted from the check node messages in 8-bit LLR units.
+ * |default 2
+ * |widget SpinBox(minimum=0, maximum=127)
+ * |preview valid
+ *
+ * |param scale[Input Scale] A factor applied to float32 LLRs before they are saturated to 8 bits.
+ * |default 4.0
+ * |preview valid
+ *
+ * |param frameStartId[Frame Start ID] The label ID that marks the first soft bit of a frame.
+ * |default "frameStart"
+ * |widget StringEntry()
+ *
+ * |param frameEndId[Frame End ID] The label ID that marks the last soft bit of a frame.
+ * The frame end label is only needed when the frame start label has no length.
+ * |default ""
+ * |widget StringEntry()
+ * |preview valid
+ *
+ * |factory /comms/ldpc_decoder(dtype)
+ * |setter setCode(code)
+ * |setter setMaxIterations(iterations)
+ * |setter setOffset(offset)
+ * |setter setInputScale(scale)
+ * |setter setFrameStartId(frameStartId)
+ * |setter setFrameEndId(frameEndId)
+ **********************************************************************/
+
+/***********************************************************************
+ * Check node update of one layer
+ *
+ * The deg rows of t hold the posterior LLRs of the bits of each block,
+ * rotated so that lane r is the bit of check r. The rows of R hold the
+ * previous check to bit messages of the layer. Each lane computes the
+ * extrinsic q = t - R, the new message from the two smallest |q|
+ * limited to 127 and the product of signs, and the new posterior q + R.
+ **********************************************************************/
+static inline int16_t saturate16(const int x)
+{
+    return int16_t(std::max(-32767, std::min(32767, x)));
+}
+
+static inline void checkLayerScalar(int16_t *t, int8_t *R, const size_t deg, const size_t lanes, const int offset, int8_t *min1, int8_t *min2, uint8_t *idx, int8_t *sgn)
+{
+    std::fill(min1, min1+lanes, 127);
+    std::fill(min2, min2+lanes, 127);
+    std::fill(idx, idx+lanes, 0);
+    std::fill(sgn, sgn+lanes, 0);
+    for (size_t e = 0; e < deg; e++)
+    {
+        int16_t *te = t + e*lanes;
+        const int8_t *Re = R + e*lanes;
+        for (size_t r = 0; r < lanes; r++)
+        {
+            const int16_t q = saturate16(te[r] - Re[r]);
+            const int8_t a = int8_t(std::min(127, std::abs(int(q))));
+            te[r] = q;
+            if (q < 0) sgn[r] = ~sgn[r];
+            if (a < min1[r]) idx[r] = uint8_t(e);
+            min2[r] = std::min(min2[r], std::max(min1[r], a));
+            min1[r] = std::min(min1[r], a);
+        }
+    }
+    for (size_t r = 0; r < lanes; r++)
+    {
+        min1[r] = int8_t(std::max(0, min1[r] - offset));
+        min2[r] = int8_t(std::max(0, min2[r] - offset));
+    }
+    for (size_t e = 0; e < deg; e++)
+    {
+        int16_t *te = t + e*lanes;
+        int8_t *Re = R + e*lanes;
+        for (size_t r = 0; r < lanes; r++)
+        {
+            const int8_t m = (idx[r] == e)?min2[r]:min1[r];
+            Re[r] = ((sgn[r] < 0) != (te[r] < 0))?-m:m;
+            te[r] = saturate16(te[r] + Re[r]);
+        }
+    }
+}
+
+#ifdef CPU_FEATURES_X86
+
+//! The same update for lanes a multiple of 16
+__attribute__((target("avx2")))
+static void checkLayerAVX2(int16_t *t, int8_t *R, const size_t deg, const size_t lanes, const int offset)
+{
+    const __m256i appMin = _mm256_set1_epi16(-32767);
+    const __m256i llrMax = _mm256_set1_epi16(127);
+    const __m256i off = _mm256_set1_epi16(short(offset));
+    const __m256i one = _mm256_set1_epi16(1);
+    for (size_t r = 0; r < lanes; r += 16)
+    {
+        __m256i min1 = llrMax, min2 = llrMax;
+        __m256i idx = _mm256_setzero_si256(), sgn = _mm256_setzero_si256();
+        for (size_t e = 0; e < deg; e++)
+        {
+            __m256i *te = (__m256i *)(t + e*lanes + r);
+            const __m256i Re = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(R + e*lanes + r)));
+            const __m256i q = _mm256_max_epi16(_mm256_subs_epi16(_mm256_loadu_si256(te), Re), appMin);
+            const __m256i a = _mm256_min_epi16(_mm256_abs_epi16(q), llrMax);
+            _mm256_storeu_si256(te, q);
+            sgn = _mm256_xor_si256(sgn, q);
+            idx = _mm256_blendv_epi8(idx, _mm256_set1_epi16(short(e)), _mm256_cmpgt_epi16(min1, a));
+            min2 = _mm256_min_epi16(min2, _mm256_max_epi16(min1, a));
+            min1 = _mm256_min_epi16(min1, a);
+        }
+        min1 = _mm256_subs_epu16(min1, off);
+        min2 = _mm256_subs_epu16(min2, off);
+        for (size_t e = 0; e < deg; e++)
+        {
+            __m256i *te = (__m256i *)(t + e*lanes + r);
+            const __m256i q = _mm256_loadu_si256(te);
+            const __m256i m = _mm256_blendv_epi8(min1, min2, _mm256_cmpeq_epi16(idx, _mm256_set1_epi16(short(e))));
+            //the sign of the other messages, or'd with 1 so that a zero q keeps the sign
+            const __m256i msg = _mm256_sign_epi16(m, _mm256_or_si256(_mm256_xor_si256(sgn, q), one));
+            const __m128i msg8 = _mm_packs_epi16(_mm256_castsi256_si128(msg), _mm256_extracti128_si256(msg, 1));
+            _mm_storeu_si128((__m128i *)(R + e*lanes + r), msg8);
+            _mm256_storeu_si256(te, _mm256_max_epi16(_mm256_adds_epi16(q, msg), appMin));
+        }
+    }
+}
+
+#endif //CPU_FEATURES_X86
+
+//! Convert the input to an 8-bit soft bit
+static inline int8_t softBit(const float x, const float scale)
+{
+    return int8_t(std::round(std::max(-127.0f, std::min(127.0f, x*scale))));
+}
+
+static inline int8_t softBit(const int8_t x, const float)
+{
+    return std::max<int8_t>(x, -127);
+}
+
+/***********************************************************************
+ * LDPC decoder block
+ **********************************************************************/
+template <typename Type>
+class LdpcDecoder : public FrameBlock
+{
+public:
+    LdpcDecoder(void):
+        FrameBlock(typeid(Type), typeid(unsigned char)),
+        _name("pothos_qc648_1/2"),
+        _maxIterations(20),
+        _offset(2),
+        _scale(4.0f),
+        _lanes(0),
+        _iterationCount(0),
+        _errorCount(0)
+    {
+        this->registerCall(this, POTHOS_FCN_TUPLE(LdpcDecoder, setCode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LdpcDecoder, getCode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LdpcDecoder, setMaxIterations));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LdpcDecoder, getMaxIterations));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LdpcDecoder, setOffset));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LdpcDecoder, getOffset));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LdpcDecoder, setInputScale));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LdpcDecoder, getInputScale));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LdpcDecoder, getIterationCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LdpcDecoder, getErrorCount));
+        this->registerProbe("getIterationCount");
+        this->registerProbe("getErrorCount");
+        this->updateCode(); //initial update
+    }
+
+    void setCode(const std::string &name)
+    {
+        _code.setup("LdpcDecoder::setCode()", name);
+        _name = name;
+        this->updateCode();
+    }
+
+    std::string getCode(void) const
+    {
+        return _name;
+    }
+
+    void setMaxIterations(const size_t iterations)
+    {
+        if (iterations == 0) throw Pothos::InvalidArgumentException("LdpcDecoder::setMaxIterations()", "Iterations cannot be 0");
+        _maxIterations = iterations;
+    }
+
+    size_t getMaxIterations(void) const
+    {
+        return _maxIterations;
+    }
+
+    void setOffset(const int offset)
+    {
+        if (offset < 0 or offset > 127) throw Pothos::InvalidArgumentException("LdpcDecoder::setOffset()", "Offset out of range");
+        _offset = offset;
+    }
+
+    int getOffset(void) const
+    {
+        return _offset;
+    }
+
+    void setInputScale(const float scale)
+    {
+        _scale = scale;
+    }
+
+    float getInputScale(void) const
+    {
+        return _scale;
+    }
+
+    //! The total number of iterations over all codewords
+    unsigned long long getIterationCount(void) const
+    {
+        return _iterationCount;
+    }
+
+    //! The number of frames dropped for codewords that failed the parity checks
+    unsigned long long getErrorCount(void) const
+    {
+        return _errorCount;
+    }
+
+protected:
+    bool processFrame(const Pothos::BufferChunk &in, Pothos::BufferChunk &out)
+    {
+        const size_t len = in.length/sizeof(Type);
+        if (len == 0) return false;
+
+        //the last codeword must hold more than the parity bits
+        const size_t N = _code.N, K = _code.K;
+        const size_t numCodewords = (len + N - 1)/N;
+        const size_t last = len - (numCodewords-1)*N;
+        if (last <= N-K)
+        {
+            _errorCount++;
+            return false;
+        }
+        out = Pothos::BufferChunk(this->outType(), len - numCodewords*(N-K));
+
+        const Type *soft = in.as<const Type *>();
+        uint8_t *bits = out.as<uint8_t *>();
+        for (size_t i = 0; i < len; i += N)
+        {
+            //the shortened information bits are certain zeros
+            const size_t n = std::min(N, len - i);
+            const size_t numInfo = K - (N - n);
+            std::fill(_shortened.begin(), _shortened.end(), false);
+            for (size_t k = numInfo; k < K; k++) _shortened[_code.infoCols[k]] = true;
+            const Type *s = soft + i;
+            for (size_t j = 0; j < N; j++) _llrs[j] = _shortened[j]?127:softBit(*s++, _scale);
+
+            if (not this->decode())
+            {
+                _errorCount++;
+                return false;
+            }
+            for (size_t k = 0; k < numInfo; k++)
+            {
+                const size_t p = _code.infoCols[k];
+                *bits++ = (_app[(p/_code.Z)*_lanes + p%_code.Z] < 0)?1:0;
+            }
+        }
+        return true;
+    }
+
+private:
+    void updateCode(void)
+    {
+        //pad the lanes of larger blocks to the vector size
+        const size_t Z = _code.Z;
+        _lanes = (Z >= 16)?((Z+31)/32)*32:Z;
+        size_t numBlocks = 0, maxDeg = 0;
+        for (const auto &layer : _code.layers)
+        {
+            numBlocks += layer.size();
+            maxDeg = std::max(maxDeg, layer.size());
+        }
+        _app.assign((_code.N/Z)*_lanes, 0);
+        _msgs.assign(numBlocks*_lanes, 0);
+        _tmp.assign(std::max<size_t>(maxDeg, 2)*_lanes, 0);
+        _min1.resize(_lanes);
+        _min2.resize(_lanes);
+        _idx.resize(_lanes);
+        _sgn.resize(_lanes);
+        _llrs.resize(_code.N);
+        _shortened.resize(_code.N);
+    }
+
+    //! Decode the codeword in _llrs into the posteriors in _app, return true on success
+    bool decode(void)
+    {
+        const size_t Z = _code.Z;
+        for (size_t c = 0; c < _code.N/Z; c++)
+        {
+            std::copy(_llrs.begin() + c*Z, _llrs.begin() + (c+1)*Z, _app.begin() + c*_lanes);
+        }
+        std::fill(_msgs.begin(), _msgs.end(), 0);
+
+        for (size_t it = 0; it < _maxIterations; it++)
+        {
+            _iterationCount++;
+            int8_t *R = _msgs.data();
+            for (const auto &layer : _code.layers)
+            {
+                const size_t deg = layer.size();
+                for (size_t e = 0; e < deg; e++) this->gather(layer[e], _tmp.data() + e*_lanes);
+                #ifdef CPU_FEATURES_X86
+                if ((_lanes % 16) == 0 and CpuFeatures::avx2()) checkLayerAVX2(_tmp.data(), R, deg, _lanes, _offset);
+                else
+                #endif
+                checkLayerScalar(_tmp.data(), R, deg, _lanes, _offset, _min1.data(), _min2.data(), _idx.data(), _sgn.data());
+                for (size_t e = 0; e < deg; e++) this->scatter(layer[e], _tmp.data() + e*_lanes);
+                R += deg*_lanes;
+            }
+            if (this->checksPass()) return true;
+        }
+        return false;
+    }
+
+    //! Rotate the posteriors of a block so that lane r holds the bit of check r
+    void gather(const LdpcCode::Block &block, int16_t *t) const
+    {
+        const size_t Z = _code.Z, s = block.shift;
+        const int16_t *app = _app.data() + block.col*_lanes;
+        std::memcpy(t, app + s, (Z - s)*sizeof(int16_t));
+        std::memcpy(t + Z - s, app, s*sizeof(int16_t));
+    }
+
+    void scatter(const LdpcCode::Block &block, const int16_t *t)
+    {
+        const size_t Z = _code.Z, s = block.shift;
+        int16_t *app = _app.data() + block.col*_lanes;
+        std::memcpy(app + s, t, (Z - s)*sizeof(int16_t));
+        std::memcpy(app, t + Z - s, s*sizeof(int16_t));
+    }
+
+    //! The sign bits of the posteriors satisfy every check
+    bool checksPass(void)
+    {
+        int16_t *acc = _tmp.data();
+        int16_t *t = _tmp.data() + _lanes;
+        for (const auto &layer : _code.layers)
+        {
+            std::fill(acc, acc + _lanes, 0);
+            for (const auto &block : layer)
+            {
+                this->gather(block, t);
+                for (size_t r = 0; r < _lanes; r++) acc[r] ^= t[r];
+            }
+            int16_t any = 0;
+            for (size_t r = 0; r < _code.Z; r++) any |= acc[r];
+            if (any < 0) return false;
+        }
+        return true;
+    }
+
+    LdpcCode _code;
+    std::string _name;
+    size_t _maxIterations;
+    int _offset;
+    float _scale;
+    size_t _lanes; //vector lanes per block
+    std::vector<int16_t> _app; //posterior LLR of each bit, in blocks of lanes
+    std::vector<int8_t> _msgs; //check to bit messages of each block of every layer
+    std::vector<int16_t> _tmp; //rotated posteriors of a layer
+    std::vector<int8_t> _min1, _min2, _sgn;
+    std::vector<uint8_t> _idx;
+    std::vector<int8_t> _llrs;
+    std::vector<bool> _shortened;
+    unsigned long long _iterationCount;
+    unsigned long long _errorCount;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *LdpcDecoderFactory(const Pothos::DType &dtype)
+{
+    if (dtype == Pothos::DType(typeid(float))) return new LdpcDecoder<float>();
+    if (dtype == Pothos::DType(typeid(int8_t))) return new LdpcDecoder<int8_t>();
+    throw Pothos::InvalidArgumentException("LdpcDecoderFactory("+dtype.toString()+")", "unsupported type");
+}
+
+static Pothos::BlockRegistry registerLdpcDecoder(
+    "/comms/ldpc_decoder", &LdpcDecoderFactory);
@@ -0,0 +1,139 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "LdpcCode.hpp"
+#include "common/FrameBlock.hpp"
+#include <Pothos/Framework.hpp>
+#include <cstdint>
+#include <vector>
+#include <algorithm> //min/max
+
+/***********************************************************************
+ * |PothosDoc LDPC Encoder
+ *
+ * Encode frames of bits with a low-density parity-check code.
+ * The input and output carry one bit per byte in the LSB.
+ * Use the LDPC Decoder block with the same code to decode.
+ *
+ * Each frame is split into codewords of K information bits,
+ * and each codeword is output as the N bits in the order of the parity-check matrix.
+ * The last codeword of a frame is shortened when the frame length
+ * is not a multiple of K: the missing information bits are zeros that are not sent.
+ * A frame of L bits becomes L + ceil(L/K)*(N-K) bits.
+ *
+ * <h2>Codes</h2>
+ * The built-in quasi-cyclic codes are named pothos_qc&lt;N&gt;_&lt;rate&gt;
+ * for N of 648, 1296 and 1944 bits and rates 1/2, 2/3, 3/4 and 5/6.
+ * They have the block structure and dual-diagonal parity part of the IEEE 802.11n codes,
+ * but their own shift values, so they do not interoperate with 802.11n;
+ * the information bits are the first K bits of a codeword.
+ * Any other code name is the path of an alist file with the parity-check matrix.
+ * The encoder is derived from the parity-check matrix when the code is set.
+ *
+ * <h2>Frames</h2>
+ * Input port 0 accepts packets, and the encoded packets keep the metadata of the input packets.
+ * Input port 0 also accepts a bit stream where each frame begins
+ * at the frame start label, labeled like bursts in the FIR Filter block:
+ * the frame start label holds the frame length, or the frame ends at the frame end label.
+ * Encoded frames are posted with frame start and frame end labels
+ * that hold the encoded frame length.
+ * Bits outside of a frame and the other labels are dropped.
+ *
+ * |category /Digital
+ * |category /Coding
+ * |keywords ldpc encoder fec forward error correction parity check alist
+ *
+ * |param code[Code] The name of a built-in code or the path of an alist file.
+ * |option [N=648 rate 1/2] "pothos_qc648_1/2"
+ * |option [N=648 rate 2/3] "pothos_qc648_2/3"
+ * |option [N=648 rate 3/4] "pothos_qc648_3/4"
+ * |option [N=648 rate 5/6] "pothos_qc648_5/6"
+ * |option [N=1296 rate 1/2] "pothos_qc1296_1/2"
+ * |option [N=1296 rate 2/3] "pothos_qc1296_2/3"
+ * |option [N=1296 rate 3/4] "pothos_qc1296_3/4"
+ * |option [N=1296 rate 5/6] "pothos_qc1296_5/6"
+ * |option [N=1944 rate 1/2] "pothos_qc1944_1/2"
+ * |option [N=1944 rate 2/3] "pothos_qc1944_2/3"
+ * |option [N=1944 rate 3/4] "pothos_qc1944_3/4"
+ * |option [N=1944 rate 5/6] "pothos_qc1944_5/6"
+ * |default "pothos_qc648_1/2"
+ * |widget ComboBox(editable=true)
+ *
+ * |param frameStartId[Frame Start ID] The label ID that marks the first bit of a frame.
+ * |default "frameStart"
+ * |widget StringEntry()
+ *
+ * |param frameEndId[Frame End ID] The label ID that marks the last bit of a frame.
+ * The frame end label is only needed when the frame start label has no length.
+ * |default ""
+ * |widget StringEntry()
+ * |preview valid
+ *
+ * |factory /comms/ldpc_encoder()
+ * |setter setCode(code)
+ * |setter setFrameStartId(frameStartId)
+ * |setter setFrameEndId(frameEndId)
+ **********************************************************************/
+class LdpcEncoder : public FrameBlock
+{
+public:
+    static Block *make(void)
+    {
+        return new LdpcEncoder();
+    }
+
+    LdpcEncoder(void):
+        FrameBlock(typeid(unsigned char), typeid(unsigned char)),
+        _name("pothos_qc648_1/2")
+    {
+        this->registerCall(this, POTHOS_FCN_TUPLE(LdpcEncoder, setCode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LdpcEncoder, getCode));
+    }
+
+    void setCode(const std::string &name)
+    {
+        _code.setup("LdpcEncoder::setCode()", name);
+        _name = name;
+    }
+
+    std::string getCode(void) const
+    {
+        return _name;
+    }
+
+protected:
+    bool processFrame(const Pothos::BufferChunk &in, Pothos::BufferChunk &out)
+    {
+        const size_t len = in.length;
+        if (len == 0) return false;
+
+        const size_t N = _code.N, K = _code.K;
+        const size_t numCodewords = (len + K - 1)/K;
+        out = Pothos::BufferChunk(this->outType(), len + numCodewords*(N-K));
+
+        std::vector<uint8_t> info(K), codeword(N);
+        const uint8_t *bits = in.as<const uint8_t *>();
+        uint8_t *o = out.as<uint8_t *>();
+        for (size_t i = 0; i < len; i += K)
+        {
+            //the shortened information bits are zeros
+            const size_t n = std::min(K, len - i);
+            std::copy(bits + i, bits + i + n, info.begin());
+            std::fill(info.begin() + n, info.end(), 0);
+            _code.encode(info.data(), codeword.data());
+
+            //output all but the shortened positions
+            std::vector<bool> shortened(N, false);
+            for (size_t k = n; k < K; k++) shortened[_code.infoCols[k]] = true;
+            for (size_t j = 0; j < N; j++) if (not shortened[j]) *o++ = codeword[j];
+        }
+        return true;
+    }
+
+private:
+    LdpcCode _code;
+    std::string _name;
+};
+
+static Pothos::BlockRegistry registerLdpcEncoder(
+    "/comms/ldpc_encoder", &LdpcEncoder::make);
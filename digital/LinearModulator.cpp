@@ -0,0 +1,292 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "SymbolHelpers.hpp"
+#include <Pothos/Framework.hpp>
+#include <cstdint>
+#include <complex>
+#include <vector>
+#include <cmath> //log2
+#include <algorithm> //min/max/copy
+
+/***********************************************************************
+ * |PothosDoc Linear Modulator
+ *
+ * The linear modulator converts a stream of packed bytes into a
+ * pulse shaped stream of constellation samples. It combines the
+ * bytes to symbols, symbol mapper, and interpolating FIR filter blocks:
+ *
+ * <ol>
+ * <li>Each input byte is unpacked into symbols of log2(len(map)) bits.</li>
+ * <li>Each symbol indexes into the symbol map.</li>
+ * <li>The symbols are upsampled by the interpolation factor and
+ * convolved with the pulse shaping taps.</li>
+ * </ol>
+ *
+ * The upsampled stream has only one non-zero element per symbol,
+ * so each output sample is computed from the symbols alone with one
+ * phase of a polyphase filter: out[n*L + j] = sum_k taps[j + k*L] * sym[n-k].
+ * There is no intermediate stream of symbols between blocks.
+ *
+ * Labels on the input bytes are moved to the first output sample
+ * of the first symbol in the byte.
+ *
+ * |category /Digital
+ * |category /Modulation
+ * |keywords modulator pulse shaping constellation qam psk rrc
+ *
+ * |param dtype[Data Type] The output data type produced by the modulator.
+ * |widget DTypeChooser(float=1,cfloat=1)
+ * |default "complex_float32"
+ * |preview disable
+ *
+ * |param map[Symbol Map] The symbol map is a list of constellation points,
+ * in the same format as the symbol mapper.
+ * This must be a power-of-two in length; e.g. 2, 4, 8...
+ * |default [-1, 1]
+ * |option [BPSK] \[-1, 1\]
+ * |option [QPSK] \[-1.0-1.0*j, -1.0+1.0*j, 1.0+1.0*j, 1.0-1.0*j\]
+ * |widget ComboBox(editable=true)
+ *
+ * |param bitOrder[Bit Order] The bit order used to unpack symbols from the input bytes.
+ * |option [MSBit] "MSBit"
+ * |option [LSBit] "LSBit"
+ * |default "MSBit"
+ *
+ * |param interp[Samples per Symbol] The interpolation factor from symbols to output samples.
+ * |default 4
+ * |widget SpinBox(minimum=1)
+ *
+ * |param taps[Pulse Shape] The pulse shaping filter taps at the output sample rate.
+ * Use the FIR designer to create root raised cosine taps for example.
+ * |default [1.0]
+ *
+ * |factory /comms/linear_modulator(dtype)
+ * |setter setMap(map)
+ * |setter setBitOrder(bitOrder)
+ * |setter setInterpolation(interp)
+ * |setter setTaps(taps)
+ **********************************************************************/
+template <typename T>
+struct ModulatorTraits
+{
+    typedef T RealType;
+};
+
+template <typename T>
+struct ModulatorTraits<std::complex<T>>
+{
+    typedef T RealType;
+};
+
+template <typename Type>
+class LinearModulator : public Pothos::Block
+{
+    typedef typename ModulatorTraits<Type>::RealType RealType;
+
+public:
+    LinearModulator(void):
+        _order(MSBit),
+        _mod(1),
+        L(1),
+        K(1),
+        _groupBytes(1),
+        _acc(BLOCK*2)
+    {
+        this->setupInput(0, typeid(unsigned char));
+        this->setupOutput(0, typeid(Type));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LinearModulator, setMap));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LinearModulator, getMap));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LinearModulator, setBitOrder));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LinearModulator, getBitOrder));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LinearModulator, setInterpolation));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LinearModulator, getInterpolation));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LinearModulator, setTaps));
+        this->registerCall(this, POTHOS_FCN_TUPLE(LinearModulator, getTaps));
+        this->setMap(std::vector<Type>{Type(-1), Type(1)}); //initial update
+        this->setTaps(std::vector<double>(1, 1.0)); //initial update
+    }
+
+    void setMap(const std::vector<Type> &map)
+    {
+        if (map.size() < 2) throw Pothos::InvalidArgumentException("LinearModulator::setMap()", "Map must have at least 2 points");
+        if (map.size() > 256) throw Pothos::InvalidArgumentException("LinearModulator::setMap()", "Map must have at most 256 points");
+        const auto nbits = std::log2(map.size());
+        if (nbits != int(nbits))
+        {
+            throw Pothos::InvalidArgumentException("LinearModulator::setMap()", "Map must be a power of two in length");
+        }
+        _map = map;
+        _mod = size_t(nbits);
+
+        //the smallest number of bytes that holds a whole number of symbols
+        _groupBytes = _mod;
+        while ((_groupBytes % 2) == 0 and ((_groupBytes/2)*8) % _mod == 0) _groupBytes /= 2;
+        this->input(0)->setReserve(_groupBytes);
+    }
+
+    std::vector<Type> getMap(void) const
+    {
+        return _map;
+    }
+
+    void setBitOrder(const std::string &order)
+    {
+        if (order == "LSBit") _order = LSBit;
+        else if (order == "MSBit") _order = MSBit;
+        else throw Pothos::InvalidArgumentException("LinearModulator::setBitOrder()", "Order must be LSBit or MSBit");
+    }
+
+    std::string getBitOrder(void) const
+    {
+        return (_order == LSBit)?"LSBit":"MSBit";
+    }
+
+    void setInterpolation(const size_t interp)
+    {
+        if (interp == 0) throw Pothos::InvalidArgumentException("LinearModulator::setInterpolation()", "interpolation cannot be 0");
+        L = interp;
+        this->updateInternals();
+    }
+
+    size_t getInterpolation(void) const
+    {
+        return L;
+    }
+
+    void setTaps(const std::vector<double> &taps)
+    {
+        if (taps.empty()) throw Pothos::InvalidArgumentException("LinearModulator::setTaps()", "taps cannot be empty");
+        _taps = taps;
+        this->updateInternals();
+    }
+
+    std::vector<double> getTaps(void) const
+    {
+        return _taps;
+    }
+
+    void activate(void)
+    {
+        //start with the filter history cleared
+        std::fill(_hist.begin(), _hist.end(), Type(0));
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+
+        //whole groups of bytes limited by the output space
+        const size_t maxSyms = outPort->elements()/L;
+        const size_t maxBytes = std::min(inPort->elements(), (maxSyms*_mod)/8);
+        const size_t numBytes = (maxBytes/_groupBytes)*_groupBytes;
+        if (numBytes == 0) return;
+        const size_t numSyms = (numBytes*8)/_mod;
+
+        //unpack into symbol indexes
+        _syms.resize(numSyms);
+        const unsigned char *in = inPort->buffer();
+        switch (_order)
+        {
+        case MSBit: ::bytesToSymbolsMSBit(_mod, in, _syms.data(), numBytes); break;
+        case LSBit: ::bytesToSymbolsLSBit(_mod, in, _syms.data(), numBytes); break;
+        }
+
+        //map into constellation points after the K-1 symbols of history
+        _hist.resize(K-1 + numSyms);
+        Type *x = _hist.data() + (K-1);
+        for (size_t n = 0; n < numSyms; n++) x[n] = _map[_syms[n] & (_map.size()-1)];
+
+        //Polyphase interpolation, the zeros of the upsampled stream are skipped.
+        //Each phase is accumulated over a block of symbols on the real components,
+        //so the inner loop is unit stride and vectorizes, then it is interleaved into the output.
+        const size_t D = sizeof(Type)/sizeof(RealType);
+        RealType *acc = _acc.data();
+        RealType *y = outPort->buffer();
+        for (size_t n0 = 0; n0 < numSyms; n0 += BLOCK)
+        {
+            const size_t num = std::min(size_t(BLOCK), numSyms-n0)*D;
+            const RealType *xr = reinterpret_cast<const RealType *>(x + n0);
+            for (size_t j = 0; j < L; j++)
+            {
+                const RealType *h = _phaseTaps.data() + j*K;
+                std::fill(acc, acc+num, RealType(0));
+                for (size_t k = 0; k < K; k++)
+                {
+                    const RealType h_k = h[k];
+                    const RealType *x_k = xr - k*D;
+                    for (size_t i = 0; i < num; i++) acc[i] += h_k * x_k[i];
+                }
+                RealType *y_j = y + (n0*L + j)*D;
+                for (size_t i = 0; i < num; i += D)
+                {
+                    for (size_t d = 0; d < D; d++) y_j[i*L + d] = acc[i + d];
+                }
+            }
+        }
+
+        //keep the last K-1 symbols for the next call
+        std::copy(_hist.end()-(K-1), _hist.end(), _hist.begin());
+        _hist.resize(K-1);
+
+        inPort->consume(numBytes);
+        outPort->produce(numSyms*L);
+    }
+
+    void propagateLabels(const Pothos::InputPort *port)
+    {
+        auto outputPort = this->output(0);
+        for (const auto &label : port->labels())
+        {
+            outputPort->postLabel(label.toAdjusted(8*L, _mod));
+        }
+    }
+
+private:
+    void updateInternals(void)
+    {
+        //K is the number of taps in each phase, zero padded to the same length
+        K = (_taps.size() + L - 1)/L;
+        _phaseTaps.assign(L*K, RealType(0));
+        for (size_t j = 0; j < L; j++)
+        {
+            for (size_t k = 0; k < K; k++)
+            {
+                const auto i = j+k*L;
+                if (i < _taps.size()) _phaseTaps[j*K + k] = RealType(_taps[i]);
+            }
+        }
+        _hist.assign(K-1, Type(0));
+    }
+
+    std::vector<Type> _map;
+    BitOrder _order;
+    size_t _mod;
+    size_t L, K;
+    size_t _groupBytes;
+    std::vector<double> _taps;
+    std::vector<RealType> _phaseTaps; //L phases of K taps
+    std::vector<unsigned char> _syms;
+    std::vector<Type> _hist; //K-1 symbols of history then the mapped symbols
+    static const size_t BLOCK = 256; //symbols per block of phase accumulation
+    std::vector<RealType> _acc;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *LinearModulatorFactory(const Pothos::DType &dtype)
+{
+    #define ifTypeDeclareFactory(type) \
+        if (dtype == Pothos::DType(typeid(type))) \
+            return new LinearModulator<type>(); \
+        if (dtype == Pothos::DType(typeid(std::complex<type>))) \
+            return new LinearModulator<std::complex<type>>();
+    ifTypeDeclareFactory(double);
+    ifTypeDeclareFactory(float);
+    throw Pothos::InvalidArgumentException("LinearModulatorFactory("+dtype.toString()+")", "unsupported type");
+}
+
+static Pothos::BlockRegistry registerLinearModulator(
+    "/comms/linear_modulator", &LinearModulatorFactory);
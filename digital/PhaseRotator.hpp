@@ -0,0 +1,133 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+/***********************************************************************
+ * Recursive phasor for scale*exp(j*(phase + phaseInc*n))
+ *
+ * The phasor advances by one complex multiply per element
+ * instead of a sin/cos pair per element. It is recomputed from
+ * the accumulated phase every SYNC elements to bound the magnitude
+ * and phase drift of the recursion.
+ **********************************************************************/
+template <typename Type>
+class PhaseRotator
+{
+public:
+    typedef typename Type::value_type RealType;
+
+    //! Number of elements between exact phasor updates
+    static const size_t SYNC = 256;
+
+    //! Number of independent phasors used by rotate()
+    static const size_t LANES = 8;
+
+    PhaseRotator(const RealType scale, const RealType phase, const RealType phaseInc):
+        _scale(scale),
+        _phase(phase),
+        _phaseInc(phaseInc),
+        _count(0)
+    {
+        this->resync();
+    }
+
+    //! Get the phasor for the current element and advance by one element
+    Type next(void)
+    {
+        if (_count == SYNC) this->resync();
+        const Type rot = _rot;
+        _rot = cmul(_rot, _step);
+        _count++;
+        return rot;
+    }
+
+    /*!
+     * Rotate N elements: out[i] = in[i*stride]*phasor(i), then advance by N.
+     * Each lane owns every LANES-th element and steps by phaseInc*LANES,
+     * so the lanes are independent and the inner loop vectorizes.
+     */
+    void rotate(const Type *in, const size_t stride, Type *out, const size_t N)
+    {
+        this->advance();
+        Type lanes[LANES];
+        size_t i = 0;
+        while (i < N)
+        {
+            const size_t chunk = std::min(N-i, size_t(SYNC));
+            for (size_t l = 0; l < LANES; l++) lanes[l] = this->phasor(_scale, _phaseInc*l);
+            const Type laneStep = std::polar<RealType>(1, _phaseInc*LANES);
+
+            size_t j = 0;
+            for (; j+LANES <= chunk; j += LANES)
+            {
+                for (size_t l = 0; l < LANES; l++)
+                {
+                    out[i+j+l] = cmul(in[(i+j+l)*stride], lanes[l]);
+                    lanes[l] = cmul(lanes[l], laneStep);
+                }
+            }
+            for (size_t l = 0; j < chunk; j++, l++)
+            {
+                out[i+j] = cmul(in[(i+j)*stride], lanes[l]);
+            }
+
+            _phase += double(_phaseInc)*chunk;
+            this->wrap();
+            i += chunk;
+        }
+        this->resync();
+    }
+
+    //! The phase of the current element
+    RealType phase(void)
+    {
+        this->advance();
+        return RealType(_phase);
+    }
+
+private:
+    //! complex multiply without the NaN/Inf recovery of operator*, which blocks vectorization
+    static inline Type cmul(const Type &a, const Type &b)
+    {
+        return Type(a.real()*b.real() - a.imag()*b.imag(), a.real()*b.imag() + a.imag()*b.real());
+    }
+
+    Type phasor(const RealType scale, const double offset) const
+    {
+        return std::polar<RealType>(scale, RealType(_phase + offset));
+    }
+
+    //! fold the elements stepped by next() into the accumulated phase
+    void advance(void)
+    {
+        _phase += double(_phaseInc)*_count;
+        _count = 0;
+    }
+
+    //! keep the phase small so the conversion to RealType stays accurate
+    void wrap(void)
+    {
+        const double twoPi = 6.283185307179586476925286766559005768;
+        _phase = std::fmod(_phase, twoPi);
+    }
+
+    void resync(void)
+    {
+        this->advance();
+        this->wrap();
+        _rot = this->phasor(_scale, 0);
+        _step = std::polar<RealType>(1, _phaseInc);
+    }
+
+    const RealType _scale;
+    double _phase;
+    const RealType _phaseInc;
+    size_t _count;
+    Type _rot;
+    Type _step;
+};
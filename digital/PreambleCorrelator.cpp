@@ -1,21 +1,180 @@
 // Copyright (c) 2015-2017 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "common/CpuFeatures.hpp"
 #include <Pothos/Framework.hpp>
 #include <cstdint>
 #include <complex>
 #include <cassert>
 #include <iostream>
+#include <vector>
+#include <algorithm> //min/max/sort
+#include <cstring> //memcpy
 
-//provide __popcnt()
+//provide __popcnt64()
 #ifdef _MSC_VER
 #  include <intrin.h>
 #elif __GNUC__
-#  define __popcnt __builtin_popcount
+#  define __popcnt64 __builtin_popcountll
 #else
-#  error "provide __popcnt() for this compiler"
+#  error "provide __popcnt64() for this compiler"
 #endif
 
+/***********************************************************************
+ * Packed bit helpers
+ *
+ * The input symbols are packed into a bit stream with B bits per symbol,
+ * where B is the width of the widest preamble symbol.
+ * The window at position n is then bits [n*B, n*B + P*B) of the stream,
+ * and it is compared to the packed preamble with one XOR and popcount
+ * per 64-bit word, instead of one popcount per preamble symbol.
+ **********************************************************************/
+
+//! Read 64 bits from the packed stream starting at bit position pos
+static inline uint64_t readStreamBits(const uint64_t *stream, const size_t pos)
+{
+    const size_t idx = pos/64;
+    const size_t shift = pos%64;
+    if (shift == 0) return stream[idx];
+    return (stream[idx] >> shift) | (stream[idx+1] << (64-shift));
+}
+
+//! Pack the low numBits bits of each symbol into a zero padded stream
+static void packStreamBits(const unsigned char *in, const size_t num, const size_t numBits, std::vector<uint64_t> &stream)
+{
+    stream.assign((num*numBits)/64 + 2, 0);
+
+    //full width symbols are already packed
+    if (numBits == 8)
+    {
+        std::memcpy(stream.data(), in, num);
+        return;
+    }
+
+    const uint64_t mask = (uint64_t(1) << numBits)-1;
+    size_t pos = 0;
+    for (size_t i = 0; i < num; i++, pos += numBits)
+    {
+        const uint64_t bits = in[i] & mask;
+        stream[pos/64] |= bits << (pos%64);
+        if ((pos%64)+numBits > 64) stream[pos/64+1] |= bits >> (64-(pos%64));
+    }
+}
+
+//! One preamble packed at the stream width, with its own threshold and label
+struct PreamblePattern
+{
+    std::vector<unsigned char> preamble;
+    std::vector<uint64_t> packed;
+    uint64_t lastMask; //valid bits of the last packed word
+    unsigned threshold;
+    std::string frameStartId;
+};
+
+//! A match of pattern at the label index one symbol past the preamble
+struct PreambleMatch
+{
+    size_t index;
+    size_t pattern;
+
+    bool operator<(const PreambleMatch &other) const
+    {
+        return (index == other.index)?(pattern < other.pattern):(index < other.index);
+    }
+};
+
+#ifdef CPU_FEATURES_X86
+
+//! Pack the low bit of 32 symbols at a time with a byte movemask
+__attribute__((target("avx2")))
+static void packStreamBitsAVX2(const unsigned char *in, const size_t num, std::vector<uint64_t> &stream)
+{
+    stream.assign(num/64 + 2, 0);
+    auto out = reinterpret_cast<unsigned char *>(stream.data());
+    size_t i = 0;
+    for (; i+32 <= num; i += 32, out += 4)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in+i));
+        const uint32_t bits = uint32_t(_mm256_movemask_epi8(_mm256_slli_epi16(v, 7)));
+        std::memcpy(out, &bits, sizeof(bits));
+    }
+    for (; i < num; i++) stream[i/64] |= uint64_t(in[i] & 0x1) << (i%64);
+}
+
+//! Funnel shift the two stream words that contain each single word window at 4 positions
+__attribute__((target("avx2")))
+static inline __m256i windowAVX2(const long long *stream, const __m256i bitPos)
+{
+    const __m256i idx = _mm256_srli_epi64(bitPos, 6);
+    const __m256i shift = _mm256_and_si256(bitPos, _mm256_set1_epi64x(63));
+    const __m256i lo = _mm256_i64gather_epi64(stream, idx, 8);
+    const __m256i hi = _mm256_i64gather_epi64(stream+1, idx, 8);
+    return _mm256_or_si256(_mm256_srlv_epi64(lo, shift),
+        _mm256_sllv_epi64(hi, _mm256_sub_epi64(_mm256_set1_epi64x(64), shift)));
+}
+
+//! Hamming distance of 4 windows to a preamble word, summed per 64-bit lane
+__attribute__((target("avx2")))
+static inline __m256i distanceAVX2(const __m256i window, const __m256i pre, const __m256i mask)
+{
+    const __m256i lut = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low4 = _mm256_set1_epi8(0x0f);
+
+    //nibble lookup popcount
+    const __m256i x = _mm256_and_si256(_mm256_xor_si256(window, pre), mask);
+    const __m256i counts = _mm256_add_epi8(
+        _mm256_shuffle_epi8(lut, _mm256_and_si256(x, low4)),
+        _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), low4)));
+    return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+}
+
+/*!
+ * Correlate 8 positions per iteration when every window fits in one word.
+ * The windows are shifted out of the stream once per position
+ * and compared against every pattern from registers.
+ */
+__attribute__((target("avx2")))
+static size_t correlateWordAVX2(const uint64_t *stream, const size_t numBits, const size_t num,
+    const std::vector<PreamblePattern> &patterns, std::vector<PreambleMatch> &matches)
+{
+    const auto streamPtr = reinterpret_cast<const long long *>(stream);
+    const __m256i step = _mm256_set1_epi64x((long long)(8*numBits));
+    const long long B = (long long)numBits;
+    __m256i pos0 = _mm256_setr_epi64x(0, B, 2*B, 3*B);
+    __m256i pos1 = _mm256_setr_epi64x(4*B, 5*B, 6*B, 7*B);
+
+    size_t n = 0;
+    for (; n+8 <= num; n += 8)
+    {
+        const __m256i w0 = windowAVX2(streamPtr, pos0);
+        const __m256i w1 = windowAVX2(streamPtr, pos1);
+        for (size_t k = 0; k < patterns.size(); k++)
+        {
+            const auto &pattern = patterns[k];
+            const __m256i pre = _mm256_set1_epi64x((long long)pattern.packed[0]);
+            const __m256i msk = _mm256_set1_epi64x((long long)pattern.lastMask);
+            const __m256i thresh = _mm256_set1_epi64x((long long)pattern.threshold);
+            const __m256i d0 = distanceAVX2(w0, pre, msk);
+            const __m256i d1 = distanceAVX2(w1, pre, msk);
+            const int miss0 = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(d0, thresh)));
+            const int miss1 = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(d1, thresh)));
+            unsigned hits = ~unsigned(miss0 | (miss1 << 4)) & 0xff;
+            while (hits != 0)
+            {
+                matches.push_back(PreambleMatch{n + __builtin_ctz(hits) + pattern.preamble.size(), k});
+                hits &= hits-1;
+            }
+        }
+        pos0 = _mm256_add_epi64(pos0, step);
+        pos1 = _mm256_add_epi64(pos1, step);
+    }
+    return n;
+}
+
+#endif //CPU_FEATURES_X86
+
 /***********************************************************************
  * |PothosDoc Preamble Correlator
  *
@@ -27,6 +186,22 @@
  * and therefore it may be used operationally on a bit-stream,
  * because a bit-stream is identically a symbol stream of N=1.
  *
+ * Internally, the input symbols are packed into a bit stream
+ * at the width of the widest preamble symbol, so that each search
+ * position costs one XOR and popcount per 64 bits of preamble.
+ *
+ * <h2>Multiple patterns</h2>
+ *
+ * The correlator can search for several preambles at once,
+ * such as the sync words of different frame types.
+ * The calls setPreambles(), setThresholds(), and setFrameStartIds()
+ * configure a list of patterns, each with its own threshold and label ID.
+ * A threshold or label ID list with a single entry applies to every pattern.
+ * All patterns are searched in one pass: the window at each position
+ * is shifted out of the packed stream once and compared to every pattern.
+ * The setPreamble(), setThreshold(), and setFrameStartId() calls
+ * configure a single pattern.
+ *
  * http://en.wikipedia.org/wiki/Hamming_distance
  *
  * |category /Digital
@@ -58,7 +233,10 @@ public:
     }
 
     PreambleCorrelator(void):
-        _threshold(0)
+        _maxPreambleSize(0),
+        _maxWords(0),
+        _symbolBits(1),
+        _symbolMask(1)
     {
         this->setupInput(0, typeid(unsigned char));
         this->setupOutput(0, typeid(unsigned char), this->uid()); //unique domain because of buffer forwarding
@@ -69,6 +247,12 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, getThreshold));
         this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, setFrameStartId));
         this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, getFrameStartId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, setPreambles));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, getPreambles));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, setThresholds));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, getThresholds));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, setFrameStartIds));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, getFrameStartIds));
         this->setPreamble(std::vector<unsigned char>(1, 1)); //initial update
         this->setThreshold(1); //initial update
         this->setFrameStartId("frameStart"); //initial update
@@ -76,33 +260,85 @@ public:
 
     void setPreamble(const std::vector<unsigned char> preamble)
     {
-        if (preamble.empty()) throw Pothos::InvalidArgumentException("PreambleCorrelator::setPreamble()", "preamble cannot be empty");
-        _preamble = preamble;
+        this->setPreambles(std::vector<std::vector<unsigned char>>(1, preamble));
     }
 
     std::vector<unsigned char> getPreamble(void) const
     {
-        return _preamble;
+        return _preambles.front();
     }
 
     void setThreshold(const unsigned threshold)
     {
-        _threshold = threshold;
+        this->setThresholds(std::vector<unsigned>(1, threshold));
     }
 
     unsigned getThreshold(void) const
     {
-        return _threshold;
+        return _thresholds.front();
     }
 
     void setFrameStartId(std::string id)
     {
-        _frameStartId = id;
+        this->setFrameStartIds(std::vector<std::string>(1, id));
     }
 
     std::string getFrameStartId(void) const
     {
-        return _frameStartId;
+        return _frameStartIds.front();
+    }
+
+    void setPreambles(const std::vector<std::vector<unsigned char>> preambles)
+    {
+        if (preambles.empty()) throw Pothos::InvalidArgumentException("PreambleCorrelator::setPreambles()", "preamble list cannot be empty");
+        for (const auto &preamble : preambles)
+        {
+            if (preamble.empty()) throw Pothos::InvalidArgumentException("PreambleCorrelator::setPreambles()", "preamble cannot be empty");
+        }
+        _preambles = preambles;
+        this->update();
+    }
+
+    std::vector<std::vector<unsigned char>> getPreambles(void) const
+    {
+        return _preambles;
+    }
+
+    void setThresholds(const std::vector<unsigned> thresholds)
+    {
+        if (thresholds.empty()) throw Pothos::InvalidArgumentException("PreambleCorrelator::setThresholds()", "threshold list cannot be empty");
+        _thresholds = thresholds;
+        this->update();
+    }
+
+    std::vector<unsigned> getThresholds(void) const
+    {
+        return _thresholds;
+    }
+
+    void setFrameStartIds(const std::vector<std::string> ids)
+    {
+        if (ids.empty()) throw Pothos::InvalidArgumentException("PreambleCorrelator::setFrameStartIds()", "frame start ID list cannot be empty");
+        _frameStartIds = ids;
+        this->update();
+    }
+
+    std::vector<std::string> getFrameStartIds(void) const
+    {
+        return _frameStartIds;
+    }
+
+    void activate(void)
+    {
+        //lists are set one at a time, so the sizes are checked once they are all set
+        if (_thresholds.size() != 1 and _thresholds.size() != _preambles.size())
+        {
+            throw Pothos::InvalidArgumentException("PreambleCorrelator::activate()", "threshold list size does not match the preamble list");
+        }
+        if (_frameStartIds.size() != 1 and _frameStartIds.size() != _preambles.size())
+        {
+            throw Pothos::InvalidArgumentException("PreambleCorrelator::activate()", "frame start ID list size does not match the preamble list");
+        }
     }
 
     //! always use a circular buffer to avoid discontinuity over sliding window
@@ -117,46 +353,140 @@ public:
         auto outputPort = this->output(0);
         //auto outputDistance = this->output(1);
 
-        //require preamble size + 1 elements to perform processing
-        inputPort->setReserve(_preamble.size()+1);
+        //require longest preamble size + 1 elements to perform processing
+        inputPort->setReserve(_maxPreambleSize+1);
         auto buffer = inputPort->takeBuffer();
-        if (buffer.length <= (size_t) _preamble.size()) return;
+        if (buffer.length <= _maxPreambleSize) return;
 
         //due to search window, the last preamble size elements are used
         //consume and forward all processable elements of the input buffer
-        buffer.length -= _preamble.size();
+        buffer.length -= _maxPreambleSize;
         inputPort->consume(buffer.length);
 
         // Calculate Hamming distance at each position looking for match
         // When a match is found a label is created after the preamble
-        unsigned char *in = buffer;
+        const unsigned char *in = buffer;
         //auto distance = outputDistance->buffer().template as<unsigned *>();
-        for (size_t n = 0; n < buffer.length; n++)
+        this->correlate(in, buffer.length);
+        for (const auto &match : _matches)
+        {
+            outputPort->postLabel(_patterns[match.pattern].frameStartId, Pothos::Object(), match.index);
+        }
+
+        //outputDistance->produce(N);
+        outputPort->postBuffer(std::move(buffer));
+    }
+
+private:
+    //! Repack every pattern at the width of the widest symbol of all preambles
+    void update(void)
+    {
+        if (_preambles.empty() or _thresholds.empty() or _frameStartIds.empty()) return;
+
+        unsigned char allBits = 0;
+        for (const auto &preamble : _preambles)
+        {
+            for (const auto sym : preamble) allBits |= sym;
+        }
+        _symbolBits = 1;
+        while (_symbolBits < 8 and (allBits >> _symbolBits) != 0) _symbolBits++;
+        _symbolMask = (unsigned char)((1u << _symbolBits)-1);
+
+        _patterns.resize(_preambles.size());
+        _maxPreambleSize = 0;
+        _maxWords = 0;
+        for (size_t k = 0; k < _preambles.size(); k++)
         {
-            unsigned dist = 0;
+            auto &pattern = _patterns[k];
+            pattern.preamble = _preambles[k];
+            pattern.threshold = _thresholds[std::min(k, _thresholds.size()-1)];
+            pattern.frameStartId = _frameStartIds[std::min(k, _frameStartIds.size()-1)];
+            const size_t numWindowBits = pattern.preamble.size()*_symbolBits;
+            packStreamBits(pattern.preamble.data(), pattern.preamble.size(), _symbolBits, pattern.packed);
+            pattern.packed.resize((numWindowBits+63)/64);
+            pattern.lastMask = (numWindowBits%64 == 0)?~uint64_t(0):((uint64_t(1) << (numWindowBits%64))-1);
+            _maxPreambleSize = std::max(_maxPreambleSize, pattern.preamble.size());
+            _maxWords = std::max(_maxWords, pattern.packed.size());
+        }
+        _window.resize(_maxWords);
+    }
+
+    //! Find the matches at positions in [0, num) with a distance within the threshold
+    void correlate(const unsigned char *in, const size_t num)
+    {
+        _matches.clear();
+        const size_t numElems = num + _maxPreambleSize;
+
+        //input bits above the packed symbol width are not in the packed window,
+        //but they differ from the preamble, so they are counted separately
+        unsigned char allBits = 0;
+        for (size_t i = 0; i < numElems; i++) allBits |= in[i];
+        const bool extraBits = (allBits & ~_symbolMask) != 0;
+
+        size_t n = 0;
 
-            // Count the number of bits set
-            for (size_t i = 0; i < _preamble.size(); i++)
+#ifdef CPU_FEATURES_X86
+        //vectorized search when the windows fit in one word, the tail is scalar
+        const bool useAVX2 = CpuFeatures::avx2() and _maxWords == 1 and not extraBits;
+        if (CpuFeatures::avx2() and _symbolBits == 1) packStreamBitsAVX2(in, numElems, _stream);
+        else packStreamBits(in, numElems, _symbolBits, _stream);
+        if (useAVX2) n = correlateWordAVX2(_stream.data(), _symbolBits, num, _patterns, _matches);
+#else
+        packStreamBits(in, numElems, _symbolBits, _stream);
+#endif
+
+        //prefix count of input bits above the packed symbol width,
+        //so each pattern length gets its window count with one subtraction
+        if (extraBits)
+        {
+            _extraCounts.resize(numElems+1);
+            _extraCounts[0] = 0;
+            for (size_t i = 0; i < numElems; i++)
             {
-                // A bit is set, so increment the distance
-                dist += __popcnt(_preamble[i] ^ in[n+i]);
+                _extraCounts[i+1] = _extraCounts[i] + unsigned(__popcnt64(in[i] & ~_symbolMask));
             }
-            // Emit a label if within the distance threshold
-            if (dist <= _threshold)
+        }
+
+        for (; n < num; n++)
+        {
+            //the window words are shared by all patterns,
+            //and they are read on demand since most patterns miss on the first word
+            const size_t pos = n*_symbolBits;
+            size_t numRead = 0;
+
+            for (size_t k = 0; k < _patterns.size(); k++)
             {
-                outputPort->postLabel(_frameStartId, Pothos::Object(), n + _preamble.size());
+                const auto &pattern = _patterns[k];
+                const size_t P = pattern.preamble.size();
+                const size_t numWords = pattern.packed.size();
+                unsigned dist = extraBits?(_extraCounts[n+P] - _extraCounts[n]):0;
+                for (size_t w = 0; w < numWords and dist <= pattern.threshold; w++)
+                {
+                    if (w == numRead) _window[numRead++] = readStreamBits(_stream.data(), pos+w*64);
+                    auto diff = _window[w] ^ pattern.packed[w];
+                    if (w == numWords-1) diff &= pattern.lastMask;
+                    dist += unsigned(__popcnt64(diff));
+                }
+                if (dist <= pattern.threshold) _matches.push_back(PreambleMatch{n + P, k});
             }
-
-            //distance[n] = dist;
         }
-        //outputDistance->produce(N);
-        outputPort->postBuffer(std::move(buffer));
+
+        //labels are posted in index order, patterns of different lengths can interleave
+        if (_patterns.size() > 1) std::sort(_matches.begin(), _matches.end());
     }
 
-private:
-    unsigned _threshold;
-    std::string _frameStartId;
-    std::vector<unsigned char> _preamble;
+    std::vector<std::vector<unsigned char>> _preambles;
+    std::vector<unsigned> _thresholds;
+    std::vector<std::string> _frameStartIds;
+    std::vector<PreamblePattern> _patterns;
+    size_t _maxPreambleSize;
+    size_t _maxWords;
+    size_t _symbolBits; //packed bits per symbol
+    unsigned char _symbolMask; //mask of the packed bits
+    std::vector<uint64_t> _stream;
+    std::vector<uint64_t> _window;
+    std::vector<unsigned> _extraCounts;
+    std::vector<PreambleMatch> _matches;
 };
 
 /***********************************************************************
@@ -0,0 +1,396 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include "common/CpuFeatures.hpp"
+#include <Pothos/Exception.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> //memcpy
+#include <string>
+#include <vector>
+#include <algorithm> //min/max
+
+/***********************************************************************
+ * Reed-Solomon code over GF(2^8)
+ *
+ * A codeword holds up to 255 symbols: the data symbols followed by
+ * numRoots parity symbols. Shorter codewords are shortened codes,
+ * as if the data was preceded by zero symbols that are not sent.
+ * The generator polynomial has the roots alpha^((fcr+i)*prim)
+ * for i in [0, numRoots), where alpha is a root of the field polynomial.
+ *
+ * The encoder steps the parity register one data symbol at a time,
+ * with the feedback products of all generator coefficients in one table row.
+ * The decoder computes the syndromes as a sum of products of each received
+ * symbol with a row of root powers, using split-nibble multiplication tables
+ * (two 16-entry lookups per product) so that the SIMD shuffle computes
+ * 16 or 32 syndromes per received symbol. Non-zero syndromes go through
+ * Berlekamp-Massey, the Chien search, and the Forney algorithm.
+ **********************************************************************/
+class ReedSolomonCode
+{
+public:
+    static const size_t NN = 255; //symbols in a full length codeword
+
+    ReedSolomonCode(void):
+        _numRoots(0),
+        _fcr(0),
+        _prim(0),
+        _iprim(0),
+        _stride(0),
+        _words(0)
+    {
+        this->setup("ReedSolomonCode()", 32, 0x11d, 0, 1);
+    }
+
+    void setup(const std::string &what, const size_t numRoots, const unsigned poly, const unsigned fcr, const unsigned prim)
+    {
+        if (numRoots == 0 or numRoots >= NN) throw Pothos::InvalidArgumentException(what, "Number of parity symbols out of range");
+        if (poly < 0x100 or poly > 0x1ff) throw Pothos::InvalidArgumentException(what, "Field polynomial must have degree 8");
+        if (fcr >= NN) throw Pothos::InvalidArgumentException(what, "First consecutive root out of range");
+        if (prim == 0 or prim >= NN or (prim % 3) == 0 or (prim % 5) == 0 or (prim % 17) == 0)
+        {
+            throw Pothos::InvalidArgumentException(what, "Primitive element power must be coprime with 255");
+        }
+
+        //log and antilog tables, the antilog table is doubled to skip a modulo
+        unsigned x = 1;
+        for (size_t i = 0; i < NN; i++)
+        {
+            _alphaTo[i] = _alphaTo[i+NN] = uint8_t(x);
+            _indexOf[x] = uint8_t(i);
+            x <<= 1;
+            if (x & 0x100) x ^= poly;
+            if (x == 1 and i+1 != NN) throw Pothos::InvalidArgumentException(what, "Field polynomial is not primitive");
+        }
+        if (x != 1) throw Pothos::InvalidArgumentException(what, "Field polynomial is not primitive");
+        _alphaTo[2*NN] = _alphaTo[0];
+        _indexOf[0] = 0; //unused, zero is checked before every lookup
+
+        _numRoots = numRoots;
+        _fcr = fcr;
+        _prim = prim;
+        _iprim = 1;
+        while ((_iprim % prim) != 0) _iprim += NN;
+        _iprim /= prim;
+
+        //generator polynomial in coefficient form, genpoly[numRoots] = 1
+        std::vector<uint8_t> genpoly(numRoots+1, 0);
+        genpoly[0] = 1;
+        for (size_t i = 0, root = fcr*prim; i < numRoots; i++, root += prim)
+        {
+            genpoly[i+1] = 1;
+            for (size_t j = i; j > 0; j--)
+            {
+                genpoly[j] = genpoly[j-1] ^ mul(genpoly[j], _alphaTo[root % NN]);
+            }
+            genpoly[0] = mul(genpoly[0], _alphaTo[root % NN]);
+        }
+
+        //encoder rows: the feedback times each coefficient, in register order
+        _words = (numRoots+7)/8;
+        _encTable.assign(256*_words, 0);
+        for (size_t fb = 0; fb < 256; fb++)
+        {
+            for (size_t j = 0; j < numRoots; j++)
+            {
+                const uint64_t c = mul(uint8_t(fb), genpoly[numRoots-1-j]);
+                _encTable[fb*_words + j/8] |= c << (8*(j%8));
+            }
+        }
+
+        //root powers of each symbol position, split into nibbles
+        _stride = ((numRoots+31)/32)*32;
+        _rootLo.assign(NN*_stride, 0);
+        _rootHi.assign(NN*_stride, 0);
+        for (size_t p = 0; p < NN; p++)
+        {
+            for (size_t i = 0; i < numRoots; i++)
+            {
+                const uint8_t h = _alphaTo[(((fcr+i)*prim) % NN)*p % NN];
+                _rootLo[p*_stride + i] = h & 0xf;
+                _rootHi[p*_stride + i] = h >> 4;
+            }
+        }
+
+        //products of every symbol with every low and high nibble
+        for (size_t r = 0; r < 256; r++)
+        {
+            for (size_t n = 0; n < 16; n++)
+            {
+                _nibbleMul[r][n] = mul(uint8_t(r), uint8_t(n));
+                _nibbleMul[r][n+16] = mul(uint8_t(r), uint8_t(n << 4));
+            }
+        }
+    }
+
+    size_t numRoots(void) const
+    {
+        return _numRoots;
+    }
+
+    //! Compute numRoots() parity symbols for len <= NN-numRoots() data symbols
+    void encode(const uint8_t *data, const size_t len, uint8_t *parity) const
+    {
+        uint64_t reg[(NN+7)/8] = {};
+        switch (_words)
+        {
+        case 1: stepRegister<1>(_encTable.data(), 1, data, len, reg); break;
+        case 2: stepRegister<2>(_encTable.data(), 2, data, len, reg); break;
+        case 4: stepRegister<4>(_encTable.data(), 4, data, len, reg); break;
+        default: stepRegister<0>(_encTable.data(), _words, data, len, reg); break;
+        }
+        for (size_t j = 0; j < _numRoots; j++) parity[j] = uint8_t(reg[j/8] >> (8*(j%8)));
+    }
+
+    /*!
+     * Correct a codeword of len symbols in place, numRoots() < len <= NN.
+     * \return the number of corrected symbols, or -1 when uncorrectable
+     */
+    int decode(uint8_t *codeword, const size_t len) const
+    {
+        uint8_t s[NN];
+        if (not this->syndromes(codeword, len, s)) return 0;
+        return this->correct(codeword, len, s);
+    }
+
+private:
+    uint8_t mul(const uint8_t a, const uint8_t b) const
+    {
+        if (a == 0 or b == 0) return 0;
+        return _alphaTo[_indexOf[a] + _indexOf[b]];
+    }
+
+    /*!
+     * Shift the data through the parity register, where byte j of the register
+     * is bits 8*(j%8) of word j/8. W is the number of words, or 0 for any number.
+     * The feedback selects one table row that updates all of the register words.
+     */
+    template <size_t W>
+    static void stepRegister(const uint64_t *table, const size_t words, const uint8_t *data, const size_t len, uint64_t *reg)
+    {
+        const size_t n = (W == 0)?words:W;
+        for (size_t i = 0; i < len; i++)
+        {
+            const uint8_t fb = data[i] ^ uint8_t(reg[0]);
+            const uint64_t *row = table + fb*n;
+            for (size_t w = 0; w+1 < n; w++) reg[w] = ((reg[w] >> 8) | (reg[w+1] << 56)) ^ row[w];
+            reg[n-1] = (reg[n-1] >> 8) ^ row[n-1];
+        }
+    }
+
+    static int modnn(int x)
+    {
+        return x % int(NN);
+    }
+
+    //! Syndromes s[i] = r(alpha^((fcr+i)*prim)), return true when any is non-zero
+    bool syndromes(const uint8_t *r, const size_t len, uint8_t *s) const
+    {
+        #ifdef CPU_FEATURES_X86
+        if (CpuFeatures::avx2()) this->syndromesAVX2(r, len, s);
+        else if (CpuFeatures::ssse3()) this->syndromesSSSE3(r, len, s);
+        else
+        #endif
+        this->syndromesScalar(r, len, s);
+
+        uint8_t any = 0;
+        for (size_t i = 0; i < _numRoots; i++) any |= s[i];
+        return any != 0;
+    }
+
+    //! Horner's rule with the log tables, all roots per received symbol
+    void syndromesScalar(const uint8_t *r, const size_t len, uint8_t *s) const
+    {
+        size_t roots[NN];
+        for (size_t i = 0; i < _numRoots; i++)
+        {
+            roots[i] = ((_fcr+i)*_prim) % NN;
+            s[i] = 0;
+        }
+        for (size_t j = 0; j < len; j++)
+        {
+            for (size_t i = 0; i < _numRoots; i++)
+            {
+                s[i] = r[j] ^ ((s[i] == 0)?0:_alphaTo[_indexOf[s[i]] + roots[i]]);
+            }
+        }
+    }
+
+    #ifdef CPU_FEATURES_X86
+
+    //! The symbol at position j multiplies the root powers of p = len-1-j
+    __attribute__((target("ssse3")))
+    void syndromesSSSE3(const uint8_t *r, const size_t len, uint8_t *s) const
+    {
+        for (size_t c = 0; c < _numRoots; c += 16)
+        {
+            __m128i acc = _mm_setzero_si128();
+            const uint8_t *lo = _rootLo.data() + (len-1)*_stride + c;
+            const uint8_t *hi = _rootHi.data() + (len-1)*_stride + c;
+            for (size_t j = 0; j < len; j++, lo -= _stride, hi -= _stride)
+            {
+                const uint8_t *t = _nibbleMul[r[j]];
+                const __m128i tLo = _mm_loadu_si128((const __m128i *)t);
+                const __m128i tHi = _mm_loadu_si128((const __m128i *)(t+16));
+                acc = _mm_xor_si128(acc, _mm_shuffle_epi8(tLo, _mm_loadu_si128((const __m128i *)lo)));
+                acc = _mm_xor_si128(acc, _mm_shuffle_epi8(tHi, _mm_loadu_si128((const __m128i *)hi)));
+            }
+            alignas(16) uint8_t out[16];
+            _mm_store_si128((__m128i *)out, acc);
+            std::memcpy(s+c, out, std::min<size_t>(16, _numRoots-c));
+        }
+    }
+
+    __attribute__((target("avx2")))
+    void syndromesAVX2(const uint8_t *r, const size_t len, uint8_t *s) const
+    {
+        for (size_t c = 0; c < _numRoots; c += 32)
+        {
+            __m256i acc = _mm256_setzero_si256();
+            const uint8_t *lo = _rootLo.data() + (len-1)*_stride + c;
+            const uint8_t *hi = _rootHi.data() + (len-1)*_stride + c;
+            for (size_t j = 0; j < len; j++, lo -= _stride, hi -= _stride)
+            {
+                const uint8_t *t = _nibbleMul[r[j]];
+                const __m256i tLo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)t));
+                const __m256i tHi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(t+16)));
+                acc = _mm256_xor_si256(acc, _mm256_shuffle_epi8(tLo, _mm256_loadu_si256((const __m256i *)lo)));
+                acc = _mm256_xor_si256(acc, _mm256_shuffle_epi8(tHi, _mm256_loadu_si256((const __m256i *)hi)));
+            }
+            alignas(32) uint8_t out[32];
+            _mm256_store_si256((__m256i *)out, acc);
+            std::memcpy(s+c, out, std::min<size_t>(32, _numRoots-c));
+        }
+    }
+
+    #endif //CPU_FEATURES_X86
+
+    //! Berlekamp-Massey, Chien search, and Forney on non-zero syndromes
+    int correct(uint8_t *data, const size_t len, const uint8_t *syn) const
+    {
+        const int A0 = int(NN); //log of zero
+        const int nroots = int(_numRoots);
+        const int pad = int(NN - len);
+        int lambda[NN+1], b[NN+1], t[NN+1], s[NN], omega[NN+1], root[NN], loc[NN];
+
+        for (int i = 0; i < nroots; i++) s[i] = (syn[i] == 0)?A0:_indexOf[syn[i]];
+
+        //error locator polynomial lambda in coefficient form
+        std::fill(lambda, lambda+nroots+1, 0);
+        lambda[0] = 1;
+        for (int i = 0; i <= nroots; i++) b[i] = (lambda[i] == 0)?A0:_indexOf[lambda[i]];
+        int el = 0;
+        for (int r = 1; r <= nroots; r++)
+        {
+            //discrepancy at step r, in log form
+            int discr = 0;
+            for (int i = 0; i < r; i++)
+            {
+                if (lambda[i] != 0 and s[r-i-1] != A0) discr ^= _alphaTo[modnn(_indexOf[lambda[i]] + s[r-i-1])];
+            }
+            if (discr == 0)
+            {
+                std::copy_backward(b, b+nroots, b+nroots+1);
+                b[0] = A0;
+                continue;
+            }
+            discr = _indexOf[discr];
+            t[0] = lambda[0];
+            for (int i = 0; i < nroots; i++)
+            {
+                t[i+1] = (b[i] != A0)?(lambda[i+1] ^ _alphaTo[modnn(discr + b[i])]):lambda[i+1];
+            }
+            if (2*el <= r-1)
+            {
+                el = r-el;
+                for (int i = 0; i <= nroots; i++) b[i] = (lambda[i] == 0)?A0:modnn(_indexOf[lambda[i]] - discr + A0);
+            }
+            else
+            {
+                std::copy_backward(b, b+nroots, b+nroots+1);
+                b[0] = A0;
+            }
+            std::copy(t, t+nroots+1, lambda);
+        }
+
+        //lambda to log form and its degree
+        int degLambda = 0;
+        for (int i = 0; i <= nroots; i++)
+        {
+            lambda[i] = (lambda[i] == 0)?A0:_indexOf[lambda[i]];
+            if (lambda[i] != A0) degLambda = i;
+        }
+        if (degLambda == 0 or degLambda > nroots/2) return -1;
+
+        //Chien search for the roots of lambda
+        int reg[NN+1];
+        std::copy(lambda, lambda+nroots+1, reg);
+        int count = 0;
+        for (int i = 1, k = int(_iprim)-1; i <= A0; i++, k = modnn(k + int(_iprim)))
+        {
+            int q = 1; //lambda[0] is always 1
+            for (int j = degLambda; j > 0; j--)
+            {
+                if (reg[j] == A0) continue;
+                reg[j] = modnn(reg[j] + j);
+                q ^= _alphaTo[reg[j]];
+            }
+            if (q != 0) continue;
+            root[count] = i;
+            loc[count] = k;
+            if (++count == degLambda) break;
+        }
+        if (count != degLambda) return -1;
+
+        //error evaluator omega = s*lambda mod x^nroots, in log form
+        const int degOmega = degLambda-1;
+        for (int i = 0; i <= degOmega; i++)
+        {
+            int tmp = 0;
+            for (int j = i; j >= 0; j--)
+            {
+                if (s[i-j] != A0 and lambda[j] != A0) tmp ^= _alphaTo[modnn(s[i-j] + lambda[j])];
+            }
+            omega[i] = (tmp == 0)?A0:_indexOf[tmp];
+        }
+
+        //Forney: error value = omega(x) * x^(1-fcr) / lambda'(x) at x = 1/X
+        for (int j = 0; j < count; j++)
+        {
+            if (loc[j] < pad) return -1; //located in the shortened symbols
+        }
+        for (int j = count-1; j >= 0; j--)
+        {
+            int num1 = 0;
+            for (int i = degOmega; i >= 0; i--)
+            {
+                if (omega[i] != A0) num1 ^= _alphaTo[modnn(omega[i] + i*root[j])];
+            }
+            if (num1 == 0) continue;
+            const int num2 = _alphaTo[modnn(root[j]*(int(_fcr)-1) + A0)];
+            int den = 0;
+            //lambda[i+1] for even i is the formal derivative of lambda
+            for (int i = std::min(degLambda, nroots-1) & ~1; i >= 0; i -= 2)
+            {
+                if (lambda[i+1] != A0) den ^= _alphaTo[modnn(lambda[i+1] + i*root[j])];
+            }
+            if (den == 0) return -1;
+            data[loc[j]-pad] ^= _alphaTo[modnn(_indexOf[num1] + _indexOf[num2] + A0 - _indexOf[den])];
+        }
+        return count;
+    }
+
+    size_t _numRoots;
+    size_t _fcr;
+    size_t _prim;
+    size_t _iprim;
+    uint8_t _alphaTo[2*NN+1];
+    uint8_t _indexOf[256];
+    size_t _stride; //root power row size, padded for the widest vector
+    size_t _words; //64-bit words in the parity register
+    std::vector<uint64_t> _encTable;
+    std::vector<uint8_t> _rootLo, _rootHi;
+    uint8_t _nibbleMul[256][32]; //products with low nibbles, then with high nibbles
+};
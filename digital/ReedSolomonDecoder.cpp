@@ -0,0 +1,244 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ReedSolomon.hpp"
+#include "common/FrameBlock.hpp"
+#include <Pothos/Framework.hpp>
+#include <cstdint>
+#include <cstring> //memcpy
+#include <algorithm> //min/max
+
+/***********************************************************************
+ * |PothosDoc Reed-Solomon Decoder
+ *
+ * Decode frames of bytes from the Reed-Solomon Encoder block,
+ * correcting up to parity/2 byte errors in each codeword.
+ * The parameters must match the encoder.
+ *
+ * Each frame is split into codewords of dataLength + parity bytes,
+ * where the last codeword of a frame may be shortened.
+ * The decoded frame holds the corrected data bytes without the parity bytes.
+ * When a codeword cannot be corrected, the whole frame is dropped
+ * and the error count is incremented.
+ *
+ * The syndromes are computed with SIMD shuffles as split-nibble GF(2^8) multiplies
+ * (SSSE3 or AVX2 with runtime dispatch), so that frames without errors cost
+ * about one shuffle pair per received byte. Codewords with errors are corrected
+ * with the Berlekamp-Massey algorithm, the Chien search, and the Forney algorithm.
+ *
+ * <h2>Frames</h2>
+ * Input port 0 accepts packets, and the decoded packets keep the metadata of the input packets.
+ * Input port 0 also accepts a byte stream where each frame begins
+ * at the frame start label, labeled like bursts in the FIR Filter block:
+ * the frame start label holds the frame length, or the frame ends at the frame end label.
+ * Decoded frames are posted with frame start and frame end labels
+ * that hold the decoded frame length.
+ * Bytes outside of a frame and the other labels are dropped.
+ *
+ * |category /Digital
+ * |category /Coding
+ * |keywords reed solomon rs decoder fec forward error correction burst packet
+ *
+ * |param parity[Parity Bytes] The number of parity bytes per codeword.
+ * The code corrects up to parity/2 byte errors per codeword.
+ * |default 32
+ *
+ * |param dataLength[Data Length] The maximum number of data bytes per codeword.
+ * The data length is limited to 255 minus the number of parity bytes.
+ * |default 223
+ *
+ * |param fieldPoly[Field Polynomial] The primitive polynomial of GF(2^8).
+ * |option [0x11d: x^8+x^4+x^3+x^2+1] 285
+ * |option [0x187: x^8+x^7+x^2+x+1] 391
+ * |default 285
+ * |widget ComboBox(editable=true)
+ * |preview valid
+ *
+ * |param firstRoot[First Root] The log of the first consecutive root of the generator polynomial.
+ * |default 0
+ * |preview valid
+ *
+ * |param rootStep[Root Step] The generator roots are the powers alpha^((firstRoot+i)*rootStep).
+ * The root step must be coprime with 255.
+ * |default 1
+ * |preview valid
+ *
+ * |param frameStartId[Frame Start ID] The label ID that marks the first byte of a frame.
+ * |default "frameStart"
+ * |widget StringEntry()
+ *
+ * |param frameEndId[Frame End ID] The label ID that marks the last byte of a frame.
+ * The frame end label is only needed when the frame start label has no length.
+ * |default ""
+ * |widget StringEntry()
+ * |preview valid
+ *
+ * |factory /comms/rs_decoder()
+ * |setter setParity(parity)
+ * |setter setDataLength(dataLength)
+ * |setter setFieldPolynomial(fieldPoly)
+ * |setter setFirstRoot(firstRoot)
+ * |setter setRootStep(rootStep)
+ * |setter setFrameStartId(frameStartId)
+ * |setter setFrameEndId(frameEndId)
+ **********************************************************************/
+class ReedSolomonDecoder : public FrameBlock
+{
+public:
+    static Block *make(void)
+    {
+        return new ReedSolomonDecoder();
+    }
+
+    ReedSolomonDecoder(void):
+        FrameBlock(typeid(unsigned char), typeid(unsigned char)),
+        _parity(32),
+        _dataLength(223),
+        _fieldPoly(0x11d),
+        _firstRoot(0),
+        _rootStep(1),
+        _correctedCount(0),
+        _errorCount(0)
+    {
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonDecoder, setParity));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonDecoder, getParity));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonDecoder, setDataLength));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonDecoder, getDataLength));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonDecoder, setFieldPolynomial));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonDecoder, getFieldPolynomial));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonDecoder, setFirstRoot));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonDecoder, getFirstRoot));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonDecoder, setRootStep));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonDecoder, getRootStep));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonDecoder, getCorrectedCount));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonDecoder, getErrorCount));
+        this->registerProbe("getCorrectedCount");
+        this->registerProbe("getErrorCount");
+    }
+
+    void setParity(const size_t parity)
+    {
+        this->updateCode(parity, _fieldPoly, _firstRoot, _rootStep);
+    }
+
+    size_t getParity(void) const
+    {
+        return _parity;
+    }
+
+    void setDataLength(const size_t length)
+    {
+        if (length == 0) throw Pothos::InvalidArgumentException("ReedSolomonDecoder::setDataLength()", "data length cannot be zero");
+        _dataLength = length;
+    }
+
+    size_t getDataLength(void) const
+    {
+        return _dataLength;
+    }
+
+    void setFieldPolynomial(const unsigned poly)
+    {
+        this->updateCode(_parity, poly, _firstRoot, _rootStep);
+    }
+
+    unsigned getFieldPolynomial(void) const
+    {
+        return _fieldPoly;
+    }
+
+    void setFirstRoot(const unsigned root)
+    {
+        this->updateCode(_parity, _fieldPoly, root, _rootStep);
+    }
+
+    unsigned getFirstRoot(void) const
+    {
+        return _firstRoot;
+    }
+
+    void setRootStep(const unsigned step)
+    {
+        this->updateCode(_parity, _fieldPoly, _firstRoot, step);
+    }
+
+    unsigned getRootStep(void) const
+    {
+        return _rootStep;
+    }
+
+    //! The number of corrected bytes
+    unsigned long long getCorrectedCount(void) const
+    {
+        return _correctedCount;
+    }
+
+    //! The number of frames dropped for uncorrectable codewords
+    unsigned long long getErrorCount(void) const
+    {
+        return _errorCount;
+    }
+
+protected:
+    bool processFrame(const Pothos::BufferChunk &in, Pothos::BufferChunk &out)
+    {
+        const size_t len = in.length;
+        if (len == 0) return false;
+
+        //the last codeword must hold more than the parity bytes
+        const size_t nr = _code.numRoots();
+        const size_t n = std::min(_dataLength + nr, size_t(ReedSolomonCode::NN));
+        const size_t numCodewords = (len + n - 1)/n;
+        if (len - (numCodewords-1)*n <= nr)
+        {
+            _errorCount++;
+            return false;
+        }
+        out = Pothos::BufferChunk(this->outType(), len - numCodewords*nr);
+
+        const uint8_t *cwIn = in.as<const uint8_t *>();
+        uint8_t *data = out.as<uint8_t *>();
+        unsigned long long corrected = 0;
+        uint8_t cw[ReedSolomonCode::NN];
+        for (size_t i = 0; i < len; i += n)
+        {
+            const size_t m = std::min(n, len - i);
+            std::memcpy(cw, cwIn + i, m);
+            const int r = _code.decode(cw, m);
+            if (r < 0)
+            {
+                _errorCount++;
+                return false;
+            }
+            corrected += r;
+            std::memcpy(data, cw, m - nr);
+            data += m - nr;
+        }
+        _correctedCount += corrected;
+        return true;
+    }
+
+private:
+    void updateCode(const size_t parity, const unsigned poly, const unsigned firstRoot, const unsigned rootStep)
+    {
+        ReedSolomonCode code;
+        code.setup("ReedSolomonDecoder::updateCode()", parity, poly, firstRoot, rootStep);
+        _code = code;
+        _parity = parity;
+        _fieldPoly = poly;
+        _firstRoot = firstRoot;
+        _rootStep = rootStep;
+    }
+
+    ReedSolomonCode _code;
+    size_t _parity;
+    size_t _dataLength;
+    unsigned _fieldPoly;
+    unsigned _firstRoot;
+    unsigned _rootStep;
+    unsigned long long _correctedCount;
+    unsigned long long _errorCount;
+};
+
+static Pothos::BlockRegistry registerReedSolomonDecoder(
+    "/comms/rs_decoder", &ReedSolomonDecoder::make);
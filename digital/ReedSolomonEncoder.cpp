@@ -0,0 +1,204 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ReedSolomon.hpp"
+#include "common/FrameBlock.hpp"
+#include <Pothos/Framework.hpp>
+#include <cstdint>
+#include <cstring> //memcpy
+#include <algorithm> //min/max
+
+/***********************************************************************
+ * |PothosDoc Reed-Solomon Encoder
+ *
+ * Encode frames of bytes with a Reed-Solomon code over GF(2^8),
+ * like the RS(255, 223) code used for burst-error channels.
+ * Use the Reed-Solomon Decoder block with the same parameters to decode.
+ *
+ * Each frame is split into codewords of up to dataLength bytes,
+ * and the parity bytes are appended to the data of each codeword.
+ * The last codeword of a frame is shortened when the frame length
+ * is not a multiple of the data length.
+ * A frame of L bytes becomes L + ceil(L/dataLength)*parity bytes.
+ *
+ * <h2>Frames</h2>
+ * Input port 0 accepts packets, such as the output of the Simple MAC block,
+ * and the encoded packets keep the metadata of the input packets.
+ * Input port 0 also accepts a byte stream where each frame begins
+ * at the frame start label, labeled like bursts in the FIR Filter block:
+ * the frame start label holds the frame length, or the frame ends at the frame end label.
+ * Encoded frames are posted with frame start and frame end labels
+ * that hold the encoded frame length.
+ * Bytes outside of a frame and the other labels are dropped.
+ *
+ * |category /Digital
+ * |category /Coding
+ * |keywords reed solomon rs encoder fec forward error correction burst packet
+ *
+ * |param parity[Parity Bytes] The number of parity bytes per codeword.
+ * The code corrects up to parity/2 byte errors per codeword.
+ * |default 32
+ *
+ * |param dataLength[Data Length] The maximum number of data bytes per codeword.
+ * The data length is limited to 255 minus the number of parity bytes.
+ * |default 223
+ *
+ * |param fieldPoly[Field Polynomial] The primitive polynomial of GF(2^8).
+ * |option [0x11d: x^8+x^4+x^3+x^2+1] 285
+ * |option [0x187: x^8+x^7+x^2+x+1] 391
+ * |default 285
+ * |widget ComboBox(editable=true)
+ * |preview valid
+ *
+ * |param firstRoot[First Root] The log of the first consecutive root of the generator polynomial.
+ * |default 0
+ * |preview valid
+ *
+ * |param rootStep[Root Step] The generator roots are the powers alpha^((firstRoot+i)*rootStep).
+ * The root step must be coprime with 255.
+ * |default 1
+ * |preview valid
+ *
+ * |param frameStartId[Frame Start ID] The label ID that marks the first byte of a frame.
+ * |default "frameStart"
+ * |widget StringEntry()
+ *
+ * |param frameEndId[Frame End ID] The label ID that marks the last byte of a frame.
+ * The frame end label is only needed when the frame start label has no length.
+ * |default ""
+ * |widget StringEntry()
+ * |preview valid
+ *
+ * |factory /comms/rs_encoder()
+ * |setter setParity(parity)
+ * |setter setDataLength(dataLength)
+ * |setter setFieldPolynomial(fieldPoly)
+ * |setter setFirstRoot(firstRoot)
+ * |setter setRootStep(rootStep)
+ * |setter setFrameStartId(frameStartId)
+ * |setter setFrameEndId(frameEndId)
+ **********************************************************************/
+class ReedSolomonEncoder : public FrameBlock
+{
+public:
+    static Block *make(void)
+    {
+        return new ReedSolomonEncoder();
+    }
+
+    ReedSolomonEncoder(void):
+        FrameBlock(typeid(unsigned char), typeid(unsigned char)),
+        _parity(32),
+        _dataLength(223),
+        _fieldPoly(0x11d),
+        _firstRoot(0),
+        _rootStep(1)
+    {
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonEncoder, setParity));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonEncoder, getParity));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonEncoder, setDataLength));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonEncoder, getDataLength));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonEncoder, setFieldPolynomial));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonEncoder, getFieldPolynomial));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonEncoder, setFirstRoot));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonEncoder, getFirstRoot));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonEncoder, setRootStep));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ReedSolomonEncoder, getRootStep));
+    }
+
+    void setParity(const size_t parity)
+    {
+        this->updateCode(parity, _fieldPoly, _firstRoot, _rootStep);
+    }
+
+    size_t getParity(void) const
+    {
+        return _parity;
+    }
+
+    void setDataLength(const size_t length)
+    {
+        if (length == 0) throw Pothos::InvalidArgumentException("ReedSolomonEncoder::setDataLength()", "data length cannot be zero");
+        _dataLength = length;
+    }
+
+    size_t getDataLength(void) const
+    {
+        return _dataLength;
+    }
+
+    void setFieldPolynomial(const unsigned poly)
+    {
+        this->updateCode(_parity, poly, _firstRoot, _rootStep);
+    }
+
+    unsigned getFieldPolynomial(void) const
+    {
+        return _fieldPoly;
+    }
+
+    void setFirstRoot(const unsigned root)
+    {
+        this->updateCode(_parity, _fieldPoly, root, _rootStep);
+    }
+
+    unsigned getFirstRoot(void) const
+    {
+        return _firstRoot;
+    }
+
+    void setRootStep(const unsigned step)
+    {
+        this->updateCode(_parity, _fieldPoly, _firstRoot, step);
+    }
+
+    unsigned getRootStep(void) const
+    {
+        return _rootStep;
+    }
+
+protected:
+    bool processFrame(const Pothos::BufferChunk &in, Pothos::BufferChunk &out)
+    {
+        const size_t len = in.length;
+        if (len == 0) return false;
+
+        const size_t nr = _code.numRoots();
+        const size_t k = std::min(_dataLength, ReedSolomonCode::NN - nr);
+        const size_t numCodewords = (len + k - 1)/k;
+        out = Pothos::BufferChunk(this->outType(), len + numCodewords*nr);
+
+        const uint8_t *data = in.as<const uint8_t *>();
+        uint8_t *cw = out.as<uint8_t *>();
+        for (size_t i = 0; i < len; i += k)
+        {
+            const size_t n = std::min(k, len - i);
+            std::memcpy(cw, data + i, n);
+            _code.encode(cw, n, cw + n);
+            cw += n + nr;
+        }
+        return true;
+    }
+
+private:
+    void updateCode(const size_t parity, const unsigned poly, const unsigned firstRoot, const unsigned rootStep)
+    {
+        ReedSolomonCode code;
+        code.setup("ReedSolomonEncoder::updateCode()", parity, poly, firstRoot, rootStep);
+        _code = code;
+        _parity = parity;
+        _fieldPoly = poly;
+        _firstRoot = firstRoot;
+        _rootStep = rootStep;
+    }
+
+    ReedSolomonCode _code;
+    size_t _parity;
+    size_t _dataLength;
+    unsigned _fieldPoly;
+    unsigned _firstRoot;
+    unsigned _rootStep;
+};
+
+static Pothos::BlockRegistry registerReedSolomonEncoder(
+    "/comms/rs_encoder", &ReedSolomonEncoder::make);
@@ -1,7 +1,7 @@
 // Copyright (c) 2015-2015 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
-#include "lfsr.h"
+#include "LFSRTable.hpp"
 #include <Pothos/Framework.hpp>
 #include <iostream>
 #include <cstring>
@@ -28,10 +28,22 @@
  * |param seed[Seed]
  * |default 0x1
  *
+ * |param packing[Packing] The bit packing of the input and output streams.
+ * Unpacked streams carry one bit per byte in the LSB.
+ * Packed streams carry 8 bits per byte, from the MSB or from the LSB first,
+ * like the bit order of the Bytes to Symbols block. The packed mode avoids
+ * unpacking bytes into bits and repacking them around the scrambler.
+ * Labels stay on the byte that holds the bit they annotate.
+ * |option [Unpacked] "unpacked"
+ * |option [Packed MSBit first] "MSBit"
+ * |option [Packed LSBit first] "LSBit"
+ * |default "unpacked"
+ *
  * |factory /comms/scrambler()
  * |setter setPoly(poly)
  * |setter setMode(mode)
  * |setter setSeed(seed)
+ * |setter setPacking(packing)
  **********************************************************************/
 struct Scrambler : public Pothos::Block
 {
@@ -41,7 +53,7 @@ struct Scrambler : public Pothos::Block
     }
 
     Scrambler(void):
-        _polynom(1), _seed_value(1)
+        _polynom(1), _seed_value(1), _packing(UNPACKED)
     {
         std::memset(&_lfsr, 0, sizeof(_lfsr));
         this->setupInput(0, typeid(unsigned char));
@@ -52,6 +64,8 @@ struct Scrambler : public Pothos::Block
         this->registerCall(this, POTHOS_FCN_TUPLE(Scrambler, seed));
         this->registerCall(this, POTHOS_FCN_TUPLE(Scrambler, setMode));
         this->registerCall(this, POTHOS_FCN_TUPLE(Scrambler, mode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Scrambler, setPacking));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Scrambler, packing));
         this->registerCall(this, POTHOS_FCN_TUPLE(Scrambler, setSync));
         this->registerCall(this, POTHOS_FCN_TUPLE(Scrambler, sync));
 
@@ -65,6 +79,7 @@ struct Scrambler : public Pothos::Block
     {
         _polynom = polynomial;
         GLFSR_init(&_lfsr, _polynom, _seed_value);
+        this->updateTable();
     }
 
     int64_t poly(void) const
@@ -88,6 +103,7 @@ struct Scrambler : public Pothos::Block
         if (mode == "additive") _mode = MODE_ADD;
         else if (mode == "multiplicative") _mode = MODE_MULT;
         else throw Pothos::InvalidArgumentException("Scrambler::set_mode()", "unknown mode: " + mode);
+        this->updateTable();
     }
 
     std::string mode(void) const
@@ -96,6 +112,21 @@ struct Scrambler : public Pothos::Block
         else return "multiplicative";
     }
 
+    void setPacking(const std::string &packing)
+    {
+        if (packing == "unpacked") _packing = UNPACKED;
+        else if (packing == "MSBit") _packing = PACKED_MSBIT;
+        else if (packing == "LSBit") _packing = PACKED_LSBIT;
+        else throw Pothos::InvalidArgumentException("Scrambler::setPacking()", "unknown packing: " + packing);
+    }
+
+    std::string packing(void) const
+    {
+        if (_packing == PACKED_MSBIT) return "MSBit";
+        if (_packing == PACKED_LSBIT) return "LSBit";
+        return "unpacked";
+    }
+
     void setSync(const std::string &sync_word)
     {
         _sync_word = sync_word;
@@ -121,36 +152,25 @@ struct Scrambler : public Pothos::Block
         return _sync_word;
     }
 
+    //! The tables depend on the polynomial and mode, not the seed
+    void updateTable(void)
+    {
+        _table.init(_lfsr, (_mode == MODE_ADD)?LFSRTable::ADDITIVE:LFSRTable::SCRAMBLE);
+    }
+
     void work(void);
-    unsigned char additive_bit_work(const unsigned char in);
-    unsigned char multiplicative_bit_work(const unsigned char in);
 
     lfsr_t _lfsr;
+    LFSRTable _table;
     lfsr_data_t _polynom;
     lfsr_data_t _seed_value;
     enum {MODE_ADD, MODE_MULT} _mode;
+    enum {UNPACKED, PACKED_MSBIT, PACKED_LSBIT} _packing;
     std::string _sync_word;
     std::vector<unsigned char> _sync_bits;
     long _count_down_to_sync_word;
 };
 
-unsigned char Scrambler::additive_bit_work(const unsigned char in)
-{
-    const unsigned char ret = GLFSR_next(&_lfsr);
-    const unsigned char out = in ^ ret;
-    return out;
-}
-
-unsigned char Scrambler::multiplicative_bit_work(const unsigned char in)
-{
-    const unsigned char ret = GLFSR_next(&_lfsr);
-    const unsigned char out = in ^ ret;
-    //output bit becomes the next bit0
-    _lfsr.data &= ~lfsr_data_t(0x1);
-    _lfsr.data |= out;
-    return out;
-}
-
 void Scrambler::work(void)
 {
     auto inPort = this->input(0);
@@ -160,21 +180,10 @@ void Scrambler::work(void)
     const unsigned char *in = inPort->buffer();
     unsigned char *out = outPort->buffer();
 
-    //The main work loop deals with input bit by bit.
-    if (_mode == MODE_ADD)
-    {
-        for (size_t i = 0; i < n; i++)
-        {
-            out[i] = this->additive_bit_work(in[i] & 0x1);
-        }
-    }
-    if (_mode == MODE_MULT)
-    {
-        for (size_t i = 0; i < n; i++)
-        {
-            out[i] = this->multiplicative_bit_work(in[i] & 0x1);
-        }
-    }
+    //The table driven LFSR steps 8 or 64 bits at a time.
+    //Packed bytes map 1:1 onto output bytes, so labels keep their index.
+    if (_packing == UNPACKED) _table.process(_lfsr, in, out, n);
+    else _table.processPacked(_lfsr, in, out, n, _packing == PACKED_MSBIT);
 
     inPort->consume(n);
     outPort->produce(n);
@@ -0,0 +1,362 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <cstdint>
+#include <complex>
+#include <vector>
+#include <cmath> //log2/round
+#include <algorithm> //min/max/copy
+
+/***********************************************************************
+ * |PothosDoc Soft Demapper
+ *
+ * Demap an incoming stream of constellation samples into soft bits.
+ * For every input sample, the output is one log-likelihood ratio (LLR)
+ * for each bit of the symbol index, using the max-log approximation:
+ *
+ * llr[b] = (min|in - map[s]|^2 over s with bit b set - min|in - map[s]|^2 over s with bit b clear) / noiseVar
+ *
+ * A positive LLR means that the bit is more likely a 0,
+ * and the magnitude is the confidence of the decision.
+ * For real input types, the noise variance is per dimension and the LLR is halved.
+ *
+ * The search evaluates the distance to each point once, then finds the minimum
+ * for each bit by repeatedly folding the distances in half, which costs about
+ * three operations per point for all of the bits together. Several input samples
+ * are searched at a time, so the inner loops are unit stride over the samples and vectorize.
+ *
+ * |category /Digital
+ * |category /Symbol
+ * |keywords symbol soft demapper llr decision
+ *
+ * |param dtype[Data Type] The input data type consumed by the demapper.
+ * |widget DTypeChooser(float=1,cfloat=1)
+ * |default "complex_float32"
+ * |preview disable
+ *
+ * |param outType[Output Type] The data type of the output LLRs.
+ * Int8 LLRs are rounded and saturated to [-127, 127].
+ * |option [Float32] "float32"
+ * |option [Int8] "int8"
+ * |default "float32"
+ * |preview disable
+ *
+ * |param map[Symbol Map] The symbol map is a list of constellation points,
+ * in the same format as the symbol mapper and symbol slicer.
+ * This must be a power-of-two in length; e.g. 2, 4, 8...
+ * |default [-1, 1]
+ * |option [BPSK] \[-1, 1\]
+ * |option [QPSK] \[-1.0-1.0*j, -1.0+1.0*j, 1.0+1.0*j, 1.0-1.0*j\]
+ * |widget ComboBox(editable=true)
+ *
+ * |param bitOrder[Bit Order] The order of the output LLRs for the bits of each symbol index.
+ * MSBit outputs the most significant bit first, like the symbols to bits block.
+ * |option [MSBit] "MSBit"
+ * |option [LSBit] "LSBit"
+ * |default "MSBit"
+ *
+ * |param noiseVar[Noise Variance] The variance of the noise on the input samples.
+ * |default 1.0
+ *
+ * |param scale[LLR Scale] A factor applied to the LLRs before they are written.
+ * Use it to fit the int8 range.
+ * |default 1.0
+ *
+ * |param labelId[Label ID] A optional label ID that can be used to change the noise variance.
+ * Upstream blocks such as an SNR estimator can pass the noise variance along with the stream data.
+ * The demapper searches input labels for an ID match and interprets the label data as the new noise variance.
+ * |preview valid
+ * |default ""
+ * |widget StringEntry()
+ * |tab Labels
+ *
+ * |factory /comms/soft_demapper(dtype, outType)
+ * |setter setMap(map)
+ * |setter setBitOrder(bitOrder)
+ * |setter setNoiseVariance(noiseVar)
+ * |setter setScale(scale)
+ * |setter setLabelId(labelId)
+ **********************************************************************/
+template <typename T>
+struct DemapperTraits
+{
+    typedef T RealType;
+    static const bool isComplex = false;
+    static RealType re(const T &x) {return x;}
+    static RealType im(const T &) {return 0;}
+};
+
+template <typename T>
+struct DemapperTraits<std::complex<T>>
+{
+    typedef T RealType;
+    static const bool isComplex = true;
+    static RealType re(const std::complex<T> &x) {return x.real();}
+    static RealType im(const std::complex<T> &x) {return x.imag();}
+};
+
+//! Write a float LLR
+template <typename RealType>
+static inline void storeLLR(const RealType llr, float &out)
+{
+    out = float(llr);
+}
+
+//! Write an int8 LLR with rounding and saturation
+template <typename RealType>
+static inline void storeLLR(const RealType llr, int8_t &out)
+{
+    out = int8_t(std::round(std::max(RealType(-127), std::min(RealType(127), llr))));
+}
+
+template <typename InType, typename OutType>
+class SoftDemapper : public Pothos::Block
+{
+    typedef DemapperTraits<InType> Traits;
+    typedef typename Traits::RealType RealType;
+
+public:
+    SoftDemapper(void):
+        _nbits(0),
+        _msbFirst(true),
+        _noiseVar(1.0),
+        _scale(1.0)
+    {
+        this->setupInput(0, typeid(InType));
+        this->setupOutput(0, typeid(OutType));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftDemapper, getMap));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftDemapper, setMap));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftDemapper, setBitOrder));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftDemapper, getBitOrder));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftDemapper, setNoiseVariance));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftDemapper, getNoiseVariance));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftDemapper, setScale));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftDemapper, getScale));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftDemapper, setLabelId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftDemapper, getLabelId));
+        this->setMap(std::vector<InType>{InType(-1), InType(1)}); //initial update
+    }
+
+    std::vector<InType> getMap(void) const
+    {
+        return _map;
+    }
+
+    void setMap(const std::vector<InType> &map)
+    {
+        if (map.size() < 2) throw Pothos::InvalidArgumentException("SoftDemapper::setMap()", "Map must have at least 2 points");
+        if (map.size() > 256) throw Pothos::InvalidArgumentException("SoftDemapper::setMap()", "Map must have at most 256 points");
+        const auto nbits = std::log2(map.size());
+        if (nbits != int(nbits))
+        {
+            throw Pothos::InvalidArgumentException("SoftDemapper::setMap()", "Map must be a power of two in length");
+        }
+        _map = map;
+        _nbits = size_t(nbits);
+
+        //split coordinates for the search
+        _mapRe.resize(map.size());
+        _mapIm.resize(map.size());
+        for (size_t j = 0; j < map.size(); j++)
+        {
+            _mapRe[j] = Traits::re(map[j]);
+            _mapIm[j] = Traits::im(map[j]);
+        }
+        _dist.resize(map.size()*LANES);
+    }
+
+    void setBitOrder(const std::string &order)
+    {
+        if (order == "MSBit") _msbFirst = true;
+        else if (order == "LSBit") _msbFirst = false;
+        else throw Pothos::InvalidArgumentException("SoftDemapper::setBitOrder()", "Order must be LSBit or MSBit");
+    }
+
+    std::string getBitOrder(void) const
+    {
+        return _msbFirst?"MSBit":"LSBit";
+    }
+
+    void setNoiseVariance(const double noiseVar)
+    {
+        if (not (noiseVar > 0.0)) throw Pothos::InvalidArgumentException("SoftDemapper::setNoiseVariance()", "Noise variance must be positive");
+        _noiseVar = noiseVar;
+    }
+
+    double getNoiseVariance(void) const
+    {
+        return _noiseVar;
+    }
+
+    void setScale(const double scale)
+    {
+        _scale = scale;
+    }
+
+    double getScale(void) const
+    {
+        return _scale;
+    }
+
+    void setLabelId(const std::string &id)
+    {
+        _labelId = id;
+    }
+
+    std::string getLabelId(void) const
+    {
+        return _labelId;
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+
+        //each input sample produces nbits outputs
+        size_t elems = std::min(inPort->elements(), outPort->elements()/_nbits);
+        if (elems == 0) return;
+
+        //check the labels for the noise variance
+        if (not _labelId.empty()) for (const auto &label : inPort->labels())
+        {
+            if (label.index >= elems) break; //ignore labels past input bounds
+            if (label.id == _labelId)
+            {
+                //only set the noise variance when the label is at the front
+                if (label.index == 0)
+                {
+                    this->setNoiseVariance(label.data.template convert<double>());
+                }
+                //otherwise stop processing before the next label
+                //on the next call, this label will be index 0
+                else
+                {
+                    elems = label.index;
+                    break;
+                }
+            }
+        }
+
+        const InType *in = inPort->buffer();
+        OutType *out = outPort->buffer();
+        this->demap(in, out, elems);
+
+        inPort->consume(elems);
+        outPort->produce(elems*_nbits);
+    }
+
+    void propagateLabels(const Pothos::InputPort *port)
+    {
+        auto outputPort = this->output(0);
+        for (const auto &label : port->labels())
+        {
+            outputPort->postLabel(label.toAdjusted(_nbits, 1));
+        }
+    }
+
+private:
+    //! Number of input samples searched together
+    static const size_t LANES = 8;
+    static const size_t MAX_BITS = 8;
+
+    void demap(const InType *in, OutType *out, const size_t num)
+    {
+        const size_t M = _map.size();
+        const RealType llrScale = RealType(_scale/_noiseVar/(Traits::isComplex?1.0:2.0));
+        RealType *D = _dist.data();
+
+        for (size_t n = 0; n < num; n += LANES)
+        {
+            //load a block of samples, the last block repeats its last sample
+            const size_t L = std::min(size_t(LANES), num-n);
+            RealType xr[LANES], xi[LANES];
+            for (size_t l = 0; l < LANES; l++)
+            {
+                const InType &x = in[n + std::min(l, L-1)];
+                xr[l] = Traits::re(x);
+                xi[l] = Traits::im(x);
+            }
+
+            //the distance from each sample to every point
+            for (size_t j = 0; j < M; j++)
+            {
+                for (size_t l = 0; l < LANES; l++)
+                {
+                    const RealType dr = xr[l] - _mapRe[j], di = xi[l] - _mapIm[j];
+                    D[j*LANES+l] = dr*dr + di*di;
+                }
+            }
+
+            //From the top bit down, the lower half of the points has the bit clear
+            //and the upper half has it set. Folding the halves with min leaves the
+            //minimum over each value of the lower bits, so every bit costs half the last.
+            RealType min0[MAX_BITS][LANES], min1[MAX_BITS][LANES];
+            for (size_t b = _nbits; b-- > 0;)
+            {
+                const size_t half = size_t(1) << b;
+                RealType *lo = D, *hi = D + half*LANES;
+                RealType m0[LANES], m1[LANES];
+                for (size_t l = 0; l < LANES; l++)
+                {
+                    m0[l] = lo[l];
+                    m1[l] = hi[l];
+                }
+                for (size_t j = 0; j < half; j++)
+                {
+                    for (size_t l = 0; l < LANES; l++)
+                    {
+                        const RealType a = lo[j*LANES+l], c = hi[j*LANES+l];
+                        m0[l] = std::min(m0[l], a);
+                        m1[l] = std::min(m1[l], c);
+                        lo[j*LANES+l] = std::min(a, c);
+                    }
+                }
+                std::copy(m0, m0+LANES, min0[b]);
+                std::copy(m1, m1+LANES, min1[b]);
+            }
+
+            //write nbits LLRs per sample in the bit order
+            for (size_t l = 0; l < L; l++)
+            {
+                OutType *o = out + (n+l)*_nbits;
+                for (size_t b = 0; b < _nbits; b++)
+                {
+                    const size_t pos = _msbFirst?(_nbits-1-b):b;
+                    storeLLR((min1[b][l] - min0[b][l])*llrScale, o[pos]);
+                }
+            }
+        }
+    }
+
+    std::vector<InType> _map;
+    std::vector<RealType> _mapRe, _mapIm;
+    std::vector<RealType> _dist; //distances for a block of samples
+    size_t _nbits;
+    bool _msbFirst;
+    double _noiseVar;
+    double _scale;
+    std::string _labelId;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *SoftDemapperFactory(const Pothos::DType &dtype, const Pothos::DType &outType)
+{
+    #define ifTypeDeclareFactory_(type, outT) \
+        if (dtype == Pothos::DType(typeid(type)) and outType == Pothos::DType(typeid(outT))) \
+            return new SoftDemapper<type, outT>();
+    #define ifTypeDeclareFactory(type) \
+        ifTypeDeclareFactory_(type, float) \
+        ifTypeDeclareFactory_(type, int8_t) \
+        ifTypeDeclareFactory_(std::complex<type>, float) \
+        ifTypeDeclareFactory_(std::complex<type>, int8_t)
+    ifTypeDeclareFactory(double);
+    ifTypeDeclareFactory(float);
+    throw Pothos::InvalidArgumentException("SoftDemapperFactory("+dtype.toString()+", "+outType.toString()+")", "unsupported types");
+}
+
+static Pothos::BlockRegistry registerSoftDemapper(
+    "/comms/soft_demapper", &SoftDemapperFactory);
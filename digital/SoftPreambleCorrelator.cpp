@@ -0,0 +1,319 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <complex>
+#include <vector>
+#include <algorithm> //min/fill
+
+/***********************************************************************
+ * |PothosDoc Soft Preamble Correlator
+ *
+ * The Soft Preamble Correlator searches an input sample stream on port 0
+ * for a matching preamble and forwards the stream to output port 0
+ * with a label annotating the first symbol after the preamble match.
+ *
+ * Unlike the hard decision preamble correlator, the input is not sliced.
+ * Each window of input samples is correlated against the preamble template,
+ * and the correlation is normalized by the energy of the template and the window:
+ *
+ * rho = |sum(conj(preamble[i])*in[n+i])| / sqrt(sum(|preamble[i]|^2)*sum(|in[n+i]|^2))
+ *
+ * The normalized correlation is independent of the input amplitude,
+ * and it is 1.0 for an exact match, even in the presence of a gain.
+ * For complex streams the magnitude is used, so a match is detected
+ * regardless of the carrier phase. For real streams the correlation
+ * must be positive, so an inverted preamble does not match.
+ *
+ * |category /Digital
+ * |keywords soft symbol preamble correlate
+ *
+ * |param dtype[Data Type] The input data type consumed by the correlator.
+ * |widget DTypeChooser(float=1,cfloat=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param preamble A vector of symbols representing the preamble.
+ * Usually the preamble is a bipolar sequence of +1 and -1 values,
+ * but any complex template can be used for complex streams.
+ * |default [1, 1, -1]
+ * |option [Barker Code 5] \[1, 1, 1, -1, 1\]
+ * |option [Barker Code 7] \[1, 1, 1, -1, -1, 1, -1\]
+ * |option [Barker Code 13] \[1, 1, 1, 1, 1, -1, -1, 1, 1, -1, 1, -1, 1\]
+ * |widget ComboBox(editable=true)
+ *
+ * |param thresh[Threshold] The threshold for the normalized correlation in [0.0, 1.0].
+ * A window that correlates at or above the threshold is a preamble match.
+ * |default 0.8
+ *
+ * |param frameStartId[Frame Start ID] The label ID that marks the first symbol of a correlator match.
+ * |default "frameStart"
+ * |widget StringEntry()
+ *
+ * |factory /comms/soft_preamble_correlator(dtype)
+ * |setter setPreamble(preamble)
+ * |setter setThreshold(thresh)
+ * |setter setFrameStartId(frameStartId)
+ **********************************************************************/
+template <typename Type>
+struct SoftCorrelatorTraits
+{
+    typedef Type RealType;
+
+    //! Number of window positions correlated together
+    static const size_t LANES = 4;
+
+    /*!
+     * Correlate a template against M consecutive windows of the input,
+     * and sum the energy of each window in the same pass.
+     * Each lane is one window position, so the lane loop is unit stride,
+     * the sums stay in registers, and it vectorizes without reordering
+     * any floating point sums.
+     */
+    static void correlate(const Type *tmpl, const size_t P, const Type *in, const size_t M, Type *corr, Type *energy)
+    {
+        size_t m = 0;
+        for (; m+LANES <= M; m += LANES)
+        {
+            Type acc[LANES] = {}, pow[LANES] = {};
+            for (size_t i = 0; i < P; i++)
+            {
+                const Type t = tmpl[i];
+                const Type *x = in+m+i;
+                for (size_t l = 0; l < LANES; l++)
+                {
+                    acc[l] += t*x[l];
+                    pow[l] += x[l]*x[l];
+                }
+            }
+            for (size_t l = 0; l < LANES; l++)
+            {
+                corr[m+l] = acc[l];
+                energy[m+l] = pow[l];
+            }
+        }
+        for (; m < M; m++)
+        {
+            corr[m] = 0;
+            energy[m] = 0;
+            for (size_t i = 0; i < P; i++)
+            {
+                corr[m] += tmpl[i]*in[m+i];
+                energy[m] += in[m+i]*in[m+i];
+            }
+        }
+    }
+
+    //! Correlation power, an inverted match does not count
+    static double power(const Type corr)
+    {
+        return (corr > 0)?double(corr)*corr:0.0;
+    }
+
+    static Type conj(const Type x)
+    {
+        return x;
+    }
+};
+
+template <typename Type>
+struct SoftCorrelatorTraits<std::complex<Type>>
+{
+    typedef Type RealType;
+
+    static const size_t LANES = 4;
+
+    //! Correlate a conjugated template against M consecutive windows of the input
+    static void correlate(const std::complex<Type> *tmpl, const size_t P, const std::complex<Type> *in, const size_t M, std::complex<Type> *corr, Type *energy)
+    {
+        size_t m = 0;
+        for (; m+LANES <= M; m += LANES)
+        {
+            Type accRe[LANES] = {}, accIm[LANES] = {}, pow[LANES] = {};
+            for (size_t i = 0; i < P; i++)
+            {
+                const Type tr = tmpl[i].real(), ti = tmpl[i].imag();
+                const std::complex<Type> *x = in+m+i;
+                for (size_t l = 0; l < LANES; l++)
+                {
+                    const Type xr = x[l].real(), xi = x[l].imag();
+                    accRe[l] += tr*xr - ti*xi;
+                    accIm[l] += tr*xi + ti*xr;
+                    pow[l] += xr*xr + xi*xi;
+                }
+            }
+            for (size_t l = 0; l < LANES; l++)
+            {
+                corr[m+l] = std::complex<Type>(accRe[l], accIm[l]);
+                energy[m+l] = pow[l];
+            }
+        }
+        for (; m < M; m++)
+        {
+            Type accRe = 0, accIm = 0, pow = 0;
+            for (size_t i = 0; i < P; i++)
+            {
+                const Type tr = tmpl[i].real(), ti = tmpl[i].imag();
+                const Type xr = in[m+i].real(), xi = in[m+i].imag();
+                accRe += tr*xr - ti*xi;
+                accIm += tr*xi + ti*xr;
+                pow += xr*xr + xi*xi;
+            }
+            corr[m] = std::complex<Type>(accRe, accIm);
+            energy[m] = pow;
+        }
+    }
+
+    //! Correlation power, any carrier phase counts
+    static double power(const std::complex<Type> corr)
+    {
+        return std::norm(std::complex<double>(corr));
+    }
+
+    static std::complex<Type> conj(const std::complex<Type> x)
+    {
+        return std::conj(x);
+    }
+};
+
+template <typename Type>
+class SoftPreambleCorrelator : public Pothos::Block
+{
+    typedef SoftCorrelatorTraits<Type> Traits;
+
+public:
+    SoftPreambleCorrelator(void):
+        _threshold(0),
+        _preambleEnergy(0),
+        _corr(BLOCK),
+        _energy(BLOCK)
+    {
+        this->setupInput(0, typeid(Type));
+        this->setupOutput(0, typeid(Type), this->uid()); //unique domain because of buffer forwarding
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftPreambleCorrelator, setPreamble));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftPreambleCorrelator, getPreamble));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftPreambleCorrelator, setThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftPreambleCorrelator, getThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftPreambleCorrelator, setFrameStartId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftPreambleCorrelator, getFrameStartId));
+        this->setPreamble(std::vector<Type>{1, 1, -1}); //initial update
+        this->setThreshold(0.8); //initial update
+        this->setFrameStartId("frameStart"); //initial update
+    }
+
+    void setPreamble(const std::vector<Type> preamble)
+    {
+        if (preamble.empty()) throw Pothos::InvalidArgumentException("SoftPreambleCorrelator::setPreamble()", "preamble cannot be empty");
+        double energy = 0;
+        for (const auto &sym : preamble) energy += std::norm(sym);
+        if (energy == 0) throw Pothos::InvalidArgumentException("SoftPreambleCorrelator::setPreamble()", "preamble cannot be all zeros");
+        _preamble = preamble;
+        _preambleEnergy = energy;
+
+        //store the conjugate template for the dot product
+        _template.resize(preamble.size());
+        for (size_t i = 0; i < preamble.size(); i++) _template[i] = Traits::conj(preamble[i]);
+    }
+
+    std::vector<Type> getPreamble(void) const
+    {
+        return _preamble;
+    }
+
+    void setThreshold(const double threshold)
+    {
+        if (threshold < 0.0 or threshold > 1.0) throw Pothos::InvalidArgumentException("SoftPreambleCorrelator::setThreshold()", "threshold must be in [0.0, 1.0]");
+        _threshold = threshold;
+    }
+
+    double getThreshold(void) const
+    {
+        return _threshold;
+    }
+
+    void setFrameStartId(std::string id)
+    {
+        _frameStartId = id;
+    }
+
+    std::string getFrameStartId(void) const
+    {
+        return _frameStartId;
+    }
+
+    //! always use a circular buffer to avoid discontinuity over sliding window
+    Pothos::BufferManager::Sptr getInputBufferManager(const std::string &, const std::string &)
+    {
+        return Pothos::BufferManager::make("circular");
+    }
+
+    void work(void)
+    {
+        auto inputPort = this->input(0);
+        auto outputPort = this->output(0);
+        const size_t P = _preamble.size();
+
+        //require preamble size + 1 elements to perform processing
+        inputPort->setReserve(P+1);
+        auto buffer = inputPort->takeBuffer();
+        const size_t numElems = buffer.elements();
+        if (numElems <= P) return;
+
+        //due to search window, the last preamble size elements are used
+        //consume and forward all processable elements of the input buffer
+        const size_t N = numElems - P;
+        buffer.length = N*sizeof(Type);
+        inputPort->consume(N);
+
+        //Correlate in blocks of positions and compare the squared normalized correlation:
+        //|corr|^2 >= thresh^2 * preambleEnergy * windowEnergy
+        //The window energy is summed exactly for each position rather than as a running sum,
+        //which loses precision when a quiet window follows a loud one.
+        const Type *in = buffer;
+        const double scale = _threshold*_threshold*_preambleEnergy;
+        for (size_t n = 0; n < N; n += BLOCK)
+        {
+            const size_t M = std::min(N-n, size_t(BLOCK));
+            Traits::correlate(_template.data(), P, in+n, M, _corr.data(), _energy.data());
+            for (size_t m = 0; m < M; m++)
+            {
+                if (_energy[m] > 0 and Traits::power(_corr[m]) >= scale*_energy[m])
+                {
+                    outputPort->postLabel(_frameStartId, Pothos::Object(), n + m + P);
+                }
+            }
+        }
+
+        outputPort->postBuffer(std::move(buffer));
+    }
+
+private:
+    double _threshold;
+    double _preambleEnergy;
+    std::string _frameStartId;
+    std::vector<Type> _preamble;
+    std::vector<Type> _template;
+
+    //correlation and window energy for a block of positions
+    static const size_t BLOCK = 256;
+    std::vector<Type> _corr;
+    std::vector<typename Traits::RealType> _energy;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *SoftPreambleCorrelatorFactory(const Pothos::DType &dtype)
+{
+    #define ifTypeDeclareFactory(type) \
+        if (dtype == Pothos::DType(typeid(type))) \
+            return new SoftPreambleCorrelator<type>(); \
+        if (dtype == Pothos::DType(typeid(std::complex<type>))) \
+            return new SoftPreambleCorrelator<std::complex<type>>();
+    ifTypeDeclareFactory(double);
+    ifTypeDeclareFactory(float);
+    throw Pothos::InvalidArgumentException("SoftPreambleCorrelatorFactory("+dtype.toString()+")", "unsupported type");
+}
+
+static Pothos::BlockRegistry registerSoftPreambleCorrelator(
+    "/comms/soft_preamble_correlator", &SoftPreambleCorrelatorFactory);
@@ -2,15 +2,18 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #pragma once
+#include "common/CpuFeatures.hpp"
 #include <cstdlib>
 #include <cstddef>
+#include <cstdint>
+#include <cstring> //memcpy
 
 typedef enum {LSBit, MSBit} BitOrder;
 
 /***********************************************************************
  * Pack bits into arbitrary width symbols
  **********************************************************************/
-static inline void bitsToSymbolsMSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
+static inline void bitsToSymbolsMSBitScalar(const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
 {
     const unsigned char sampleBit = 0x1;
     for (size_t i = 0; i < numSyms; i++)
@@ -25,7 +28,7 @@ static inline void bitsToSymbolsMSBit(const size_t width, const unsigned char *i
     }
 }
 
-static inline void bitsToSymbolsLSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
+static inline void bitsToSymbolsLSBitScalar(const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
 {
     const unsigned char sampleBit = 1 << (width - 1);
     for (size_t i = 0; i < numSyms; i++)
@@ -43,7 +46,7 @@ static inline void bitsToSymbolsLSBit(const size_t width, const unsigned char *i
 /***********************************************************************
  * Unpack arbitrary width symbols into bits
  **********************************************************************/
-static inline void symbolsToBitsMSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
+static inline void symbolsToBitsMSBitScalar(const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
 {
     const unsigned char sampleBit = 1 << (width - 1);
     for (size_t i = 0; i < numSyms; i++)
@@ -57,7 +60,7 @@ static inline void symbolsToBitsMSBit(const size_t width, const unsigned char *i
     }
 }
 
-static inline void symbolsToBitsLSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
+static inline void symbolsToBitsLSBitScalar(const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
 {
     const unsigned char sampleBit = 0x1;
     for (size_t i = 0; i < numSyms; i++)
@@ -74,7 +77,7 @@ static inline void symbolsToBitsLSBit(const size_t width, const unsigned char *i
 /***********************************************************************
  * Pack arbitrary width symbols into bytes (MSBit order)
  **********************************************************************/
-static inline void symbolsToBytesMSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
+static inline void symbolsToBytesMSBitScalar(const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
 {
     switch (width)
     {
@@ -152,7 +155,7 @@ static inline void symbolsToBytesMSBit(const size_t width, const unsigned char *
 /***********************************************************************
  * Pack arbitrary width symbols into bytes (LSBit order)
  **********************************************************************/
-static inline void symbolsToBytesLSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
+static inline void symbolsToBytesLSBitScalar(const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
 {
     switch (width)
     {
@@ -230,7 +233,7 @@ static inline void symbolsToBytesLSBit(const size_t width, const unsigned char *
 /***********************************************************************
  * Unpack bytes into arbitrary width symbols (MSBit order)
  **********************************************************************/
-static inline void bytesToSymbolsMSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
+static inline void bytesToSymbolsMSBitScalar(const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
 {
     switch (width)
     {
@@ -323,7 +326,7 @@ static inline void bytesToSymbolsMSBit(const size_t width, const unsigned char *
 /***********************************************************************
  * Unpack bytes into arbitrary width symbols (LSBit order)
  **********************************************************************/
-static inline void bytesToSymbolsLSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
+static inline void bytesToSymbolsLSBitScalar(const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
 {
     switch (width)
     {
@@ -412,3 +415,260 @@ static inline void bytesToSymbolsLSBit(const size_t width, const unsigned char *
         break;
     }
 }
+
+/***********************************************************************
+ * SIMD kernels
+ *
+ * A group of 8 symbols of width bits occupies exactly width bytes,
+ * so BMI2 pdep/pext convert a whole group with one instruction:
+ * pdep spreads the packed bits into the low bits of 8 bytes,
+ * and pext gathers them back. MSBit order swaps the byte order
+ * of the group around the conversion. Conversions to and from
+ * bits pack or unpack each byte of the group with one more pext/pdep.
+ *
+ * Width 1 is the common bit stream case, AVX2 converts 32 bits
+ * at a time with a byte shuffle and a compare or a movemask.
+ **********************************************************************/
+#ifdef CPU_FEATURES_X86
+
+//! The low width bits of each of the first numBytes bytes
+static inline uint64_t symbolLaneMask(const size_t width, const size_t numBytes = 8)
+{
+    const uint64_t lanes = (numBytes == 8)?~uint64_t(0):((uint64_t(1) << (8*numBytes))-1);
+    return (0x0101010101010101ull*((1u << width)-1)) & lanes;
+}
+
+//! The top bit of each byte is set when the byte is non-zero
+static inline uint64_t nonZeroBytes(const uint64_t x)
+{
+    const uint64_t low = 0x7f7f7f7f7f7f7f7full;
+    return (((x & low) + low) | x) & ~low;
+}
+
+//! Unpack numBytes bytes into 8 bits each, returns the number of bytes done
+__attribute__((target("avx2")))
+static inline size_t unpackBitsAVX2(const bool msb, const unsigned char *in, unsigned char *out, const size_t numBytes)
+{
+    //each byte of the 4 input bytes is broadcast to 8 output bytes, one bit per byte
+    const __m256i spread = _mm256_setr_epi8(
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+        2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i bits = msb?
+        _mm256_set1_epi64x(0x0102040810204080ll):
+        _mm256_set1_epi64x(0x8040201008040201ll);
+    const __m256i one = _mm256_set1_epi8(1);
+    size_t i = 0;
+    for (; i+4 <= numBytes; i += 4)
+    {
+        int32_t word;
+        std::memcpy(&word, in+i, sizeof(word));
+        const __m256i x = _mm256_shuffle_epi8(_mm256_set1_epi32(word), spread);
+        const __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(x, bits), bits);
+        _mm256_storeu_si256((__m256i *)(out+8*i), _mm256_and_si256(set, one));
+    }
+    return i;
+}
+
+//! Pack 8 bits into each of numBytes bytes, returns the number of bytes done
+__attribute__((target("avx2")))
+static inline size_t packBitsAVX2(const bool msb, const unsigned char *in, unsigned char *out, const size_t numBytes)
+{
+    //movemask takes the first bit of a group into the LSB, MSBit order reverses each group first
+    const __m256i reverse = _mm256_setr_epi8(
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i+4 <= numBytes; i += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(in+8*i));
+        if (msb) x = _mm256_shuffle_epi8(x, reverse);
+        const uint32_t word = ~uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, zero)));
+        std::memcpy(out+i, &word, sizeof(word));
+    }
+    return i;
+}
+
+//! Unpack a group of width bytes into 8 symbols, one per byte
+__attribute__((target("bmi2")))
+static inline uint64_t unpackGroupBMI2(const bool msb, const size_t width, uint64_t group)
+{
+    group &= symbolLaneMask(8, width);
+    if (msb) group = __builtin_bswap64(group) >> (8*(8-width));
+    const uint64_t syms = _pdep_u64(group, symbolLaneMask(width));
+    return msb?__builtin_bswap64(syms):syms;
+}
+
+//! Pack 8 symbols, one per byte, into a group of width bytes
+__attribute__((target("bmi2")))
+static inline uint64_t packGroupBMI2(const bool msb, const size_t width, uint64_t syms)
+{
+    if (msb) syms = __builtin_bswap64(syms);
+    const uint64_t group = _pext_u64(syms, symbolLaneMask(width));
+    return msb?__builtin_bswap64(group << (8*(8-width))):group;
+}
+
+//! Unpack groups of width bytes into 8 symbols each, returns the number of bytes done
+__attribute__((target("bmi2")))
+static inline size_t bytesToSymbolsBMI2(const bool msb, const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
+{
+    size_t i = 0;
+    for (; i+8 <= numBytes; i += width)
+    {
+        uint64_t group;
+        std::memcpy(&group, in+i, sizeof(group));
+        const uint64_t syms = unpackGroupBMI2(msb, width, group);
+        std::memcpy(out, &syms, sizeof(syms));
+        out += 8;
+    }
+    return i;
+}
+
+//! Pack groups of 8 symbols into width bytes each, returns the number of bytes done
+__attribute__((target("bmi2")))
+static inline size_t symbolsToBytesBMI2(const bool msb, const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
+{
+    size_t i = 0;
+    for (; i+8 <= numBytes; i += width)
+    {
+        uint64_t syms;
+        std::memcpy(&syms, in, sizeof(syms));
+        in += 8;
+        const uint64_t group = packGroupBMI2(msb, width, syms);
+        std::memcpy(out+i, &group, sizeof(group)); //the next group overwrites the extra bytes
+    }
+    return i;
+}
+
+//! Pack groups of 8 symbols from bits, a bit is set when its byte is non-zero, returns the number of symbols done
+__attribute__((target("bmi2")))
+static inline size_t bitsToSymbolsBMI2(const bool msb, const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
+{
+    size_t i = 0;
+    for (; i+8 <= numSyms; i += 8)
+    {
+        //pack the 8*width bits into a group of width bytes
+        uint64_t group = 0;
+        for (size_t b = 0; b < width; b++)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, in, sizeof(bits));
+            in += 8;
+            bits = nonZeroBytes(bits);
+            if (msb) bits = __builtin_bswap64(bits);
+            group |= _pext_u64(bits, 0x8080808080808080ull) << (8*b);
+        }
+        const uint64_t syms = unpackGroupBMI2(msb, width, group);
+        std::memcpy(out+i, &syms, sizeof(syms));
+    }
+    return i;
+}
+
+//! Unpack groups of 8 symbols into bits, returns the number of symbols done
+__attribute__((target("bmi2")))
+static inline size_t symbolsToBitsBMI2(const bool msb, const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
+{
+    size_t i = 0;
+    for (; i+8 <= numSyms; i += 8)
+    {
+        uint64_t syms;
+        std::memcpy(&syms, in+i, sizeof(syms));
+        const uint64_t group = packGroupBMI2(msb, width, syms);
+
+        //unpack each byte of the group into 8 bits
+        for (size_t b = 0; b < width; b++)
+        {
+            uint64_t bits = _pdep_u64(group >> (8*b), 0x0101010101010101ull);
+            if (msb) bits = __builtin_bswap64(bits);
+            std::memcpy(out, &bits, sizeof(bits));
+            out += 8;
+        }
+    }
+    return i;
+}
+
+#endif //CPU_FEATURES_X86
+
+/***********************************************************************
+ * Runtime dispatch: the SIMD kernels convert what they can,
+ * and the scalar implementations above convert the remainder.
+ **********************************************************************/
+static inline void bitsToSymbolsMSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
+{
+    size_t done = 0;
+    #ifdef CPU_FEATURES_X86
+    if (width == 8 and CpuFeatures::avx2()) done = packBitsAVX2(true, in, out, numSyms);
+    else if (CpuFeatures::bmi2()) done = bitsToSymbolsBMI2(true, width, in, out, numSyms);
+    #endif
+    bitsToSymbolsMSBitScalar(width, in+done*width, out+done, numSyms-done);
+}
+
+static inline void bitsToSymbolsLSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
+{
+    size_t done = 0;
+    #ifdef CPU_FEATURES_X86
+    if (width == 8 and CpuFeatures::avx2()) done = packBitsAVX2(false, in, out, numSyms);
+    else if (CpuFeatures::bmi2()) done = bitsToSymbolsBMI2(false, width, in, out, numSyms);
+    #endif
+    bitsToSymbolsLSBitScalar(width, in+done*width, out+done, numSyms-done);
+}
+
+static inline void symbolsToBitsMSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
+{
+    size_t done = 0;
+    #ifdef CPU_FEATURES_X86
+    if (width == 8 and CpuFeatures::avx2()) done = unpackBitsAVX2(true, in, out, numSyms);
+    else if (CpuFeatures::bmi2()) done = symbolsToBitsBMI2(true, width, in, out, numSyms);
+    #endif
+    symbolsToBitsMSBitScalar(width, in+done, out+done*width, numSyms-done);
+}
+
+static inline void symbolsToBitsLSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numSyms)
+{
+    size_t done = 0;
+    #ifdef CPU_FEATURES_X86
+    if (width == 8 and CpuFeatures::avx2()) done = unpackBitsAVX2(false, in, out, numSyms);
+    else if (CpuFeatures::bmi2()) done = symbolsToBitsBMI2(false, width, in, out, numSyms);
+    #endif
+    symbolsToBitsLSBitScalar(width, in+done, out+done*width, numSyms-done);
+}
+
+static inline void symbolsToBytesMSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
+{
+    size_t done = 0;
+    #ifdef CPU_FEATURES_X86
+    if (width == 1 and CpuFeatures::avx2()) done = packBitsAVX2(true, in, out, numBytes);
+    else if (width != 8 and CpuFeatures::bmi2()) done = symbolsToBytesBMI2(true, width, in, out, numBytes);
+    #endif
+    symbolsToBytesMSBitScalar(width, in+(done*8)/width, out+done, numBytes-done);
+}
+
+static inline void symbolsToBytesLSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
+{
+    size_t done = 0;
+    #ifdef CPU_FEATURES_X86
+    if (width == 1 and CpuFeatures::avx2()) done = packBitsAVX2(false, in, out, numBytes);
+    else if (width != 8 and CpuFeatures::bmi2()) done = symbolsToBytesBMI2(false, width, in, out, numBytes);
+    #endif
+    symbolsToBytesLSBitScalar(width, in+(done*8)/width, out+done, numBytes-done);
+}
+
+static inline void bytesToSymbolsMSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
+{
+    size_t done = 0;
+    #ifdef CPU_FEATURES_X86
+    if (width == 1 and CpuFeatures::avx2()) done = unpackBitsAVX2(true, in, out, numBytes);
+    else if (width != 8 and CpuFeatures::bmi2()) done = bytesToSymbolsBMI2(true, width, in, out, numBytes);
+    #endif
+    bytesToSymbolsMSBitScalar(width, in+done, out+(done*8)/width, numBytes-done);
+}
+
+static inline void bytesToSymbolsLSBit(const size_t width, const unsigned char *in, unsigned char *out, const size_t numBytes)
+{
+    size_t done = 0;
+    #ifdef CPU_FEATURES_X86
+    if (width == 1 and CpuFeatures::avx2()) done = unpackBitsAVX2(false, in, out, numBytes);
+    else if (width != 8 and CpuFeatures::bmi2()) done = bytesToSymbolsBMI2(false, width, in, out, numBytes);
+    #endif
+    bytesToSymbolsLSBitScalar(width, in+done, out+(done*8)/width, numBytes-done);
+}
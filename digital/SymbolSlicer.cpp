@@ -7,7 +7,8 @@
 #include <complex>
 #include <vector>
 #include <cfloat> //FLT_MAX
-#include <algorithm> //min/max
+#include <cmath>
+#include <algorithm> //min/max/sort/unique
 
 /***********************************************************************
  * |PothosDoc Symbol Slicer
@@ -15,8 +16,16 @@
  * Slice an incoming stream of elements into binary symbols using Euclidean distance.
  * The output is the symbol index of the closest value in the map.
  *
- * This slicer is O(len(map)) and suboptimal for simple (BPSK, QPSK) constellations, but
- * has the advantage that it will work for any arbitrary constellation.
+ * Regular maps are sliced in constant time per element:
+ * <ul>
+ * <li>A map whose points form a uniformly spaced rectangular grid in any order
+ * (PAM, BPSK, QPSK, rectangular QAM) is sliced by quantizing each axis.</li>
+ * <li>A complex map whose points are equally spaced around a circle in any order
+ * (M-PSK) is sliced by quantizing the phase angle.</li>
+ * </ul>
+ * Any other map is sliced by computing the distance to every point,
+ * which is O(len(map)) but works for any arbitrary constellation.
+ * On an exact tie, the lowest index of the closest values is output.
  *
  * |category /Digital
  * |category /Symbol
@@ -39,23 +48,64 @@
  * |setter setMap(map)
  **********************************************************************/
 
+//! Real and imaginary parts of real and complex types
 template <typename T>
-float euclidDist(T inA, T inB)
+struct SlicerTraits
 {
-    return std::abs(inB - inA);
-}
+    static const bool isComplex = false;
+    static double re(const T &x) {return double(x);}
+    static double im(const T &) {return 0.0;}
+};
 
 template <typename T>
-float euclidDist(std::complex<T> inA, std::complex<T> inB)
+struct SlicerTraits<std::complex<T>>
+{
+    static const bool isComplex = true;
+    static double re(const std::complex<T> &x) {return double(x.real());}
+    static double im(const std::complex<T> &x) {return double(x.imag());}
+};
+
+//! Sorted unique values with a uniform spacing, false when irregular
+static bool uniformAxis(std::vector<double> &values, double &spacing)
+{
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    spacing = 1.0;
+    if (values.size() < 2) return true;
+    spacing = (values.back() - values.front())/(values.size()-1);
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        if (std::abs(values[i] - (values.front() + i*spacing)) > 1e-6*spacing) return false;
+    }
+    return true;
+}
+
+/*!
+ * Quantize a value to the nearest of n uniformly spaced points.
+ * On an exact tie between two points, tie is the upper point,
+ * otherwise tie is the same as the returned index.
+ */
+static size_t quantize(const double t, const size_t n, size_t &tie)
 {
-    return powf(inB.real()-inA.real(), 2) + powf(inB.imag()-inA.imag(), 2);
+    if (n == 1 or not (t > 0)) return (tie = 0);
+    if (t >= n-1) return (tie = n-1);
+    const double lo = std::floor(t);
+    const double frac = t - lo;
+    const size_t i = size_t(lo);
+    tie = (frac >= 0.5)?i+1:i;
+    return (frac > 0.5)?i+1:i;
 }
 
 template <typename InType>
 class SymbolSlicer : public Pothos::Block
 {
+    typedef SlicerTraits<InType> Traits;
+
 public:
-    SymbolSlicer(void)
+    SymbolSlicer(void):
+        _method(SLICE_SEARCH),
+        _x0(0.0), _dx(1.0), _y0(0.0), _dy(1.0),
+        _nx(1), _ny(1)
     {
         this->setupInput(0, typeid(InType));
         this->setupOutput(0, typeid(unsigned char));
@@ -73,6 +123,21 @@ public:
     {
         if(map.size() == 0) throw Pothos::InvalidArgumentException("SymbolSlicer::setMap()", "Map must be nonzero size");
         _map = map;
+
+        //split coordinates for the distance search
+        _mapRe.resize(map.size());
+        _mapIm.resize(map.size());
+        _dist.resize(map.size());
+        for (size_t j = 0; j < map.size(); j++)
+        {
+            _mapRe[j] = float(Traits::re(map[j]));
+            _mapIm[j] = float(Traits::im(map[j]));
+        }
+
+        //pick the constant time method for regular maps
+        if (this->detectGrid()) _method = SLICE_GRID;
+        else if (Traits::isComplex and this->detectPSK()) _method = SLICE_PSK;
+        else _method = SLICE_SEARCH;
     }
 
     void work(void)
@@ -85,16 +150,11 @@ public:
 
         unsigned int N = std::min(inPort->elements(), outPort->elements());
 
-        for(unsigned int i=0; i<N; i++) {
-            std::pair<unsigned char, float> mindist = std::make_pair(0, FLT_MAX);
-            for(unsigned int j=0; j<_map.size(); j++) {
-                float dist = euclidDist(in[i], _map[j]);
-                if(dist < mindist.second)
-                {
-                    mindist = std::make_pair(j, dist);
-                }
-            }
-            out[i] = mindist.first;
+        switch (_method)
+        {
+        case SLICE_GRID: for(unsigned int i=0; i<N; i++) out[i] = this->sliceGrid(in[i]); break;
+        case SLICE_PSK: for(unsigned int i=0; i<N; i++) out[i] = this->slicePSK(in[i]); break;
+        case SLICE_SEARCH: for(unsigned int i=0; i<N; i++) out[i] = this->sliceSearch(in[i]); break;
         }
 
         inPort->consume(N);
@@ -102,7 +162,124 @@ public:
     }
 
 private:
+
+    /*!
+     * Detect a map that is a uniform nx by ny grid in any order.
+     * The grid table holds the map index of each grid point.
+     */
+    bool detectGrid(void)
+    {
+        std::vector<double> xs, ys;
+        for (const auto &point : _map)
+        {
+            xs.push_back(Traits::re(point));
+            ys.push_back(Traits::im(point));
+        }
+        if (not uniformAxis(xs, _dx) or not uniformAxis(ys, _dy)) return false;
+        if (xs.size()*ys.size() != _map.size()) return false;
+        _x0 = xs.front(); _nx = xs.size();
+        _y0 = ys.front(); _ny = ys.size();
+
+        //every grid point must be in the map once
+        _table.assign(_nx*_ny, 0);
+        std::vector<bool> found(_nx*_ny, false);
+        for (size_t j = 0; j < _map.size(); j++)
+        {
+            size_t tx, ty;
+            const size_t k = quantize((Traits::re(_map[j]) - _x0)/_dx, _nx, tx) + _nx*quantize((Traits::im(_map[j]) - _y0)/_dy, _ny, ty);
+            if (found[k]) return false;
+            found[k] = true;
+            _table[k] = j;
+        }
+        return true;
+    }
+
+    /*!
+     * Detect a complex map of points with equal magnitude,
+     * equally spaced in phase, in any order.
+     * The table holds the map index for each multiple of the spacing.
+     */
+    bool detectPSK(void)
+    {
+        const size_t M = _map.size();
+        if (M < 2) return false;
+        const double r = std::hypot(Traits::re(_map[0]), Traits::im(_map[0]));
+        if (r == 0.0) return false;
+        _x0 = std::atan2(Traits::im(_map[0]), Traits::re(_map[0]));
+        _dx = 2*M_PI/M;
+
+        _table.assign(M, 0);
+        std::vector<bool> found(M, false);
+        for (size_t j = 0; j < M; j++)
+        {
+            const double x = Traits::re(_map[j]), y = Traits::im(_map[j]);
+            if (std::abs(std::hypot(x, y) - r) > 1e-6*r) return false;
+            const double t = (std::atan2(y, x) - _x0)/_dx;
+            const double k = std::round(t);
+            if (std::abs(t - k) > 1e-6) return false;
+            const size_t bucket = size_t(long(k) + long(M)) % M;
+            if (found[bucket]) return false;
+            found[bucket] = true;
+            _table[bucket] = j;
+        }
+        return true;
+    }
+
+    //! Quantize each axis, the min over the tie points is the lowest index on an exact tie
+    unsigned char sliceGrid(const InType &x) const
+    {
+        size_t tx, ty;
+        const size_t ix = quantize((Traits::re(x) - _x0)/_dx, _nx, tx);
+        const size_t iy = quantize((Traits::im(x) - _y0)/_dy, _ny, ty);
+        return std::min(
+            std::min(_table[ix + _nx*iy], _table[tx + _nx*iy]),
+            std::min(_table[ix + _nx*ty], _table[tx + _nx*ty]));
+    }
+
+    //! Quantize the phase into one of M buckets, the origin is equally close to every point
+    unsigned char slicePSK(const InType &x) const
+    {
+        const double re = Traits::re(x), im = Traits::im(x);
+        if (re == 0.0 and im == 0.0) return 0;
+        const size_t M = _table.size();
+        double t = (std::atan2(im, re) - _x0)/_dx;
+        if (t < 0) t += M;
+        const double lo = std::floor(t);
+        const double frac = t - lo;
+        const size_t i = size_t(lo) + ((frac > 0.5)?1:0);
+        const size_t tie = size_t(lo) + ((frac >= 0.5)?1:0);
+        return std::min(_table[i % M], _table[tie % M]);
+    }
+
+    //! Squared distance to every point, then the first minimum
+    unsigned char sliceSearch(const InType &x)
+    {
+        const float re = float(Traits::re(x)), im = float(Traits::im(x));
+        const size_t M = _map.size();
+        for (size_t j = 0; j < M; j++)
+        {
+            const float dr = _mapRe[j] - re, di = _mapIm[j] - im;
+            _dist[j] = dr*dr + di*di;
+        }
+        std::pair<unsigned char, float> mindist = std::make_pair(0, FLT_MAX);
+        for (size_t j = 0; j < M; j++)
+        {
+            if (_dist[j] < mindist.second) mindist = std::make_pair(j, _dist[j]);
+        }
+        return mindist.first;
+    }
+
     std::vector<InType> _map;
+
+    enum {SLICE_SEARCH, SLICE_GRID, SLICE_PSK} _method;
+
+    //grid origin and spacing, or PSK phase origin and spacing in _x0 and _dx
+    double _x0, _dx, _y0, _dy;
+    size_t _nx, _ny;
+    std::vector<unsigned char> _table;
+
+    //split coordinates and distances for the distance search
+    std::vector<float> _mapRe, _mapIm, _dist;
 };
 
 /***********************************************************************
@@ -0,0 +1,96 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+
+static const std::vector<std::vector<int>> testPunctures{
+    {1, 1}, {1, 1, 1, 0}, {1, 1, 1, 0, 0, 1}, {1, 1, 1, 0, 0, 1, 1, 0, 0, 1}};
+
+POTHOS_TEST_BLOCK("/comms/tests", test_conv_encoder_viterbi_decoder)
+{
+    const size_t depth = 96;
+    const size_t numBits = 5000;
+    const size_t numPad = depth + 16; //flushes the bits out of the decoder
+
+    for (const auto &polys : std::vector<std::vector<int>>{{0171, 0133}, {0561, 0753}, {023, 035}})
+    {
+        for (const auto &puncture : testPunctures)
+        {
+            std::cout << "polys " << polys[0] << ", " << polys[1] << " puncture length " << puncture.size() << std::endl;
+
+            //random bits followed by zeros
+            auto b0 = Pothos::BufferChunk("uint8", numBits+numPad);
+            auto p0 = b0.as<unsigned char *>();
+            for (size_t i = 0; i < b0.elements(); i++) p0[i] = (i < numBits)?(std::rand() & 0x1):0;
+
+            auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+            auto encoder = Pothos::BlockRegistry::make("/comms/conv_encoder");
+            auto coded = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+            auto decoder = Pothos::BlockRegistry::make("/comms/viterbi_decoder", "uint8");
+            auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+            encoder.call("setPolynomials", polys);
+            encoder.call("setPuncture", puncture);
+            decoder.call("setPolynomials", polys);
+            decoder.call("setPuncture", puncture);
+            decoder.call("setTracebackDepth", depth);
+            feeder.call("feedBuffer", b0);
+
+            //hard decisions without errors decode exactly
+            {
+                Pothos::Topology topology;
+                topology.connect(feeder, 0, encoder, 0);
+                topology.connect(encoder, 0, coded, 0);
+                topology.connect(encoder, 0, decoder, 0);
+                topology.connect(decoder, 0, collector, 0);
+                topology.commit();
+                POTHOS_TEST_TRUE(topology.waitInactive());
+            }
+
+            Pothos::BufferChunk codedBuff = coded.call("getBuffer");
+            size_t numCoded = 0;
+            for (size_t i = 0; i < 2*(numBits+numPad); i++)
+            {
+                if (puncture[i % puncture.size()] != 0) numCoded++;
+            }
+            POTHOS_TEST_EQUAL(codedBuff.elements(), numCoded);
+
+            Pothos::BufferChunk buff = collector.call("getBuffer");
+            POTHOS_TEST_TRUE(buff.elements() >= numBits);
+            POTHOS_TEST_EQUALA(buff.as<const unsigned char *>(), p0, numBits);
+
+            //soft decisions with sparse weak errors decode exactly
+            if (puncture.size() != 2) continue;
+            auto llrs = Pothos::BufferChunk("float32", codedBuff.elements());
+            auto codedBits = codedBuff.as<const unsigned char *>();
+            for (size_t i = 0; i < llrs.elements(); i++)
+            {
+                float llr = (codedBits[i] != 0)?-1.0f:1.0f;
+                if ((i % 37) == 11) llr = -0.5f*llr;
+                llrs.as<float *>()[i] = llr;
+            }
+
+            auto softFeeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "float32");
+            auto softDecoder = Pothos::BlockRegistry::make("/comms/viterbi_decoder", "float32");
+            auto softCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+            softDecoder.call("setPolynomials", polys);
+            softDecoder.call("setTracebackDepth", depth);
+            softFeeder.call("feedBuffer", llrs);
+            {
+                Pothos::Topology topology;
+                topology.connect(softFeeder, 0, softDecoder, 0);
+                topology.connect(softDecoder, 0, softCollector, 0);
+                topology.commit();
+                POTHOS_TEST_TRUE(topology.waitInactive());
+            }
+
+            Pothos::BufferChunk softBuff = softCollector.call("getBuffer");
+            POTHOS_TEST_TRUE(softBuff.elements() >= numBits);
+            POTHOS_TEST_EQUALA(softBuff.as<const unsigned char *>(), p0, numBits);
+        }
+    }
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "common/Crc.hpp"
+#include "common/Testing.hpp"
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <iostream>
+#include <cstdlib>
+#include <cstring> //memcpy
+#include <map>
+#include <vector>
+
+POTHOS_TEST_BLOCK("/comms/tests", test_crc_packets)
+{
+    //the standard check input "123456789"
+    auto p0 = Pothos::Packet();
+    p0.payload = Pothos::BufferChunk("uint8", 9);
+    std::memcpy(p0.payload.as<void *>(), "123456789", 9);
+    p0.metadata["recipient"] = Pothos::Object(42);
+
+    //a jumbo packet for the folded CRC
+    auto p1 = Pothos::Packet();
+    p1.payload = Pothos::BufferChunk("uint8", 9000);
+    for (size_t i = 0; i < p1.payload.elements(); i++) p1.payload.as<unsigned char *>()[i] = std::rand() & 0xff;
+
+    auto append = Pothos::BlockRegistry::make("/comms/crc_append");
+    const auto codedPackets = CommsTests::runPacketChain("uint8", {p0, p1}, {append});
+
+    //the CRC-32 check value 0xcbf43926 is appended LSB first
+    POTHOS_TEST_EQUAL(codedPackets.size(), 2);
+    POTHOS_TEST_EQUAL(codedPackets[0].metadata.count("recipient"), 1);
+    POTHOS_TEST_EQUAL(codedPackets[0].payload.elements(), 13);
+    const std::vector<unsigned char> check{0x26, 0x39, 0xf4, 0xcb};
+    POTHOS_TEST_EQUALA(codedPackets[0].payload.as<const unsigned char *>() + 9, check.data(), check.size());
+    POTHOS_TEST_EQUAL(codedPackets[1].payload.elements(), 9004);
+
+    //a copy of the jumbo packet with one bit error is dropped
+    auto p2 = CommsTests::copyPacket(codedPackets[1]);
+    p2.payload.as<unsigned char *>()[4321] ^= 0x10;
+
+    auto checker = Pothos::BlockRegistry::make("/comms/crc_check");
+    const auto packets = CommsTests::runPacketChain("uint8", {codedPackets[0], codedPackets[1], p2}, {checker});
+    POTHOS_TEST_EQUAL(packets.size(), 2);
+    POTHOS_TEST_EQUAL(packets[0].metadata.count("recipient"), 1);
+    POTHOS_TEST_EQUAL(packets[0].payload.elements(), 9);
+    POTHOS_TEST_EQUALA(packets[0].payload.as<const unsigned char *>(), p0.payload.as<const unsigned char *>(), 9);
+    POTHOS_TEST_EQUAL(packets[1].payload.elements(), 9000);
+    POTHOS_TEST_EQUALA(packets[1].payload.as<const unsigned char *>(), p1.payload.as<const unsigned char *>(), 9000);
+    POTHOS_TEST_EQUAL(checker.call<unsigned long long>("getErrorCount"), 1);
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_crc_stream_frames)
+{
+    const std::vector<size_t> frameLengths{1, 100, 1000};
+    for (const auto &crc : {"CRC-8", "CRC-16/CCITT-FALSE", "CRC-32C"})
+    {
+        std::cout << "Testing " << crc << std::endl;
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+        auto append = Pothos::BlockRegistry::make("/comms/crc_append");
+        auto checker = Pothos::BlockRegistry::make("/comms/crc_check");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+        append.call("setCrc", crc);
+        checker.call("setCrc", crc);
+
+        //frames with the length in the start label, separated by filler bytes
+        const auto expected = CommsTests::feedLabeledFrames(feeder, frameLengths, 0xff, 0xff);
+        CommsTests::runBlockChain({feeder, append, checker, collector});
+
+        //the frames without filler bytes and crcs
+        Pothos::BufferChunk buff = collector.call("getBuffer");
+        POTHOS_TEST_EQUAL(buff.elements(), expected.size());
+        POTHOS_TEST_EQUALA(buff.as<const unsigned char *>(), expected.data(), expected.size());
+        CommsTests::testFrameStartLabels(collector.call<std::vector<Pothos::Label>>("getLabels"), frameLengths);
+        POTHOS_TEST_EQUAL(checker.call<unsigned long long>("getErrorCount"), 0);
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_crc_check_values)
+{
+    //the check values of "123456789" from the catalogue of parametrised CRC algorithms
+    const std::map<std::string, uint32_t> checkValues{
+        {"CRC-8", 0xf4},
+        {"CRC-8/MAXIM", 0xa1},
+        {"CRC-16/CCITT-FALSE", 0x29b1},
+        {"CRC-16/KERMIT", 0x2189},
+        {"CRC-16/ARC", 0xbb3d},
+        {"CRC-32", 0xcbf43926},
+        {"CRC-32C", 0xe3069283},
+        {"CRC-32/BZIP2", 0xfc891918},
+    };
+    POTHOS_TEST_EQUAL(CrcEngine::names().size(), checkValues.size());
+
+    //a long buffer for the folded CRC
+    std::vector<unsigned char> data(1000);
+    for (auto &x : data) x = std::rand() & 0xff;
+
+    for (const auto &name : CrcEngine::names())
+    {
+        std::cout << "Testing " << name << std::endl;
+        POTHOS_TEST_EQUAL(checkValues.count(name), 1);
+        const CrcEngine crc("test_crc_check_values", name);
+        POTHOS_TEST_EQUAL(crc.compute("123456789", 9), checkValues.at(name));
+
+        //the same CRC over many updates, and with the scalar tables only
+        const uint32_t expected = crc.compute(data.data(), data.size());
+        uint32_t reg = crc.start();
+        for (size_t i = 0; i < data.size(); i += 100) reg = crc.update(reg, data.data()+i, 100);
+        POTHOS_TEST_EQUAL(crc.finish(reg), expected);
+        {
+            CpuForceScalarScope scalar;
+            POTHOS_TEST_EQUAL(crc.compute(data.data(), data.size()), expected);
+        }
+
+        //the crc append block writes the check value in the CRC byte order
+        auto p0 = Pothos::Packet();
+        p0.payload = Pothos::BufferChunk("uint8", 9);
+        std::memcpy(p0.payload.as<void *>(), "123456789", 9);
+        auto append = Pothos::BlockRegistry::make("/comms/crc_append");
+        append.call("setCrc", name);
+        const auto packets = CommsTests::runPacketChain("uint8", {p0}, {append});
+        POTHOS_TEST_EQUAL(packets.size(), 1);
+        POTHOS_TEST_EQUAL(packets[0].payload.elements(), 9 + crc.bytes());
+        POTHOS_TEST_EQUAL(crc.load(packets[0].payload.as<const unsigned char *>() + 9), checkValues.at(name));
+    }
+}
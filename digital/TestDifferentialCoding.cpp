@@ -47,3 +47,37 @@ POTHOS_TEST_BLOCK("/comms/tests", test_differential_coding)
 
     std::cout << "done!\n";
 }
+
+POTHOS_TEST_BLOCK("/comms/tests", test_differential_coding_packed)
+{
+    for (const std::string bitOrder : {"MSBit", "LSBit"})
+    {
+        std::cout << "run the topology with packed " << bitOrder << " bits" << std::endl;
+
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+        auto encoder = Pothos::BlockRegistry::make("/comms/differential_encoder");
+        auto decoder = Pothos::BlockRegistry::make("/comms/differential_decoder");
+        encoder.call("setPacking", bitOrder);
+        decoder.call("setPacking", bitOrder);
+
+        //create a test plan, labels stay on their bytes
+        json testPlan;
+        testPlan["enableBuffers"] = true;
+        testPlan["enableLabels"] = true;
+
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, encoder, 0);
+        topology.connect(encoder, 0, decoder, 0);
+        topology.connect(decoder, 0, collector, 0);
+        topology.commit();
+
+        auto expected = feeder.call("feedTestPlan", testPlan.dump());
+        POTHOS_TEST_TRUE(topology.waitInactive());
+
+        std::cout << "verifyTestPlan!\n";
+        collector.call("verifyTestPlan", expected);
+    }
+
+    std::cout << "done!\n";
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "FrameHelper.hpp"
+#include <Pothos/Testing.hpp>
+#include <iostream>
+#include <cstdlib>
+
+POTHOS_TEST_BLOCK("/comms/tests", test_frame_header_codec)
+{
+    //every single bit error is corrected, every double bit error is detected
+    for (unsigned x = 0; x < 16; x++)
+    {
+        const uint8_t c = encodeHamming84(x);
+        bool error = false;
+        POTHOS_TEST_EQUAL(decodeHamming84(c, error), x);
+        POTHOS_TEST_TRUE(not error);
+        for (size_t i = 0; i < 8; i++)
+        {
+            POTHOS_TEST_EQUAL(decodeHamming84(uint8_t(c ^ (1 << i)), error), x);
+            POTHOS_TEST_TRUE(not error);
+            for (size_t j = i+1; j < 8; j++)
+            {
+                decodeHamming84(uint8_t(c ^ (1 << i) ^ (1 << j)), error);
+                POTHOS_TEST_TRUE(error);
+                error = false;
+            }
+        }
+    }
+
+    //the packed word and the bit buffer hold the same header
+    for (size_t n = 0; n < 100; n++)
+    {
+        FrameHeaderFields hdr;
+        hdr.id = std::rand() & 0xff;
+        hdr.length = std::rand() & 0xfff;
+        hdr.chksum = hdr.doChecksum();
+
+        char bits[NUM_HEADER_BITS];
+        encodeHeaderWord(bits, hdr);
+        const auto word = encodeHeaderPacked(hdr);
+        POTHOS_TEST_EQUAL(word >> NUM_HEADER_BITS, 0);
+        for (size_t i = 0; i < NUM_HEADER_BITS; i++)
+        {
+            POTHOS_TEST_EQUAL(int(bits[i]), int((word >> i) & 0x1));
+        }
+
+        //one bit error per codeword is corrected
+        uint64_t errWord = word;
+        for (size_t k = 0; k < 7; k++) errWord ^= uint64_t(1) << (2 + 8*k + std::rand()%8);
+        FrameHeaderFields out;
+        decodeHeaderPacked(errWord, out);
+        POTHOS_TEST_TRUE(not out.error);
+        POTHOS_TEST_EQUAL(out.id, hdr.id);
+        POTHOS_TEST_EQUAL(out.length, hdr.length);
+        POTHOS_TEST_EQUAL(out.chksum, hdr.chksum);
+
+        //two bit errors in one codeword are detected
+        const size_t k = 2 + 8*(n%7);
+        decodeHeaderPacked(word ^ (uint64_t(1) << (k + n%8)) ^ (uint64_t(1) << (k + (n+1)%8)), out);
+        POTHOS_TEST_TRUE(out.error);
+    }
+}
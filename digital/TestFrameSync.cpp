@@ -0,0 +1,280 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "FrameHelper.hpp"
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <iostream>
+#include <cstdlib>
+#include <cstring> //memcpy
+#include <complex>
+#include <vector>
+#include <random>
+#include <cmath>
+
+typedef std::complex<float> ComplexType;
+
+static const std::vector<ComplexType> testPreamble{1, 1, 1, -1, 1};
+static const size_t testSymbolWidth = 20;
+static const size_t testDataWidth = 4;
+
+/***********************************************************************
+ * Random QPSK payloads of the given lengths
+ **********************************************************************/
+static std::vector<std::vector<ComplexType>> makePayloads(const std::vector<size_t> &lengths)
+{
+    std::vector<std::vector<ComplexType>> payloads;
+    for (const auto length : lengths)
+    {
+        std::vector<ComplexType> payload(length);
+        for (auto &x : payload) x = ComplexType((std::rand()%2)?0.7f:-0.7f, (std::rand()%2)?0.7f:-0.7f);
+        payloads.push_back(payload);
+    }
+    return payloads;
+}
+
+/***********************************************************************
+ * Frame the payloads with the Frame Insert block at the symbol rate,
+ * with gap zero symbols before, between and after the frames
+ **********************************************************************/
+static Pothos::BufferChunk insertFrames(const std::vector<std::vector<ComplexType>> &payloads, const size_t gap)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "complex_float32");
+    auto inserter = Pothos::BlockRegistry::make("/comms/frame_insert", "complex_float32");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "complex_float32");
+    inserter.call("setPreamble", testPreamble);
+    inserter.call("setSymbolWidth", testSymbolWidth);
+
+    size_t total = gap;
+    for (const auto &payload : payloads) total += payload.size() + gap;
+    auto b0 = Pothos::BufferChunk("complex_float32", total);
+    auto pb0 = b0.as<ComplexType *>();
+    size_t index = 0;
+    for (const auto &payload : payloads)
+    {
+        for (size_t i = 0; i < gap; i++) pb0[index++] = 0;
+        feeder.call("feedLabel", Pothos::Label("frameStart", payload.size(), index));
+        feeder.call("feedLabel", Pothos::Label("frameEnd", payload.size(), index + payload.size() - 1));
+        std::memcpy(pb0 + index, payload.data(), payload.size()*sizeof(ComplexType));
+        index += payload.size();
+    }
+    for (size_t i = 0; i < gap; i++) pb0[index++] = 0;
+    feeder.call("feedBuffer", b0);
+
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, inserter, 0);
+        topology.connect(inserter, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+    return collector.call("getBuffer");
+}
+
+/***********************************************************************
+ * Channel: upsample to the data width with a triangle pulse,
+ * then apply a gain, a frequency and phase offset, and noise
+ **********************************************************************/
+static Pothos::BufferChunk applyChannel(const Pothos::BufferChunk &symbols, const double freqOffset, const float noise)
+{
+    const auto in = symbols.as<const ComplexType *>();
+    const size_t numSyms = symbols.elements();
+    auto out = Pothos::BufferChunk("complex_float32", numSyms*testDataWidth);
+    auto x = out.as<ComplexType *>();
+
+    std::mt19937 gen(42);
+    std::normal_distribution<float> awgn(0, noise);
+    for (size_t n = 0; n < numSyms*testDataWidth; n++)
+    {
+        const size_t k = n/testDataWidth;
+        const float frac = float(n%testDataWidth)/testDataWidth;
+        const ComplexType next = (k+1 < numSyms)?in[k+1]:ComplexType(0);
+        const ComplexType v = in[k]*(1-frac) + next*frac;
+        const float phase = float(std::fmod(freqOffset*double(n) + 0.3, 2*M_PI));
+        x[n] = v*std::polar(0.8f, phase) + ComplexType(awgn(gen), awgn(gen));
+    }
+    return out;
+}
+
+/***********************************************************************
+ * Run the samples through the Frame Sync block
+ **********************************************************************/
+struct FrameSyncOutput
+{
+    Pothos::BufferChunk buffer;
+    std::vector<Pothos::Label> labels;
+    unsigned long long frameCount;
+    unsigned long long peakCount;
+    unsigned long long headerErrorCount;
+    unsigned long long checksumErrorCount;
+    unsigned long long wrongIdCount;
+    unsigned long long searchSampleCount;
+    unsigned long long payloadSampleCount;
+};
+
+static FrameSyncOutput runFrameSync(const Pothos::BufferChunk &samples, const std::string &mode, const size_t searchThreads)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "complex_float32");
+    auto sync = Pothos::BlockRegistry::make("/comms/frame_sync", "complex_float32");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "complex_float32");
+    sync.call("setOutputMode", mode);
+    sync.call("setPreamble", testPreamble);
+    sync.call("setSymbolWidth", testSymbolWidth);
+    sync.call("setDataWidth", testDataWidth);
+    sync.call("setSearchThreads", searchThreads);
+    feeder.call("feedBuffer", samples);
+
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, sync, 0);
+        topology.connect(sync, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    FrameSyncOutput output;
+    output.buffer = collector.call<Pothos::BufferChunk>("getBuffer");
+    output.labels = collector.call<std::vector<Pothos::Label>>("getLabels");
+    output.frameCount = sync.call<unsigned long long>("getFrameCount");
+    output.peakCount = sync.call<unsigned long long>("getPeakCount");
+    output.headerErrorCount = sync.call<unsigned long long>("getHeaderErrorCount");
+    output.checksumErrorCount = sync.call<unsigned long long>("getChecksumErrorCount");
+    output.wrongIdCount = sync.call<unsigned long long>("getWrongIdCount");
+    output.searchSampleCount = sync.call<unsigned long long>("getSearchSampleCount");
+    output.payloadSampleCount = sync.call<unsigned long long>("getPayloadSampleCount");
+    return output;
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_frame_sync_parallel_search)
+{
+    //many frames in one input, so that peaks fall near the segment boundaries
+    std::vector<size_t> lengths;
+    for (size_t i = 0; i < 24; i++) lengths.push_back(20 + (std::rand()%100));
+    const auto samples = applyChannel(insertFrames(makePayloads(lengths), 50), 0.01, 0.02f);
+
+    //the serial and the parallel search find the same peaks,
+    //and the raw output forwards the same input samples
+    const auto serial = runFrameSync(samples, "RAW", 1);
+    const auto parallel = runFrameSync(samples, "RAW", 4);
+    POTHOS_TEST_EQUAL(serial.frameCount, lengths.size());
+    POTHOS_TEST_EQUAL(parallel.frameCount, lengths.size());
+    POTHOS_TEST_EQUAL(serial.labels.size(), parallel.labels.size());
+    for (size_t i = 0; i < serial.labels.size(); i++)
+    {
+        POTHOS_TEST_EQUAL(serial.labels[i].id, parallel.labels[i].id);
+        POTHOS_TEST_EQUAL(serial.labels[i].index, parallel.labels[i].index);
+        POTHOS_TEST_EQUAL(serial.labels[i].data.convert<size_t>(), parallel.labels[i].data.convert<size_t>());
+    }
+    POTHOS_TEST_EQUAL(serial.buffer.elements(), parallel.buffer.elements());
+    POTHOS_TEST_EQUALA(serial.buffer.as<const ComplexType *>(), parallel.buffer.as<const ComplexType *>(), serial.buffer.elements());
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_frame_sync_channel)
+{
+    std::vector<size_t> lengths;
+    for (size_t i = 0; i < 8; i++) lengths.push_back(30 + (std::rand()%90));
+    const auto payloads = makePayloads(lengths);
+    const auto symbols = insertFrames(payloads, 50);
+
+    for (const double freqOffset : {0.0, 0.01, 0.03})
+    {
+        const auto samples = applyChannel(symbols, freqOffset, 0.05f);
+        for (const size_t searchThreads : {1, 4})
+        {
+            std::cout << "freqOffset " << freqOffset << ", searchThreads " << searchThreads << std::endl;
+            const auto output = runFrameSync(samples, "TIMING", searchThreads);
+            POTHOS_TEST_EQUAL(output.frameCount, lengths.size());
+
+            //the timing output holds the payloads back to back,
+            //and each frame start label holds the payload length
+            std::vector<Pothos::Label> frameStarts;
+            for (const auto &label : output.labels)
+            {
+                if (label.id == "frameStart") frameStarts.push_back(label);
+            }
+            POTHOS_TEST_EQUAL(frameStarts.size(), lengths.size());
+            size_t index = 0;
+            for (size_t f = 0; f < frameStarts.size(); f++)
+            {
+                POTHOS_TEST_EQUAL(frameStarts[f].index, index);
+                POTHOS_TEST_EQUAL(frameStarts[f].data.convert<size_t>(), lengths[f]);
+                index += lengths[f];
+            }
+            POTHOS_TEST_EQUAL(output.buffer.elements(), index);
+
+            //the phase and timing compensated payloads decide to the transmitted symbols
+            const auto out = output.buffer.as<const ComplexType *>();
+            for (size_t f = 0; f < payloads.size(); f++)
+            {
+                for (size_t i = 0; i < payloads[f].size(); i++)
+                {
+                    const auto y = out[frameStarts[f].index + i];
+                    POTHOS_TEST_EQUAL(y.real() > 0, payloads[f][i].real() > 0);
+                    POTHOS_TEST_EQUAL(y.imag() > 0, payloads[f][i].imag() > 0);
+                }
+            }
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_frame_sync_counters)
+{
+    std::vector<size_t> lengths;
+    for (size_t i = 0; i < 6; i++) lengths.push_back(30 + (std::rand()%90));
+    const size_t gap = 50;
+    auto symbols = insertFrames(makePayloads(lengths), gap);
+
+    //offset of the header bits of each frame at the symbol rate
+    const size_t syncWordSyms = testPreamble.size()*testSymbolWidth;
+    std::vector<size_t> headerOffsets;
+    size_t offset = gap;
+    for (const auto length : lengths)
+    {
+        headerOffsets.push_back(offset + syncWordSyms);
+        offset += syncWordSyms + NUM_HEADER_BITS + length + gap;
+    }
+    POTHOS_TEST_EQUAL(offset, symbols.elements());
+
+    //frame 1 carries a valid header with another ID
+    FrameHeaderFields wrongId;
+    wrongId.id = 0x12;
+    wrongId.length = uint16_t(lengths[1]);
+    wrongId.chksum = wrongId.doChecksum();
+    const auto headerWord = encodeHeaderPacked(wrongId);
+    const auto x = symbols.as<ComplexType *>();
+    for (size_t i = 0; i < NUM_HEADER_BITS; i++)
+    {
+        x[headerOffsets[1] + i] = (((headerWord >> i) & 0x1) != 0)?testPreamble.back():-testPreamble.back();
+    }
+
+    //frame 3 has two bit errors in one header codeword, which cannot be corrected
+    x[headerOffsets[3] + 3] = -x[headerOffsets[3] + 3];
+    x[headerOffsets[3] + 4] = -x[headerOffsets[3] + 4];
+
+    size_t payloadSamples = 0;
+    for (size_t f = 0; f < lengths.size(); f++)
+    {
+        if (f != 1 and f != 3) payloadSamples += lengths[f]*testDataWidth;
+    }
+
+    const auto samples = applyChannel(symbols, 0.01, 0.02f);
+    const size_t frameWidth = syncWordSyms*testDataWidth + NUM_HEADER_BITS*testDataWidth;
+    for (const size_t searchThreads : {1, 4})
+    {
+        const auto output = runFrameSync(samples, "RAW", searchThreads);
+        POTHOS_TEST_EQUAL(output.peakCount, lengths.size());
+        POTHOS_TEST_EQUAL(output.frameCount, lengths.size()-2);
+        POTHOS_TEST_EQUAL(output.headerErrorCount, 1);
+        POTHOS_TEST_EQUAL(output.checksumErrorCount, 0);
+        POTHOS_TEST_EQUAL(output.wrongIdCount, 1);
+        POTHOS_TEST_EQUAL(output.payloadSampleCount, payloadSamples);
+        POTHOS_TEST_EQUAL(output.buffer.elements(), payloadSamples);
+
+        //every sample is consumed by the search or the payload,
+        //except for the tail that is shorter than a frame header
+        const auto consumed = output.searchSampleCount + output.payloadSampleCount;
+        POTHOS_TEST_TRUE(consumed <= samples.elements());
+        POTHOS_TEST_TRUE(consumed + frameWidth > samples.elements());
+    }
+}
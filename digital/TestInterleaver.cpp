@@ -0,0 +1,181 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <iostream>
+#include <cstdlib>
+#include <cstring> //memcmp
+#include <vector>
+
+POTHOS_TEST_BLOCK("/comms/tests", test_block_interleaver)
+{
+    const size_t rows = 5, cols = 7;
+    const size_t numElems = 2*rows*cols + 12; //two full blocks and a partial block
+
+    auto p0 = Pothos::Packet();
+    p0.payload = Pothos::BufferChunk("float32", numElems);
+    for (size_t i = 0; i < numElems; i++) p0.payload.as<float *>()[i] = float(i);
+    p0.metadata["recipient"] = Pothos::Object(42);
+
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "float32");
+    auto interleaver = Pothos::BlockRegistry::make("/comms/block_interleaver", "float32");
+    auto deinterleaver = Pothos::BlockRegistry::make("/comms/block_interleaver", "float32");
+    auto interleaved = Pothos::BlockRegistry::make("/blocks/collector_sink", "float32");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "float32");
+    for (auto block : {interleaver, deinterleaver})
+    {
+        block.call("setRows", rows);
+        block.call("setColumns", cols);
+    }
+    deinterleaver.call("setDeinterleave", true);
+    feeder.call("feedPacket", p0);
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, interleaver, 0);
+        topology.connect(interleaver, 0, interleaved, 0);
+        topology.connect(interleaver, 0, deinterleaver, 0);
+        topology.connect(deinterleaver, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //the full blocks are read column by column
+    const std::vector<Pothos::Packet> interleavedPackets = interleaved.call("getPackets");
+    POTHOS_TEST_EQUAL(interleavedPackets.size(), 1);
+    const auto p1 = interleavedPackets.at(0).payload.as<const float *>();
+    for (size_t b = 0; b < 2; b++)
+    {
+        for (size_t c = 0; c < cols; c++)
+        {
+            for (size_t r = 0; r < rows; r++)
+            {
+                POTHOS_TEST_EQUAL(p1[b*rows*cols + c*rows + r], float(b*rows*cols + r*cols + c));
+            }
+        }
+    }
+
+    //the partial block skips the empty cells: 12 elements are 1 full row and 5 cells of the second row
+    const std::vector<float> partial{70, 77, 71, 78, 72, 79, 73, 80, 74, 81, 75, 76};
+    POTHOS_TEST_EQUALA(p1 + 2*rows*cols, partial.data(), partial.size());
+
+    //the deinterleaver restores the order
+    const std::vector<Pothos::Packet> packets = collector.call("getPackets");
+    POTHOS_TEST_EQUAL(packets.size(), 1);
+    POTHOS_TEST_EQUAL(packets.at(0).metadata.count("recipient"), 1);
+    POTHOS_TEST_EQUAL(packets.at(0).payload.elements(), numElems);
+    POTHOS_TEST_EQUALA(packets.at(0).payload.as<const float *>(), p0.payload.as<const float *>(), numElems);
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_conv_interleaver)
+{
+    const size_t branches = 4, delay = 3;
+    const size_t totalDelay = (branches-1)*delay*branches;
+    const size_t frameLength = 40*branches;
+    const size_t numElems = 5*frameLength;
+
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+    auto interleaver = Pothos::BlockRegistry::make("/comms/conv_interleaver", "uint8");
+    auto deinterleaver = Pothos::BlockRegistry::make("/comms/conv_interleaver", "uint8");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+    for (auto block : {interleaver, deinterleaver})
+    {
+        block.call("setBranches", branches);
+        block.call("setDelay", delay);
+    }
+    deinterleaver.call("setDeinterleave", true);
+
+    auto b0 = Pothos::BufferChunk("uint8", numElems);
+    for (size_t i = 0; i < numElems; i++) b0.as<unsigned char *>()[i] = std::rand() & 0xff;
+    for (size_t i = 0; i < numElems; i += frameLength)
+    {
+        feeder.call("feedLabel", Pothos::Label("frameStart", frameLength, i));
+    }
+    feeder.call("feedBuffer", b0);
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, interleaver, 0);
+        topology.connect(interleaver, 0, deinterleaver, 0);
+        topology.connect(deinterleaver, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //the stream is restored after the end to end delay, which starts with zeros
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), numElems);
+    for (size_t i = 0; i < totalDelay; i++) POTHOS_TEST_EQUAL(buff.as<const unsigned char *>()[i], 0);
+    POTHOS_TEST_EQUALA(buff.as<const unsigned char *>() + totalDelay, b0.as<const unsigned char *>(), numElems - totalDelay);
+
+    //the frame start labels are delayed with the frames
+    const std::vector<Pothos::Label> labels = collector.call("getLabels");
+    POTHOS_TEST_EQUAL(labels.size(), 5);
+    for (size_t i = 0; i < labels.size(); i++)
+    {
+        POTHOS_TEST_EQUAL(labels[i].id, "frameStart");
+        POTHOS_TEST_EQUAL(labels[i].index, i*frameLength + totalDelay);
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_interleaver_element_sizes)
+{
+    //every element size offered by the data type chooser, up to complex_float64 and complex_int64
+    const size_t numElems = 100;
+    for (const auto &dtype : {"uint8", "complex_int8", "float32", "complex_float32", "complex_float64", "complex_int64"})
+    {
+        std::cout << "Testing " << dtype << std::endl;
+        auto b0 = Pothos::BufferChunk(dtype, numElems);
+        for (size_t i = 0; i < b0.length; i++) b0.as<unsigned char *>()[i] = std::rand() & 0xff;
+        auto p0 = Pothos::Packet();
+        p0.payload = b0;
+
+        //the block interleaver round trip, with a partial block
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+        auto interleaver = Pothos::BlockRegistry::make("/comms/block_interleaver", dtype);
+        auto deinterleaver = Pothos::BlockRegistry::make("/comms/block_interleaver", dtype);
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+        deinterleaver.call("setDeinterleave", true);
+        feeder.call("feedPacket", p0);
+        {
+            Pothos::Topology topology;
+            topology.connect(feeder, 0, interleaver, 0);
+            topology.connect(interleaver, 0, deinterleaver, 0);
+            topology.connect(deinterleaver, 0, collector, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+        const std::vector<Pothos::Packet> packets = collector.call("getPackets");
+        POTHOS_TEST_EQUAL(packets.size(), 1);
+        POTHOS_TEST_EQUAL(packets.at(0).payload.length, b0.length);
+        POTHOS_TEST_EQUAL(std::memcmp(packets.at(0).payload.as<const void *>(), b0.as<const void *>(), b0.length), 0);
+
+        //the convolutional interleaver round trip, after the zero elements of the delay
+        const size_t branches = 3, delay = 2;
+        const size_t totalDelay = (branches-1)*delay*branches;
+        auto feeder2 = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+        auto convInterleaver = Pothos::BlockRegistry::make("/comms/conv_interleaver", dtype);
+        auto convDeinterleaver = Pothos::BlockRegistry::make("/comms/conv_interleaver", dtype);
+        auto collector2 = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+        for (auto block : {convInterleaver, convDeinterleaver})
+        {
+            block.call("setBranches", branches);
+            block.call("setDelay", delay);
+        }
+        convDeinterleaver.call("setDeinterleave", true);
+        feeder2.call("feedBuffer", b0);
+        {
+            Pothos::Topology topology;
+            topology.connect(feeder2, 0, convInterleaver, 0);
+            topology.connect(convInterleaver, 0, convDeinterleaver, 0);
+            topology.connect(convDeinterleaver, 0, collector2, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+        Pothos::BufferChunk buff = collector2.call("getBuffer");
+        POTHOS_TEST_EQUAL(buff.elements(), numElems);
+        const size_t delayBytes = totalDelay*b0.dtype.size();
+        for (size_t i = 0; i < delayBytes; i++) POTHOS_TEST_EQUAL(buff.as<const unsigned char *>()[i], 0);
+        POTHOS_TEST_EQUAL(std::memcmp(buff.as<const unsigned char *>() + delayBytes, b0.as<const void *>(), b0.length - delayBytes), 0);
+    }
+}
@@ -0,0 +1,184 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "common/Testing.hpp"
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <algorithm> //min/max
+
+POTHOS_TEST_BLOCK("/comms/tests", test_ldpc_packets)
+{
+    const size_t N = 648, K = 324;
+    const size_t numBits = 3*K - 17; //two full codewords and a shortened codeword
+
+    auto p0 = Pothos::Packet();
+    p0.payload = Pothos::BufferChunk("uint8", numBits);
+    for (size_t i = 0; i < numBits; i++) p0.payload.as<unsigned char *>()[i] = std::rand() & 0x1;
+    p0.metadata["recipient"] = Pothos::Object(42);
+
+    //encode the packet
+    auto encoder = Pothos::BlockRegistry::make("/comms/ldpc_encoder");
+    const auto codedPackets = CommsTests::runPacketChain("uint8", {p0}, {encoder});
+    POTHOS_TEST_EQUAL(codedPackets.size(), 1);
+    const auto &p1 = codedPackets.at(0);
+    POTHOS_TEST_EQUAL(p1.payload.elements(), numBits + 3*(N-K));
+    POTHOS_TEST_EQUAL(p1.metadata.count("recipient"), 1);
+    POTHOS_TEST_EQUALA(p1.payload.as<const unsigned char *>(), p0.payload.as<const unsigned char *>(), K);
+
+    //map to LLRs with some weak wrong soft bits in every codeword
+    auto p2 = Pothos::Packet();
+    p2.metadata = p1.metadata;
+    p2.payload = Pothos::BufferChunk("float32", p1.payload.elements());
+    for (size_t i = 0; i < p1.payload.elements(); i++)
+    {
+        const bool one = p1.payload.as<const unsigned char *>()[i] != 0;
+        const bool flip = (i % 61) == 7;
+        p2.payload.as<float *>()[i] = ((one != flip)?-1.0f:1.0f)*(flip?0.5f:2.0f);
+    }
+
+    auto decoder = Pothos::BlockRegistry::make("/comms/ldpc_decoder", "float32");
+    const auto packets = CommsTests::runPacketChain("float32", {p2}, {decoder});
+    POTHOS_TEST_EQUAL(packets.size(), 1);
+    POTHOS_TEST_EQUAL(packets.at(0).metadata.count("recipient"), 1);
+    POTHOS_TEST_EQUAL(packets.at(0).payload.elements(), numBits);
+    POTHOS_TEST_EQUALA(packets.at(0).payload.as<const unsigned char *>(), p0.payload.as<const unsigned char *>(), numBits);
+    POTHOS_TEST_EQUAL(decoder.call<unsigned long long>("getErrorCount"), 0);
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_ldpc_stream_frames)
+{
+    //a larger code with 8-bit soft bits
+    const size_t N = 1944, K = 1458;
+    const std::vector<size_t> frameLengths{100, K, 2*K+5};
+
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+    auto encoder = Pothos::BlockRegistry::make("/comms/ldpc_encoder");
+    auto coded = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+    encoder.call("setCode", "pothos_qc1944_3/4");
+
+    //frames with the length in the start label, separated by filler bits
+    const auto expected = CommsTests::feedLabeledFrames(feeder, frameLengths, 1, 0x1);
+    CommsTests::runBlockChain({feeder, encoder, coded});
+
+    //map the coded stream to int8 LLRs and keep the labels
+    Pothos::BufferChunk codedBuff = coded.call("getBuffer");
+    const std::vector<Pothos::Label> codedLabels = coded.call("getLabels");
+    POTHOS_TEST_EQUAL(codedBuff.elements(), expected.size() + 5*(N-K));
+    auto b1 = Pothos::BufferChunk("int8", codedBuff.elements());
+    for (size_t i = 0; i < codedBuff.elements(); i++)
+    {
+        const bool one = codedBuff.as<const unsigned char *>()[i] != 0;
+        const bool flip = (i % 97) == 3;
+        b1.as<signed char *>()[i] = static_cast<signed char>(((one != flip)?-1:1)*(flip?4:20));
+    }
+
+    auto feeder2 = Pothos::BlockRegistry::make("/blocks/feeder_source", "int8");
+    auto decoder = Pothos::BlockRegistry::make("/comms/ldpc_decoder", "int8");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+    decoder.call("setCode", "pothos_qc1944_3/4");
+    for (const auto &label : codedLabels) feeder2.call("feedLabel", label);
+    feeder2.call("feedBuffer", b1);
+    CommsTests::runBlockChain({feeder2, decoder, collector});
+
+    //the frames without filler bits, with a label at the start of each decoded frame
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), expected.size());
+    POTHOS_TEST_EQUALA(buff.as<const unsigned char *>(), expected.data(), expected.size());
+    CommsTests::testFrameStartLabels(collector.call<std::vector<Pothos::Label>>("getLabels"), frameLengths);
+    POTHOS_TEST_EQUAL(decoder.call<unsigned long long>("getErrorCount"), 0);
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_ldpc_noisy_channel)
+{
+    //BPSK over AWGN at 6 dB Eb/N0, where the hard decisions have many errors
+    const size_t N = 648, K = 324;
+    const size_t numCodewords = 300;
+    const double ebn0 = std::pow(10.0, 6.0/10);
+    const double sigma = std::sqrt(1.0/(2*ebn0*K/N));
+
+    auto p0 = Pothos::Packet();
+    p0.payload = Pothos::BufferChunk("uint8", numCodewords*K);
+    for (size_t i = 0; i < p0.payload.elements(); i++) p0.payload.as<unsigned char *>()[i] = std::rand() & 0x1;
+    auto encoder = Pothos::BlockRegistry::make("/comms/ldpc_encoder");
+    const auto codedPackets = CommsTests::runPacketChain("uint8", {p0}, {encoder});
+    POTHOS_TEST_EQUAL(codedPackets.size(), 1);
+    const auto &p1 = codedPackets.at(0);
+    POTHOS_TEST_EQUAL(p1.payload.elements(), numCodewords*N);
+
+    //the channel LLRs are 2y/sigma^2
+    std::mt19937 gen(7);
+    std::normal_distribution<float> awgn(0, float(sigma));
+    auto p2 = Pothos::Packet();
+    p2.payload = Pothos::BufferChunk("float32", p1.payload.elements());
+    size_t hardErrors = 0;
+    for (size_t i = 0; i < p1.payload.elements(); i++)
+    {
+        const bool one = p1.payload.as<const unsigned char *>()[i] != 0;
+        const float y = (one?-1.0f:1.0f) + awgn(gen);
+        if ((y < 0) != one) hardErrors++;
+        p2.payload.as<float *>()[i] = float(2*y/(sigma*sigma));
+    }
+    std::cout << "hard decision errors: " << hardErrors << "/" << p1.payload.elements() << std::endl;
+    POTHOS_TEST_TRUE(hardErrors > numCodewords);
+
+    //every codeword converges with the float and the int8 soft bits
+    for (const std::string dtype : {"float32", "int8"})
+    {
+        std::cout << "decode " << dtype << " soft bits" << std::endl;
+        auto p3 = p2;
+        if (dtype == "int8")
+        {
+            p3.payload = Pothos::BufferChunk("int8", p2.payload.elements());
+            for (size_t i = 0; i < p2.payload.elements(); i++)
+            {
+                const float llr = 4.0f*p2.payload.as<const float *>()[i];
+                p3.payload.as<signed char *>()[i] = static_cast<signed char>(std::round(std::max(-127.0f, std::min(127.0f, llr))));
+            }
+        }
+        auto decoder = Pothos::BlockRegistry::make("/comms/ldpc_decoder", dtype);
+        const auto packets = CommsTests::runPacketChain(dtype, {p3}, {decoder});
+        POTHOS_TEST_EQUAL(packets.size(), 1);
+        POTHOS_TEST_EQUAL(packets.at(0).payload.elements(), numCodewords*K);
+        POTHOS_TEST_EQUALA(packets.at(0).payload.as<const unsigned char *>(), p0.payload.as<const unsigned char *>(), numCodewords*K);
+        POTHOS_TEST_EQUAL(decoder.call<unsigned long long>("getErrorCount"), 0);
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_ldpc_saturated_input)
+{
+    //hard decisions as saturated int8 LLRs, with a wrong bit in every codeword
+    const size_t N = 648, K = 324;
+    const size_t numCodewords = 50;
+
+    auto p0 = Pothos::Packet();
+    p0.payload = Pothos::BufferChunk("uint8", numCodewords*K);
+    for (size_t i = 0; i < p0.payload.elements(); i++) p0.payload.as<unsigned char *>()[i] = std::rand() & 0x1;
+    auto encoder = Pothos::BlockRegistry::make("/comms/ldpc_encoder");
+    const auto codedPackets = CommsTests::runPacketChain("uint8", {p0}, {encoder});
+    POTHOS_TEST_EQUAL(codedPackets.size(), 1);
+    const auto &p1 = codedPackets.at(0);
+    POTHOS_TEST_EQUAL(p1.payload.elements(), numCodewords*N);
+
+    auto p2 = Pothos::Packet();
+    p2.payload = Pothos::BufferChunk("int8", p1.payload.elements());
+    for (size_t i = 0; i < p1.payload.elements(); i++)
+    {
+        const bool one = p1.payload.as<const unsigned char *>()[i] != 0;
+        const bool flip = (i % N) == (i / N)*13 % N;
+        p2.payload.as<signed char *>()[i] = (one != flip)?-127:127;
+    }
+
+    //the saturated wrong bits flip back
+    auto decoder = Pothos::BlockRegistry::make("/comms/ldpc_decoder", "int8");
+    const auto packets = CommsTests::runPacketChain("int8", {p2}, {decoder});
+    POTHOS_TEST_EQUAL(packets.size(), 1);
+    POTHOS_TEST_EQUAL(packets.at(0).payload.elements(), numCodewords*K);
+    POTHOS_TEST_EQUALA(packets.at(0).payload.as<const unsigned char *>(), p0.payload.as<const unsigned char *>(), numCodewords*K);
+    POTHOS_TEST_EQUAL(decoder.call<unsigned long long>("getErrorCount"), 0);
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <iostream>
+#include <complex>
+#include <cstdlib>
+#include <cmath>
+
+POTHOS_TEST_BLOCK("/comms/tests", test_linear_modulator)
+{
+    //8-PSK at 4 samples per symbol with a smooth pulse
+    std::vector<std::complex<double>> map;
+    for (size_t k = 0; k < 8; k++) map.push_back(std::polar(1.0, k*M_PI/4));
+    const size_t sps = 4;
+    std::vector<double> taps;
+    for (size_t i = 0; i < 4*sps+1; i++) taps.push_back(std::sin(M_PI*(i+1)/(4*sps+2)));
+    const size_t K = (taps.size() + sps - 1)/sps;
+
+    for (const std::string order : {"MSBit", "LSBit"})
+    {
+        std::cout << "linear modulator with " << order << " order" << std::endl;
+
+        //random bytes, a multiple of 3 bytes for whole 3-bit symbols
+        const size_t numBytes = 300;
+        auto b0 = Pothos::BufferChunk("uint8", numBytes);
+        for (size_t i = 0; i < numBytes; i++) b0.as<unsigned char *>()[i] = std::rand() & 0xff;
+
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+        auto modulator = Pothos::BlockRegistry::make("/comms/linear_modulator", "complex_float64");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "complex_float64");
+        modulator.call("setMap", map);
+        modulator.call("setBitOrder", order);
+        modulator.call("setInterpolation", sps);
+        modulator.call("setTaps", taps);
+
+        //the same chain from separate blocks
+        auto toSymbols = Pothos::BlockRegistry::make("/comms/bytes_to_symbols");
+        auto mapper = Pothos::BlockRegistry::make("/comms/symbol_mapper", "complex_float64");
+        auto filter = Pothos::BlockRegistry::make("/comms/fir_filter", "complex_float64", "REAL");
+        auto chainCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", "complex_float64");
+        toSymbols.call("setModulus", 3);
+        toSymbols.call("setBitOrder", order);
+        mapper.call("setMap", map);
+        filter.call("setInterpolation", sps);
+        filter.call("setTaps", taps);
+        feeder.call("feedBuffer", b0);
+
+        {
+            Pothos::Topology topology;
+            topology.connect(feeder, 0, modulator, 0);
+            topology.connect(modulator, 0, collector, 0);
+            topology.connect(feeder, 0, toSymbols, 0);
+            topology.connect(toSymbols, 0, mapper, 0);
+            topology.connect(mapper, 0, filter, 0);
+            topology.connect(filter, 0, chainCollector, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+
+        //the FIR filter waits for K-1 symbols of history, the modulator starts from zeros
+        const size_t numSyms = (numBytes*8)/3;
+        Pothos::BufferChunk buff = collector.call("getBuffer");
+        Pothos::BufferChunk chainBuff = chainCollector.call("getBuffer");
+        POTHOS_TEST_EQUAL(buff.elements(), numSyms*sps);
+        POTHOS_TEST_EQUAL(chainBuff.elements(), (numSyms-(K-1))*sps);
+        auto out = buff.as<const std::complex<double> *>() + (K-1)*sps;
+        auto expected = chainBuff.as<const std::complex<double> *>();
+        for (size_t i = 0; i < chainBuff.elements(); i++)
+        {
+            POTHOS_TEST_CLOSE(out[i].real(), expected[i].real(), 1e-9);
+            POTHOS_TEST_CLOSE(out[i].imag(), expected[i].imag(), 1e-9);
+        }
+    }
+}
@@ -48,3 +48,141 @@ POTHOS_TEST_BLOCK("/comms/tests", test_preamble_correlator)
     POTHOS_TEST_EQUAL(labels.size(), 1);
     POTHOS_TEST_EQUAL(labels[0].index, preambleIndex + preamble.size());
 }
+
+POTHOS_TEST_BLOCK("/comms/tests", test_preamble_correlator_long)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "unsigned char");
+    auto correlator = Pothos::BlockRegistry::make("/comms/preamble_correlator");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "unsigned char");
+
+    //a preamble longer than one 64-bit word of 2-bit symbols
+    std::vector<unsigned char> preamble;
+    for (size_t i = 0; i < 50; i++) preamble.push_back((i*7+i/3) % 4);
+    const size_t testLength = 300;
+    const size_t preambleIndex0 = 40;
+    const size_t preambleIndex1 = 170;
+
+    correlator.call("setPreamble", preamble);
+    correlator.call("setThreshold", 1);
+
+    //load feeder blocks, the second preamble has a single bit error
+    auto b0 = Pothos::BufferChunk(testLength + preamble.size());
+    auto p0 = b0.as<unsigned char *>();
+    for (size_t i = 0; i < b0.length; i++) p0[i] = 0;
+    for (size_t i = 0; i < preamble.size(); i++) p0[i + preambleIndex0] = preamble[i];
+    for (size_t i = 0; i < preamble.size(); i++) p0[i + preambleIndex1] = preamble[i];
+    p0[preambleIndex1 + 10] ^= 0x2;
+    feeder.call("feedBuffer", b0);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, correlator, 0);
+        topology.connect(correlator, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check for both preamble labels
+    std::vector<Pothos::Label> labels = collector.call("getLabels");
+    POTHOS_TEST_EQUAL(labels.size(), 2);
+    POTHOS_TEST_EQUAL(labels[0].index, preambleIndex0 + preamble.size());
+    POTHOS_TEST_EQUAL(labels[1].index, preambleIndex1 + preamble.size());
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_preamble_correlator_multi)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "unsigned char");
+    auto correlator = Pothos::BlockRegistry::make("/comms/preamble_correlator");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "unsigned char");
+
+    //two sync words of different lengths, each with its own threshold and label
+    const std::vector<std::vector<unsigned char>> preambles{
+        {1, 1, 1, 0, 0, 1, 0},
+        {0, 1, 0, 1, 1, 0, 0, 1, 1, 1, 1, 0}};
+    const size_t testLength = 100;
+    const size_t preambleIndex0 = 60;
+    const size_t preambleIndex1 = 20;
+
+    correlator.call("setPreambles", preambles);
+    correlator.call("setThresholds", std::vector<unsigned>{0, 1});
+    correlator.call("setFrameStartIds", std::vector<std::string>{"frameA", "frameB"});
+
+    //load feeder blocks, the second preamble has a single bit error
+    auto b0 = Pothos::BufferChunk(testLength + preambles[1].size());
+    auto p0 = b0.as<unsigned char *>();
+    for (size_t i = 0; i < b0.length; i++) p0[i] = 0;
+    for (size_t i = 0; i < preambles[0].size(); i++) p0[i + preambleIndex0] = preambles[0][i];
+    for (size_t i = 0; i < preambles[1].size(); i++) p0[i + preambleIndex1] = preambles[1][i];
+    p0[preambleIndex1 + 3] ^= 0x1;
+    feeder.call("feedBuffer", b0);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, correlator, 0);
+        topology.connect(correlator, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the collector buffer matches input
+    //the last window of the longest preamble is left in the correlator
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(testLength, buff.elements());
+
+    //check for both preamble labels in index order
+    std::vector<Pothos::Label> labels = collector.call("getLabels");
+    POTHOS_TEST_EQUAL(labels.size(), 2);
+    POTHOS_TEST_EQUAL(labels[0].id, "frameB");
+    POTHOS_TEST_EQUAL(labels[0].index, preambleIndex1 + preambles[1].size());
+    POTHOS_TEST_EQUAL(labels[1].id, "frameA");
+    POTHOS_TEST_EQUAL(labels[1].index, preambleIndex0 + preambles[0].size());
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_soft_preamble_correlator)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "complex_float32");
+    auto correlator = Pothos::BlockRegistry::make("/comms/soft_preamble_correlator", "complex_float32");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "complex_float32");
+
+    //barker 13 preamble
+    const std::vector<std::complex<float>> preamble{1, 1, 1, 1, 1, -1, -1, 1, 1, -1, 1, -1, 1};
+    const size_t testLength = 200;
+    const size_t preambleIndex0 = 30;
+    const size_t preambleIndex1 = 120;
+
+    correlator.call("setPreamble", preamble);
+    correlator.call("setThreshold", 0.9);
+
+    //load feeder blocks, qpsk symbols around two preambles with a different gain and phase
+    auto b0 = Pothos::BufferChunk("complex_float32", testLength + preamble.size());
+    auto p0 = b0.as<std::complex<float> *>();
+    for (size_t i = 0; i < b0.elements(); i++)
+    {
+        const auto sym = (i*7+i/3) % 4;
+        p0[i] = std::complex<float>((sym & 0x1)?1:-1, (sym & 0x2)?1:-1);
+    }
+    for (size_t i = 0; i < preamble.size(); i++) p0[i + preambleIndex0] = preamble[i]*std::polar(0.5f, 1.0f);
+    for (size_t i = 0; i < preamble.size(); i++) p0[i + preambleIndex1] = preamble[i]*std::polar(3.0f, -2.0f);
+    feeder.call("feedBuffer", b0);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, correlator, 0);
+        topology.connect(correlator, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the collector buffer matches input
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(testLength, buff.elements());
+
+    //check for both preamble labels
+    std::vector<Pothos::Label> labels = collector.call("getLabels");
+    POTHOS_TEST_EQUAL(labels.size(), 2);
+    POTHOS_TEST_EQUAL(labels[0].index, preambleIndex0 + preamble.size());
+    POTHOS_TEST_EQUAL(labels[1].index, preambleIndex1 + preamble.size());
+}
@@ -0,0 +1,147 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "common/Testing.hpp"
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm> //find
+
+POTHOS_TEST_BLOCK("/comms/tests", test_reed_solomon_packets)
+{
+    const size_t parity = 32;
+    const size_t dataLength = 223;
+    const size_t numBytes = 500; //two full codewords and a shortened codeword
+
+    auto p0 = Pothos::Packet();
+    p0.payload = Pothos::BufferChunk("uint8", numBytes);
+    for (size_t i = 0; i < numBytes; i++) p0.payload.as<unsigned char *>()[i] = std::rand() & 0xff;
+    p0.metadata["recipient"] = Pothos::Object(42);
+
+    //encode the packet
+    auto encoder = Pothos::BlockRegistry::make("/comms/rs_encoder");
+    const auto codedPackets = CommsTests::runPacketChain("uint8", {p0}, {encoder});
+    POTHOS_TEST_EQUAL(codedPackets.size(), 1);
+    const auto &p1 = codedPackets.at(0);
+    POTHOS_TEST_EQUAL(p1.payload.elements(), numBytes + 3*parity);
+    POTHOS_TEST_EQUAL(p1.metadata.count("recipient"), 1);
+    POTHOS_TEST_EQUALA(p1.payload.as<const unsigned char *>(), p0.payload.as<const unsigned char *>(), dataLength);
+
+    //a burst of parity/2 errors in every codeword is corrected
+    auto p2 = CommsTests::copyPacket(p1);
+    for (size_t cw = 0; cw < 3; cw++)
+    {
+        for (size_t i = 0; i < parity/2; i++) p2.payload.as<unsigned char *>()[cw*(dataLength+parity) + 30 + i] ^= 0x5a;
+    }
+
+    //and one more error in a codeword drops the packet
+    auto p3 = CommsTests::copyPacket(p2);
+    p3.payload.as<unsigned char *>()[10] ^= 0x01;
+
+    auto decoder = Pothos::BlockRegistry::make("/comms/rs_decoder");
+    const auto packets = CommsTests::runPacketChain("uint8", {p2, p3}, {decoder});
+    POTHOS_TEST_EQUAL(packets.size(), 1);
+    POTHOS_TEST_EQUAL(packets.at(0).metadata.count("recipient"), 1);
+    POTHOS_TEST_EQUAL(packets.at(0).payload.elements(), numBytes);
+    POTHOS_TEST_EQUALA(packets.at(0).payload.as<const unsigned char *>(), p0.payload.as<const unsigned char *>(), numBytes);
+    POTHOS_TEST_EQUAL(decoder.call<unsigned long long>("getCorrectedCount"), 3*parity/2);
+    POTHOS_TEST_EQUAL(decoder.call<unsigned long long>("getErrorCount"), 1);
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_reed_solomon_uncorrectable)
+{
+    const size_t parity = 32;
+    const size_t dataLength = 223;
+    const size_t numTrials = 20;
+
+    //one full codeword per packet
+    std::vector<Pothos::Packet> dataPackets;
+    for (size_t n = 0; n < numTrials; n++)
+    {
+        auto p0 = Pothos::Packet();
+        p0.payload = Pothos::BufferChunk("uint8", dataLength);
+        for (size_t i = 0; i < dataLength; i++) p0.payload.as<unsigned char *>()[i] = std::rand() & 0xff;
+        dataPackets.push_back(p0);
+    }
+    auto encoder = Pothos::BlockRegistry::make("/comms/rs_encoder");
+    const auto codedPackets = CommsTests::runPacketChain("uint8", dataPackets, {encoder});
+    POTHOS_TEST_EQUAL(codedPackets.size(), numTrials);
+
+    //t errors at random positions are corrected, t+1 errors are reported uncorrectable
+    std::vector<Pothos::Packet> correctable, uncorrectable;
+    for (const auto &packet : codedPackets)
+    {
+        for (const size_t numErrors : {parity/2, parity/2+1})
+        {
+            auto p1 = CommsTests::copyPacket(packet);
+            std::vector<size_t> positions;
+            while (positions.size() < numErrors)
+            {
+                const size_t pos = std::rand() % (dataLength + parity);
+                if (std::find(positions.begin(), positions.end(), pos) != positions.end()) continue;
+                positions.push_back(pos);
+                p1.payload.as<unsigned char *>()[pos] ^= 1 + (std::rand() % 255);
+            }
+            if (numErrors == parity/2) correctable.push_back(p1);
+            else uncorrectable.push_back(p1);
+        }
+    }
+
+    auto decoder = Pothos::BlockRegistry::make("/comms/rs_decoder");
+    const auto packets = CommsTests::runPacketChain("uint8", correctable, {decoder});
+    POTHOS_TEST_EQUAL(packets.size(), numTrials);
+    for (size_t n = 0; n < numTrials; n++)
+    {
+        POTHOS_TEST_EQUALA(packets[n].payload.as<const unsigned char *>(), dataPackets[n].payload.as<const unsigned char *>(), dataLength);
+    }
+    POTHOS_TEST_EQUAL(decoder.call<unsigned long long>("getCorrectedCount"), numTrials*parity/2);
+    POTHOS_TEST_EQUAL(decoder.call<unsigned long long>("getErrorCount"), 0);
+
+    auto decoder2 = Pothos::BlockRegistry::make("/comms/rs_decoder");
+    POTHOS_TEST_EQUAL(CommsTests::runPacketChain("uint8", uncorrectable, {decoder2}).size(), 0);
+    POTHOS_TEST_EQUAL(decoder2.call<unsigned long long>("getCorrectedCount"), 0);
+    POTHOS_TEST_EQUAL(decoder2.call<unsigned long long>("getErrorCount"), numTrials);
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_reed_solomon_stream_frames)
+{
+    //a shorter code with another field polynomial and roots
+    const size_t parity = 16;
+    const size_t dataLength = 100;
+    const std::vector<size_t> frameLengths{50, 100, 333};
+
+    //frames with a length in the start label, and with an end label too, like Frame Sync posts
+    for (const std::string frameEndId : {"", "frameEnd"})
+    {
+        std::cout << "Testing frame end ID \"" << frameEndId << "\"" << std::endl;
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+        auto encoder = Pothos::BlockRegistry::make("/comms/rs_encoder");
+        auto decoder = Pothos::BlockRegistry::make("/comms/rs_decoder");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+        for (auto block : {encoder, decoder})
+        {
+            block.call("setParity", parity);
+            block.call("setDataLength", dataLength);
+            block.call("setFieldPolynomial", 0x187);
+            block.call("setFirstRoot", 112);
+            block.call("setRootStep", 11);
+            block.call("setFrameEndId", frameEndId);
+        }
+
+        //frames separated by filler bytes,
+        //the encoder posts the coded frame labels for the decoder
+        const auto expected = CommsTests::feedLabeledFrames(feeder, frameLengths, 0xff, 0xff, frameEndId);
+        CommsTests::runBlockChain({feeder, encoder, decoder, collector});
+
+        //the frames without filler bytes, with labels at the start and end of each frame
+        Pothos::BufferChunk buff = collector.call("getBuffer");
+        POTHOS_TEST_EQUAL(buff.elements(), expected.size());
+        POTHOS_TEST_EQUALA(buff.as<const unsigned char *>(), expected.data(), expected.size());
+        CommsTests::testFrameStartLabels(collector.call<std::vector<Pothos::Label>>("getLabels"), frameLengths, frameEndId);
+        POTHOS_TEST_EQUAL(decoder.call<unsigned long long>("getErrorCount"), 0);
+    }
+}
@@ -0,0 +1,166 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "lfsr.h"
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <json.hpp>
+
+using json = nlohmann::json;
+
+POTHOS_TEST_BLOCK("/comms/tests", test_scrambler_keystream)
+{
+    //additive mode with a zero input outputs the LFSR sequence
+    //the length covers several table steps and a bit serial tail
+    for (const long long poly : {0x19LL, 0x21001LL, 0x400000000000001bLL})
+    {
+        std::cout << "additive keystream with poly " << poly << std::endl;
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+        auto scrambler = Pothos::BlockRegistry::make("/comms/scrambler");
+        scrambler.call("setMode", "additive");
+        scrambler.call("setPoly", poly);
+        scrambler.call("setSeed", 0x5);
+
+        const size_t numBits = 1000;
+        auto b0 = Pothos::BufferChunk(numBits);
+        std::memset(b0.as<void *>(), 0, numBits);
+        feeder.call("feedBuffer", b0);
+
+        {
+            Pothos::Topology topology;
+            topology.connect(feeder, 0, scrambler, 0);
+            topology.connect(scrambler, 0, collector, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+
+        lfsr_t lfsr;
+        std::memset(&lfsr, 0, sizeof(lfsr));
+        GLFSR_init(&lfsr, poly, 0x5);
+        Pothos::BufferChunk buff = collector.call("getBuffer");
+        POTHOS_TEST_EQUAL(buff.elements(), numBits);
+        auto pb = buff.as<const unsigned char *>();
+        for (size_t i = 0; i < numBits; i++)
+        {
+            POTHOS_TEST_EQUAL(int(pb[i]), int(GLFSR_next(&lfsr)));
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_scrambler_descrambler)
+{
+    for (const std::string mode : {"additive", "multiplicative"})
+    {
+        std::cout << "run the topology in " << mode << " mode" << std::endl;
+
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+        auto scrambler = Pothos::BlockRegistry::make("/comms/scrambler");
+        auto descrambler = Pothos::BlockRegistry::make("/comms/descrambler");
+        scrambler.call("setMode", mode);
+        descrambler.call("setMode", mode);
+
+        //create a test plan
+        json testPlan;
+        testPlan["enableBuffers"] = true;
+        testPlan["minValue"] = 0;
+        testPlan["maxValue"] = 1;
+
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, scrambler, 0);
+        topology.connect(scrambler, 0, descrambler, 0);
+        topology.connect(descrambler, 0, collector, 0);
+        topology.commit();
+
+        auto expected = feeder.call("feedTestPlan", testPlan.dump());
+        POTHOS_TEST_TRUE(topology.waitInactive());
+
+        std::cout << "verifyTestPlan!\n";
+        collector.call("verifyTestPlan", expected);
+    }
+
+    std::cout << "done!\n";
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_scrambler_packed)
+{
+    for (const std::string mode : {"additive", "multiplicative"})
+    {
+        for (const std::string bitOrder : {"MSBit", "LSBit"})
+        {
+            std::cout << "packed " << bitOrder << " in " << mode << " mode" << std::endl;
+
+            //random packed bytes, long enough for several table steps and a tail
+            const size_t numBytes = 1003;
+            auto b0 = Pothos::BufferChunk(numBytes);
+            auto p0 = b0.as<unsigned char *>();
+            for (size_t i = 0; i < numBytes; i++) p0[i] = std::rand() & 0xff;
+
+            //packed scrambler against unpack, unpacked scrambler, repack
+            auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+            auto packedCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+            auto unpackedCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+            auto packed = Pothos::BlockRegistry::make("/comms/scrambler");
+            auto unpacked = Pothos::BlockRegistry::make("/comms/scrambler");
+            auto toBits = Pothos::BlockRegistry::make("/comms/bytes_to_symbols");
+            auto toBytes = Pothos::BlockRegistry::make("/comms/symbols_to_bytes");
+            packed.call("setMode", mode);
+            packed.call("setPacking", bitOrder);
+            unpacked.call("setMode", mode);
+            toBits.call("setModulus", 2);
+            toBits.call("setBitOrder", bitOrder);
+            toBytes.call("setModulus", 2);
+            toBytes.call("setBitOrder", bitOrder);
+            feeder.call("feedBuffer", b0);
+
+            {
+                Pothos::Topology topology;
+                topology.connect(feeder, 0, packed, 0);
+                topology.connect(packed, 0, packedCollector, 0);
+                topology.connect(feeder, 0, toBits, 0);
+                topology.connect(toBits, 0, unpacked, 0);
+                topology.connect(unpacked, 0, toBytes, 0);
+                topology.connect(toBytes, 0, unpackedCollector, 0);
+                topology.commit();
+                POTHOS_TEST_TRUE(topology.waitInactive());
+            }
+
+            Pothos::BufferChunk packedBuff = packedCollector.call("getBuffer");
+            Pothos::BufferChunk unpackedBuff = unpackedCollector.call("getBuffer");
+            POTHOS_TEST_EQUAL(packedBuff.elements(), numBytes);
+            POTHOS_TEST_EQUAL(unpackedBuff.elements(), numBytes);
+            POTHOS_TEST_EQUALA(packedBuff.as<const unsigned char *>(), unpackedBuff.as<const unsigned char *>(), numBytes);
+
+            //packed round trip, labels stay on their bytes
+            auto planFeeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+            auto planCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+            auto scrambler = Pothos::BlockRegistry::make("/comms/scrambler");
+            auto descrambler = Pothos::BlockRegistry::make("/comms/descrambler");
+            scrambler.call("setMode", mode);
+            scrambler.call("setPacking", bitOrder);
+            descrambler.call("setMode", mode);
+            descrambler.call("setPacking", bitOrder);
+
+            json testPlan;
+            testPlan["enableBuffers"] = true;
+            testPlan["enableLabels"] = true;
+
+            Pothos::Topology topology;
+            topology.connect(planFeeder, 0, scrambler, 0);
+            topology.connect(scrambler, 0, descrambler, 0);
+            topology.connect(descrambler, 0, planCollector, 0);
+            topology.commit();
+
+            auto expected = planFeeder.call("feedTestPlan", testPlan.dump());
+            POTHOS_TEST_TRUE(topology.waitInactive());
+            planCollector.call("verifyTestPlan", expected);
+        }
+    }
+
+    std::cout << "done!\n";
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "SymbolHelpers.hpp"
+#include <Pothos/Testing.hpp>
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+
+/***********************************************************************
+ * Compare the dispatched SIMD kernels against the scalar references
+ * for every modulus and bit order, with lengths that leave tails
+ * after the vector loops, and with unaligned buffers.
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/comms/tests", test_symbol_helpers_simd)
+{
+    #ifdef CPU_FEATURES_X86
+    std::cout << "avx2: " << CpuFeatures::avx2() << ", bmi2: " << CpuFeatures::bmi2() << std::endl;
+    #endif
+
+    for (size_t mod = 1; mod <= 8; mod++)
+    for (const BitOrder order : {LSBit, MSBit})
+    {
+        std::cout << "check the kernels with " << ((order == MSBit)?"MSBit":"LSBit") << " order ";
+        std::cout << "and " << mod << " modulus" << std::endl;
+
+        //the scalar byte conversions work on groups of whole symbols
+        size_t groupBytes = 1;
+        while (((groupBytes*8) % mod) != 0) groupBytes++;
+
+        for (const size_t numGroups : {0, 1, 3, 4, 5, 31, 33, 64, 67, 129})
+        {
+            const size_t numBytes = numGroups*groupBytes;
+            const size_t numSyms = (numBytes*8)/mod;
+
+            //one byte of offset to misalign the buffers
+            std::vector<unsigned char> bytes(numBytes+1);
+            std::vector<unsigned char> bits(numSyms*mod+1);
+            for (auto &b : bytes) b = std::rand() & 0xff;
+            for (auto &b : bits) b = std::rand() & 0x1;
+            const unsigned char *inBytes = bytes.data()+1;
+            const unsigned char *inBits = bits.data()+1;
+
+            //bytes to symbols, and the symbols back to bytes
+            std::vector<unsigned char> syms(numSyms+1), symsRef(numSyms+1);
+            std::vector<unsigned char> outBytes(numBytes+1), outBytesRef(numBytes+1);
+            if (order == MSBit)
+            {
+                bytesToSymbolsMSBit(mod, inBytes, syms.data()+1, numBytes);
+                bytesToSymbolsMSBitScalar(mod, inBytes, symsRef.data()+1, numBytes);
+                symbolsToBytesMSBit(mod, syms.data()+1, outBytes.data()+1, numBytes);
+                symbolsToBytesMSBitScalar(mod, symsRef.data()+1, outBytesRef.data()+1, numBytes);
+            }
+            else
+            {
+                bytesToSymbolsLSBit(mod, inBytes, syms.data()+1, numBytes);
+                bytesToSymbolsLSBitScalar(mod, inBytes, symsRef.data()+1, numBytes);
+                symbolsToBytesLSBit(mod, syms.data()+1, outBytes.data()+1, numBytes);
+                symbolsToBytesLSBitScalar(mod, symsRef.data()+1, outBytesRef.data()+1, numBytes);
+            }
+            POTHOS_TEST_EQUALA(syms.data()+1, symsRef.data()+1, numSyms);
+            POTHOS_TEST_EQUALA(outBytes.data()+1, outBytesRef.data()+1, numBytes);
+            POTHOS_TEST_EQUALA(outBytes.data()+1, inBytes, numBytes);
+
+            //bits to symbols, and the symbols back to bits
+            std::vector<unsigned char> outBits(numSyms*mod+1), outBitsRef(numSyms*mod+1);
+            if (order == MSBit)
+            {
+                bitsToSymbolsMSBit(mod, inBits, syms.data()+1, numSyms);
+                bitsToSymbolsMSBitScalar(mod, inBits, symsRef.data()+1, numSyms);
+                symbolsToBitsMSBit(mod, syms.data()+1, outBits.data()+1, numSyms);
+                symbolsToBitsMSBitScalar(mod, symsRef.data()+1, outBitsRef.data()+1, numSyms);
+            }
+            else
+            {
+                bitsToSymbolsLSBit(mod, inBits, syms.data()+1, numSyms);
+                bitsToSymbolsLSBitScalar(mod, inBits, symsRef.data()+1, numSyms);
+                symbolsToBitsLSBit(mod, syms.data()+1, outBits.data()+1, numSyms);
+                symbolsToBitsLSBitScalar(mod, symsRef.data()+1, outBitsRef.data()+1, numSyms);
+            }
+            POTHOS_TEST_EQUALA(syms.data()+1, symsRef.data()+1, numSyms);
+            POTHOS_TEST_EQUALA(outBits.data()+1, outBitsRef.data()+1, numSyms*mod);
+            POTHOS_TEST_EQUALA(outBits.data()+1, inBits, numSyms*mod);
+        }
+    }
+}
@@ -5,7 +5,10 @@
 #include <Pothos/Framework.hpp>
 #include <Pothos/Proxy.hpp>
 #include <iostream>
+#include <cstdint>
 #include <complex>
+#include <cmath>
+#include <algorithm>
 #include <json.hpp>
 
 using json = nlohmann::json;
@@ -142,3 +145,264 @@ POTHOS_TEST_BLOCK("/comms/tests", test_symbol_mapper_gray_code)
     collector.call("verifyTestPlan", expected);
 }
 
+
+POTHOS_TEST_BLOCK("/comms/tests", test_symbol_slicer_regular_maps)
+{
+    //64-QAM in a scrambled order is sliced as a grid
+    std::vector<std::complex<float>> qam;
+    for (int i = 0; i < 8; i++)
+    {
+        for (int q = 0; q < 8; q++) qam.emplace_back(2*((5*i+3)%8)-7, 2*q-7);
+    }
+
+    //8-PSK with a phase offset is sliced by angle
+    std::vector<std::complex<float>> psk;
+    for (int k = 0; k < 8; k++) psk.push_back(std::polar(1.0f, float(M_PI/8 + ((3*k)%8)*M_PI/4)));
+
+    //irregular map uses the distance search
+    std::vector<std::complex<float>> irregular{{0.0f, 0.0f}, {1.0f, 2.0f}, {-3.0f, 0.5f}, {2.0f, -2.0f}};
+
+    for (const auto &map : {qam, psk, irregular})
+    {
+        std::cout << "slice a map of size " << map.size() << std::endl;
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", Pothos::DType(typeid(unsigned char)));
+        auto mapper = Pothos::BlockRegistry::make("/comms/symbol_mapper", Pothos::DType(typeid(std::complex<float>)));
+        auto slicer = Pothos::BlockRegistry::make("/comms/symbol_slicer", Pothos::DType(typeid(std::complex<float>)));
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", Pothos::DType(typeid(unsigned char)));
+        mapper.call("setMap", map);
+        slicer.call("setMap", map);
+
+        json testPlan;
+        testPlan["enableBuffers"] = true;
+        testPlan["minValue"] = 0;
+        testPlan["maxValue"] = map.size()-1;
+        auto expected = feeder.call("feedTestPlan", testPlan.dump());
+
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, mapper, 0);
+        topology.connect(mapper, 0, slicer, 0);
+        topology.connect(slicer, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+        collector.call("verifyTestPlan", expected);
+    }
+
+    //points between and beyond the grid slice to the closest value
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", Pothos::DType(typeid(std::complex<float>)));
+    auto slicer = Pothos::BlockRegistry::make("/comms/symbol_slicer", Pothos::DType(typeid(std::complex<float>)));
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", Pothos::DType(typeid(unsigned char)));
+    slicer.call("setMap", qam);
+
+    const std::vector<std::complex<float>> inputs{{-9.0f, -9.0f}, {0.9f, 2.2f}, {-2.1f, 6.8f}, {20.0f, 0.0f}};
+    auto b0 = Pothos::BufferChunk("complex_float32", inputs.size());
+    std::copy(inputs.begin(), inputs.end(), b0.as<std::complex<float> *>());
+    feeder.call("feedBuffer", b0);
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, slicer, 0);
+        topology.connect(slicer, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), inputs.size());
+    auto pb = buff.as<const unsigned char *>();
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        size_t closest = 0;
+        for (size_t j = 0; j < qam.size(); j++)
+        {
+            if (std::norm(qam[j] - inputs[i]) < std::norm(qam[closest] - inputs[i])) closest = j;
+        }
+        POTHOS_TEST_EQUAL(int(pb[i]), int(closest));
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_soft_demapper)
+{
+    //16-QAM with an arbitrary labelling
+    std::vector<std::complex<float>> map;
+    for (int i = 0; i < 4; i++)
+    {
+        for (int q = 0; q < 4; q++) map.emplace_back(2*((3*i+1)%4)-3, 2*q-3);
+    }
+    const double noiseVar = 0.5;
+
+    //symbols with an offset, so the LLRs are not all equal in magnitude
+    std::vector<std::complex<float>> inputs;
+    for (size_t i = 0; i < 50; i++) inputs.push_back(map[(7*i)%16] + std::complex<float>(0.3f*((i%5)-2), -0.2f*((i%3)-1)));
+
+    for (const std::string outType : {"float32", "int8"})
+    {
+        std::cout << "soft demapper with " << outType << " output" << std::endl;
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "complex_float32");
+        auto demapper = Pothos::BlockRegistry::make("/comms/soft_demapper", "complex_float32", outType);
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", outType);
+        demapper.call("setMap", map);
+        demapper.call("setNoiseVariance", noiseVar);
+
+        auto b0 = Pothos::BufferChunk("complex_float32", inputs.size());
+        std::copy(inputs.begin(), inputs.end(), b0.as<std::complex<float> *>());
+        feeder.call("feedBuffer", b0);
+
+        {
+            Pothos::Topology topology;
+            topology.connect(feeder, 0, demapper, 0);
+            topology.connect(demapper, 0, collector, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+
+        //compare against the max-log LLR, MSBit first
+        Pothos::BufferChunk buff = collector.call("getBuffer");
+        POTHOS_TEST_EQUAL(buff.elements(), inputs.size()*4);
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            for (size_t b = 0; b < 4; b++)
+            {
+                double min0 = 1e9, min1 = 1e9;
+                for (size_t j = 0; j < map.size(); j++)
+                {
+                    const double d = std::norm(inputs[i] - map[j]);
+                    if (((j >> b) & 0x1) != 0) min1 = std::min(min1, d);
+                    else min0 = std::min(min0, d);
+                }
+                const double llr = (min1 - min0)/noiseVar;
+                const size_t k = i*4 + (3-b);
+                if (outType == "float32") POTHOS_TEST_CLOSE(buff.as<const float *>()[k], llr, 1e-4);
+                else POTHOS_TEST_CLOSE(buff.as<const int8_t *>()[k], std::max(-127.0, std::min(127.0, llr)), 0.5001); //rounded
+            }
+        }
+    }
+}
+
+//! The max-log LLR of bit b of the symbol index
+template <typename Type>
+static double maxLogLLR(const Type &x, const std::vector<Type> &map, const size_t b, const double noiseVar)
+{
+    double min0 = 1e9, min1 = 1e9;
+    for (size_t j = 0; j < map.size(); j++)
+    {
+        const double d = std::norm(x - map[j]);
+        if (((j >> b) & 0x1) != 0) min1 = std::min(min1, d);
+        else min0 = std::min(min0, d);
+    }
+    return (min1 - min0)/noiseVar;
+}
+
+//! Run the samples and labels through a soft demapper with float32 output
+template <typename Type>
+static Pothos::Proxy runSoftDemapper(const std::string &dtype, Pothos::Proxy demapper, const std::vector<Type> &inputs, const std::vector<Pothos::Label> &labels = {})
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "float32");
+
+    auto b0 = Pothos::BufferChunk(dtype, inputs.size());
+    std::copy(inputs.begin(), inputs.end(), b0.as<Type *>());
+    feeder.call("feedBuffer", b0);
+    for (const auto &label : labels) feeder.call("feedLabel", label);
+
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, demapper, 0);
+        topology.connect(demapper, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+    return collector;
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_soft_demapper_lsbit)
+{
+    //8-PSK with a gray labelling
+    std::vector<std::complex<float>> map(8);
+    const size_t gray[8] = {0, 1, 3, 2, 6, 7, 5, 4};
+    for (size_t k = 0; k < 8; k++) map[gray[k]] = std::polar(1.0f, float(k*M_PI/4));
+    const double noiseVar = 0.25;
+
+    std::vector<std::complex<float>> inputs;
+    for (size_t i = 0; i < 37; i++) inputs.push_back(std::polar(0.9f + 0.01f*(i%7), float(0.3*i)));
+
+    auto demapper = Pothos::BlockRegistry::make("/comms/soft_demapper", "complex_float32", "float32");
+    demapper.call("setMap", map);
+    demapper.call("setBitOrder", "LSBit");
+    demapper.call("setNoiseVariance", noiseVar);
+    POTHOS_TEST_EQUAL(demapper.call<std::string>("getBitOrder"), "LSBit");
+    auto collector = runSoftDemapper("complex_float32", demapper, inputs);
+
+    //the LLR of bit b is output b of the sample
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), inputs.size()*3);
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        for (size_t b = 0; b < 3; b++)
+        {
+            POTHOS_TEST_CLOSE(buff.as<const float *>()[i*3 + b], maxLogLLR(inputs[i], map, b, noiseVar), 1e-4);
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_soft_demapper_real)
+{
+    //8-PAM with an arbitrary labelling
+    const std::vector<float> map{-7, 5, -1, 3, -5, 7, 1, -3};
+    const double noiseVar = 0.5;
+    const double scale = 2.0;
+
+    std::vector<float> inputs;
+    for (size_t i = 0; i < 45; i++) inputs.push_back(map[(3*i)%8] + 0.4f*((i%5)-2.0f));
+
+    auto demapper = Pothos::BlockRegistry::make("/comms/soft_demapper", "float32", "float32");
+    demapper.call("setMap", map);
+    demapper.call("setNoiseVariance", noiseVar);
+    demapper.call("setScale", scale);
+    auto collector = runSoftDemapper("float32", demapper, inputs);
+
+    //the noise variance is per dimension, so the real LLR is halved, MSBit first
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), inputs.size()*3);
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        for (size_t b = 0; b < 3; b++)
+        {
+            const double llr = scale*maxLogLLR(inputs[i], map, b, 2*noiseVar);
+            POTHOS_TEST_CLOSE(buff.as<const float *>()[i*3 + (2-b)], llr, 1e-4);
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_soft_demapper_noise_label)
+{
+    //QPSK, the noise variance label changes the LLR magnitude mid stream
+    const std::vector<std::complex<float>> map{{-1, -1}, {-1, 1}, {1, 1}, {1, -1}};
+    const double noiseVar0 = 0.5, noiseVar1 = 2.0;
+    const size_t labelIndex = 21; //not a multiple of the search block
+
+    std::vector<std::complex<float>> inputs;
+    for (size_t i = 0; i < 50; i++) inputs.push_back(map[(5*i)%4] + std::complex<float>(0.1f*((i%5)-2), 0.15f*((i%3)-1)));
+
+    auto demapper = Pothos::BlockRegistry::make("/comms/soft_demapper", "complex_float32", "float32");
+    demapper.call("setMap", map);
+    demapper.call("setNoiseVariance", noiseVar0);
+    demapper.call("setLabelId", "noiseVar");
+    auto collector = runSoftDemapper("complex_float32", demapper, inputs, {Pothos::Label("noiseVar", noiseVar1, labelIndex)});
+    POTHOS_TEST_EQUAL(demapper.call<double>("getNoiseVariance"), noiseVar1);
+
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), inputs.size()*2);
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        const double noiseVar = (i < labelIndex)?noiseVar0:noiseVar1;
+        for (size_t b = 0; b < 2; b++)
+        {
+            POTHOS_TEST_CLOSE(buff.as<const float *>()[i*2 + (1-b)], maxLogLLR(inputs[i], map, b, noiseVar), 1e-4);
+        }
+    }
+
+    //the label moves to the first LLR of its sample
+    const auto labels = collector.call<std::vector<Pothos::Label>>("getLabels");
+    POTHOS_TEST_EQUAL(labels.size(), size_t(1));
+    POTHOS_TEST_EQUAL(labels[0].id, "noiseVar");
+    POTHOS_TEST_EQUAL(labels[0].index, labelIndex*2);
+}
@@ -0,0 +1,554 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ConvolutionalCode.hpp"
+#include "common/CpuFeatures.hpp"
+#include <Pothos/Framework.hpp>
+#include <cstdint>
+#include <cstring> //memmove
+#include <cmath> //round
+#include <vector>
+#include <algorithm> //min/max
+
+/***********************************************************************
+ * |PothosDoc Viterbi Decoder
+ *
+ * Decode a stream of coded bits from the Convolutional Encoder block
+ * with the Viterbi algorithm. The polynomials and the puncture pattern
+ * must match the encoder. Punctured positions are decoded as erasures.
+ * The output stream carries one decoded bit per byte in the LSB.
+ *
+ * The input is either soft bits or hard bits:
+ * <ul>
+ * <li>float32 - log-likelihood ratios, where a positive LLR means that the bit
+ * is more likely a 0, like the output of the Soft Demapper block.
+ * The LLRs are multiplied by the input scale and saturated to [-127, 127].</li>
+ * <li>int8 - log-likelihood ratios already scaled to [-127, 127].</li>
+ * <li>uint8 - hard bits, one bit per byte in the LSB.</li>
+ * </ul>
+ *
+ * The path metrics are 16-bit integers with saturating arithmetic.
+ * On x86-64 the add-compare-select of all states runs with SSE2 or AVX2 vectors,
+ * several butterflies per instruction, selected at runtime.
+ *
+ * The decoder outputs a bit once it is the traceback depth older than the newest
+ * input, so the output lags the input by the traceback depth, and the last bits
+ * of a finite stream remain in the decoder. The decoder starts in the zero state on activation.
+ *
+ * |category /Digital
+ * |category /Coding
+ * |keywords convolutional viterbi decoder fec forward error correction puncture llr
+ *
+ * |param dtype[Data Type] The type of the coded input stream.
+ * |option [Float32 LLRs] "float32"
+ * |option [Int8 LLRs] "int8"
+ * |option [Hard bits] "uint8"
+ * |default "float32"
+ * |preview disable
+ *
+ * |param polys[Polynomials] Two generator polynomials in the register bit order.
+ * The constraint length K is the bit length of the largest polynomial, from 3 to 9.
+ * |option [K=7 (0171, 0133)] \[121, 91\]
+ * |option [K=9 (0561, 0753)] \[369, 491\]
+ * |option [K=5 (023, 035)] \[19, 29\]
+ * |option [K=3 (07, 05)] \[7, 5\]
+ * |default [121, 91]
+ * |widget ComboBox(editable=true)
+ *
+ * |param puncture[Puncture Pattern] The repeating puncture pattern of the encoder.
+ * |option [Rate 1/2] \[1, 1\]
+ * |option [Rate 2/3] \[1, 1, 1, 0\]
+ * |option [Rate 3/4] \[1, 1, 1, 0, 0, 1\]
+ * |option [Rate 5/6] \[1, 1, 1, 0, 0, 1, 1, 0, 0, 1\]
+ * |default [1, 1]
+ * |widget ComboBox(editable=true)
+ *
+ * |param depth[Traceback Depth] The number of trellis steps traced back before a bit is decided.
+ * About 5 times the constraint length is enough for rate 1/2; punctured codes need more.
+ * |default 96
+ * |widget SpinBox(minimum=1)
+ * |preview valid
+ *
+ * |param scale[Input Scale] A factor applied to float32 LLRs before they are saturated to 8 bits.
+ * |default 16.0
+ * |preview valid
+ *
+ * |factory /comms/viterbi_decoder(dtype)
+ * |setter setPolynomials(polys)
+ * |setter setPuncture(puncture)
+ * |setter setTracebackDepth(depth)
+ * |setter setInputScale(scale)
+ **********************************************************************/
+
+/***********************************************************************
+ * Trellis tables for the add-compare-select
+ *
+ * The state is the last K-1 input bits with the newest bit in the LSB.
+ * Butterfly i joins the old states A = i and B = i + half
+ * into the new states 2i (input bit 0) and 2i+1 (input bit 1).
+ * The branch metric is the correlation of the soft bits with the
+ * expected coded bits, and the path metrics are maximized.
+ *
+ * The decisions of a step are one bit per new state, in groups of
+ * 8 butterflies: byte 2*(i/8) holds input 0 and byte 2*(i/8)+1 holds
+ * input 1, with butterfly i in bit i%8. This is the order of the
+ * 16-bit lanes after packs and movemask, so the SIMD kernels store
+ * their compare results without shuffling them into the state order.
+ **********************************************************************/
+struct ViterbiTrellis
+{
+    size_t half; //number of butterflies
+    std::vector<int16_t> e0, e1; //sign masks of the coded bits for A -> 2i
+    int selB0, selA1, selB1; //branch metrics of the other transitions
+    bool mirrored; //every polynomial has the oldest and newest bits: B0 = A1 = -S and B1 = S
+};
+
+//! Bytes of decisions per step
+static inline size_t decisionBytes(const size_t half)
+{
+    return 2*((half+7)/8);
+}
+
+//! The decision for the new state j: true when the path came from B
+static inline bool decisionBit(const uint8_t *dec, const size_t j)
+{
+    const size_t i = j >> 1;
+    return ((dec[2*(i >> 3) + (j & 0x1)] >> (i & 0x7)) & 0x1) != 0;
+}
+
+//! Branch metrics for the flips of the coded bits: [S, D, -D, -S] with S = x0 + x1, D = x0 - x1
+static inline int branchSelect(const bool flip0, const bool flip1)
+{
+    return (flip0?2:0) + (flip1?1:0);
+}
+
+/***********************************************************************
+ * Add-compare-select kernels
+ *
+ * Each kernel runs numSteps steps without renormalization, alternating
+ * between the metrics and tmp buffers, and leaves the result in metrics.
+ * The path metrics grow by at most 254 per step and stay within
+ * 2*254*(K-1) of each other, so the caller renormalizes every RENORM_STEPS
+ * and the 16-bit metrics never saturate. Renormalizing outside of the
+ * kernels keeps the loop carried dependency to the add-compare-select.
+ **********************************************************************/
+static const size_t RENORM_STEPS = 32;
+
+static inline void acsStepsScalar(const ViterbiTrellis &t, int16_t *metrics, int16_t *tmp, uint8_t *dec, const int16_t *l0, const int16_t *l1, const size_t numSteps)
+{
+    const size_t half = t.half;
+    const size_t numBytes = decisionBytes(half);
+    int16_t *old = metrics, *next = tmp;
+    for (size_t s = 0; s < numSteps; s++)
+    {
+        std::fill(dec, dec+numBytes, 0);
+        for (size_t i = 0; i < half; i++)
+        {
+            const int x0 = (t.e0[i] != 0)?-l0[s]:l0[s];
+            const int x1 = (t.e1[i] != 0)?-l1[s]:l1[s];
+            const int bm[4] = {x0+x1, x0-x1, x1-x0, -x0-x1};
+            const int mA = old[i], mB = old[i+half];
+            const int m0A = mA + bm[0], m0B = mB + bm[t.selB0];
+            const int m1A = mA + bm[t.selA1], m1B = mB + bm[t.selB1];
+            next[2*i+0] = int16_t(std::max(m0A, m0B));
+            next[2*i+1] = int16_t(std::max(m1A, m1B));
+            dec[2*(i >> 3) + 0] |= ((m0B > m0A)?1:0) << (i & 0x7);
+            dec[2*(i >> 3) + 1] |= ((m1B > m1A)?1:0) << (i & 0x7);
+        }
+        std::swap(old, next);
+        dec += numBytes;
+    }
+    if (old != metrics) std::copy(old, old+2*half, metrics);
+}
+
+#ifdef CPU_FEATURES_X86
+
+//! SSE2 is part of x86-64, 8 butterflies per vector
+template <bool MIRRORED>
+static inline void acsStepsSSE2(const ViterbiTrellis &t, int16_t *metrics, int16_t *tmp, uint8_t *dec, const int16_t *l0, const int16_t *l1, const size_t numSteps)
+{
+    //masks that select D instead of S, and negate, for the other transitions
+    #define SELECT_MASKS(sel) _mm_set1_epi16((((sel) ^ ((sel) >> 1)) & 0x1)?-1:0), _mm_set1_epi16(((sel) & 0x2)?-1:0)
+    const __m128i selB0[2] = {SELECT_MASKS(t.selB0)};
+    const __m128i selA1[2] = {SELECT_MASKS(t.selA1)};
+    const __m128i selB1[2] = {SELECT_MASKS(t.selB1)};
+    #undef SELECT_MASKS
+    #define SELECT(S, SD, sel) _mm_sub_epi16(_mm_xor_si128(_mm_xor_si128(S, _mm_and_si128(SD, sel[0])), sel[1]), sel[1])
+
+    const size_t half = t.half;
+    int16_t *old = metrics, *next = tmp;
+    for (size_t s = 0; s < numSteps; s++)
+    {
+        const __m128i L0 = _mm_set1_epi16(l0[s]);
+        const __m128i L1 = _mm_set1_epi16(l1[s]);
+        for (size_t i = 0; i < half; i += 8)
+        {
+            const __m128i E0 = _mm_loadu_si128((const __m128i *)(t.e0.data()+i));
+            const __m128i E1 = _mm_loadu_si128((const __m128i *)(t.e1.data()+i));
+            const __m128i X0 = _mm_sub_epi16(_mm_xor_si128(L0, E0), E0);
+            const __m128i X1 = _mm_sub_epi16(_mm_xor_si128(L1, E1), E1);
+            const __m128i S = _mm_adds_epi16(X0, X1);
+
+            const __m128i mA = _mm_loadu_si128((const __m128i *)(old+i));
+            const __m128i mB = _mm_loadu_si128((const __m128i *)(old+i+half));
+            __m128i bB0, bA1, bB1;
+            if (MIRRORED)
+            {
+                bB1 = S;
+                bB0 = bA1 = _mm_subs_epi16(_mm_setzero_si128(), S);
+            }
+            else
+            {
+                const __m128i SD = _mm_xor_si128(S, _mm_subs_epi16(X0, X1));
+                bB0 = SELECT(S, SD, selB0);
+                bA1 = SELECT(S, SD, selA1);
+                bB1 = SELECT(S, SD, selB1);
+            }
+            const __m128i m0A = _mm_adds_epi16(mA, S);
+            const __m128i m0B = _mm_adds_epi16(mB, bB0);
+            const __m128i m1A = _mm_adds_epi16(mA, bA1);
+            const __m128i m1B = _mm_adds_epi16(mB, bB1);
+            const __m128i n0 = _mm_max_epi16(m0A, m0B);
+            const __m128i n1 = _mm_max_epi16(m1A, m1B);
+            const __m128i d0 = _mm_cmpgt_epi16(m0B, m0A);
+            const __m128i d1 = _mm_cmpgt_epi16(m1B, m1A);
+
+            //interleave into the new states 2i and 2i+1
+            _mm_storeu_si128((__m128i *)(next+2*i+0), _mm_unpacklo_epi16(n0, n1));
+            _mm_storeu_si128((__m128i *)(next+2*i+8), _mm_unpackhi_epi16(n0, n1));
+            const uint16_t bits = uint16_t(_mm_movemask_epi8(_mm_packs_epi16(d0, d1)));
+            std::memcpy(dec+i/4, &bits, sizeof(bits));
+        }
+        std::swap(old, next);
+        dec += half/4;
+    }
+    #undef SELECT
+    if (old != metrics) std::copy(old, old+2*half, metrics);
+}
+
+//! AVX2 version, 16 butterflies per vector
+template <bool MIRRORED>
+__attribute__((target("avx2")))
+static inline void acsStepsAVX2(const ViterbiTrellis &t, int16_t *metrics, int16_t *tmp, uint8_t *dec, const int16_t *l0, const int16_t *l1, const size_t numSteps)
+{
+    #define SELECT_MASKS(sel) _mm256_set1_epi16((((sel) ^ ((sel) >> 1)) & 0x1)?-1:0), _mm256_set1_epi16(((sel) & 0x2)?-1:0)
+    const __m256i selB0[2] = {SELECT_MASKS(t.selB0)};
+    const __m256i selA1[2] = {SELECT_MASKS(t.selA1)};
+    const __m256i selB1[2] = {SELECT_MASKS(t.selB1)};
+    #undef SELECT_MASKS
+    #define SELECT(S, SD, sel) _mm256_sub_epi16(_mm256_xor_si256(_mm256_xor_si256(S, _mm256_and_si256(SD, sel[0])), sel[1]), sel[1])
+
+    const size_t half = t.half;
+    int16_t *old = metrics, *next = tmp;
+    for (size_t s = 0; s < numSteps; s++)
+    {
+        const __m256i L0 = _mm256_set1_epi16(l0[s]);
+        const __m256i L1 = _mm256_set1_epi16(l1[s]);
+        for (size_t i = 0; i < half; i += 16)
+        {
+            const __m256i E0 = _mm256_loadu_si256((const __m256i *)(t.e0.data()+i));
+            const __m256i E1 = _mm256_loadu_si256((const __m256i *)(t.e1.data()+i));
+            const __m256i X0 = _mm256_sub_epi16(_mm256_xor_si256(L0, E0), E0);
+            const __m256i X1 = _mm256_sub_epi16(_mm256_xor_si256(L1, E1), E1);
+            const __m256i S = _mm256_adds_epi16(X0, X1);
+
+            const __m256i mA = _mm256_loadu_si256((const __m256i *)(old+i));
+            const __m256i mB = _mm256_loadu_si256((const __m256i *)(old+i+half));
+            __m256i bB0, bA1, bB1;
+            if (MIRRORED)
+            {
+                bB1 = S;
+                bB0 = bA1 = _mm256_subs_epi16(_mm256_setzero_si256(), S);
+            }
+            else
+            {
+                const __m256i SD = _mm256_xor_si256(S, _mm256_subs_epi16(X0, X1));
+                bB0 = SELECT(S, SD, selB0);
+                bA1 = SELECT(S, SD, selA1);
+                bB1 = SELECT(S, SD, selB1);
+            }
+            const __m256i m0A = _mm256_adds_epi16(mA, S);
+            const __m256i m0B = _mm256_adds_epi16(mB, bB0);
+            const __m256i m1A = _mm256_adds_epi16(mA, bA1);
+            const __m256i m1B = _mm256_adds_epi16(mB, bB1);
+            const __m256i n0 = _mm256_max_epi16(m0A, m0B);
+            const __m256i n1 = _mm256_max_epi16(m1A, m1B);
+            const __m256i d0 = _mm256_cmpgt_epi16(m0B, m0A);
+            const __m256i d1 = _mm256_cmpgt_epi16(m1B, m1A);
+
+            //unpack interleaves within 128-bit lanes, the permutes restore the state order
+            //whole vector stores keep the store to load forwarding for the next step
+            const __m256i nlo = _mm256_unpacklo_epi16(n0, n1), nhi = _mm256_unpackhi_epi16(n0, n1);
+            _mm256_storeu_si256((__m256i *)(next+2*i+0), _mm256_permute2x128_si256(nlo, nhi, 0x20));
+            _mm256_storeu_si256((__m256i *)(next+2*i+16), _mm256_permute2x128_si256(nlo, nhi, 0x31));
+            const uint32_t bits = uint32_t(_mm256_movemask_epi8(_mm256_packs_epi16(d0, d1)));
+            std::memcpy(dec+i/4, &bits, sizeof(bits));
+        }
+        std::swap(old, next);
+        dec += half/4;
+    }
+    #undef SELECT
+    if (old != metrics) std::copy(old, old+2*half, metrics);
+}
+
+#endif //CPU_FEATURES_X86
+
+//! Run the add-compare-select for numSteps, writing decisionBytes() per step
+static inline void acsBlock(const ViterbiTrellis &t, int16_t *metrics, int16_t *tmp, uint8_t *dec, const int16_t *l0, const int16_t *l1, const size_t numSteps)
+{
+    const size_t numStates = 2*t.half;
+    const size_t numBytes = decisionBytes(t.half);
+    for (size_t s = 0; s < numSteps; s += RENORM_STEPS)
+    {
+        //renormalize to the metric of state 0
+        const int16_t norm = metrics[0];
+        for (size_t j = 0; j < numStates; j++) metrics[j] -= norm;
+
+        const size_t n = std::min(RENORM_STEPS, numSteps-s);
+        uint8_t *d = dec + s*numBytes;
+        #ifdef CPU_FEATURES_X86
+        if (t.half >= 16 and CpuFeatures::avx2())
+        {
+            if (t.mirrored) acsStepsAVX2<true>(t, metrics, tmp, d, l0+s, l1+s, n);
+            else acsStepsAVX2<false>(t, metrics, tmp, d, l0+s, l1+s, n);
+        }
+        else if (t.half >= 8 and CpuFeatures::sse2())
+        {
+            if (t.mirrored) acsStepsSSE2<true>(t, metrics, tmp, d, l0+s, l1+s, n);
+            else acsStepsSSE2<false>(t, metrics, tmp, d, l0+s, l1+s, n);
+        }
+        else
+        #endif
+        acsStepsScalar(t, metrics, tmp, d, l0+s, l1+s, n);
+    }
+}
+
+//! Convert the input to an 8-bit soft bit
+static inline int16_t softBit(const float x, const float scale)
+{
+    return int16_t(std::round(std::max(-127.0f, std::min(127.0f, x*scale))));
+}
+
+static inline int16_t softBit(const int8_t x, const float)
+{
+    return std::max<int16_t>(x, -127);
+}
+
+static inline int16_t softBit(const uint8_t x, const float)
+{
+    return ((x & 0x1) != 0)?-1:1;
+}
+
+/***********************************************************************
+ * Viterbi decoder block
+ **********************************************************************/
+template <typename Type>
+class ViterbiDecoder : public Pothos::Block
+{
+public:
+    ViterbiDecoder(void):
+        _depth(0),
+        _scale(16.0f),
+        _phase(0),
+        _numDecisions(0),
+        _labelDelay(0)
+    {
+        this->setupInput(0, typeid(Type));
+        this->setupOutput(0, typeid(unsigned char));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ViterbiDecoder, setPolynomials));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ViterbiDecoder, getPolynomials));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ViterbiDecoder, setPuncture));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ViterbiDecoder, getPuncture));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ViterbiDecoder, setTracebackDepth));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ViterbiDecoder, getTracebackDepth));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ViterbiDecoder, setInputScale));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ViterbiDecoder, getInputScale));
+        this->setTracebackDepth(96); //initial update
+    }
+
+    void setPolynomials(const std::vector<int> &polys)
+    {
+        _code.setPolynomials("ViterbiDecoder::setPolynomials()", polys);
+        this->updateTrellis();
+    }
+
+    std::vector<int> getPolynomials(void) const
+    {
+        return _code.polys;
+    }
+
+    void setPuncture(const std::vector<int> &pattern)
+    {
+        _code.setPuncture("ViterbiDecoder::setPuncture()", pattern);
+        _phase = 0;
+    }
+
+    std::vector<int> getPuncture(void) const
+    {
+        return _code.puncture;
+    }
+
+    void setTracebackDepth(const size_t depth)
+    {
+        if (depth == 0) throw Pothos::InvalidArgumentException("ViterbiDecoder::setTracebackDepth()", "Traceback depth cannot be 0");
+        _depth = depth;
+        this->updateTrellis();
+    }
+
+    size_t getTracebackDepth(void) const
+    {
+        return _depth;
+    }
+
+    void setInputScale(const float scale)
+    {
+        _scale = scale;
+    }
+
+    float getInputScale(void) const
+    {
+        return _scale;
+    }
+
+    void activate(void)
+    {
+        this->resetState();
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+
+        //the steps that can be decided with the available output space
+        const size_t numBytes = decisionBytes(_trellis.half);
+        const size_t maxSteps = std::min(size_t(MAX_STEPS), outPort->elements() + _depth - _numDecisions);
+
+        //depuncture the input into pairs of soft bits, punctured bits are erasures
+        const Type *in = inPort->buffer();
+        const size_t avail = inPort->elements();
+        const int *puncture = _code.puncture.data();
+        const size_t period = _code.puncture.size();
+        size_t consumed = 0, steps = 0;
+        while (steps < maxSteps)
+        {
+            const bool p0 = puncture[_phase+0] != 0, p1 = puncture[_phase+1] != 0;
+            if (consumed + (p0?1:0) + (p1?1:0) > avail) break;
+            _l0[steps] = p0?softBit(in[consumed++], _scale):0;
+            _l1[steps] = p1?softBit(in[consumed++], _scale):0;
+            _phase += 2;
+            if (_phase == period) _phase = 0;
+            steps++;
+        }
+        if (steps == 0) return;
+
+        //add-compare-select, decisions are appended after the history
+        uint8_t *dec = _decisions.data();
+        acsBlock(_trellis, _metrics.data(), _tmp.data(), dec + _numDecisions*numBytes, _l0.data(), _l1.data(), steps);
+        _labelDelay = _numDecisions;
+        const size_t total = _numDecisions + steps;
+
+        //trace back from the best state, then output the steps older than the depth
+        size_t numOut = 0;
+        if (total > _depth)
+        {
+            numOut = total - _depth;
+            unsigned char *out = outPort->buffer();
+            const size_t best = std::max_element(_metrics.begin(), _metrics.end()) - _metrics.begin();
+            size_t state = best;
+            for (size_t t = total; t-- > 0;)
+            {
+                if (t < numOut) out[t] = state & 0x1;
+                state = (state >> 1) + (decisionBit(dec + t*numBytes, state)?_trellis.half:0);
+            }
+
+            //keep the decisions of the last depth steps
+            std::memmove(dec, dec + numOut*numBytes, _depth*numBytes);
+            _numDecisions = _depth;
+        }
+        else _numDecisions = total;
+
+        inPort->consume(consumed);
+        outPort->produce(numOut);
+    }
+
+    void propagateLabels(const Pothos::InputPort *port)
+    {
+        //labels move to the decoded bit of their step, which is output after the traceback delay
+        auto outputPort = this->output(0);
+        for (const auto &label : port->labels())
+        {
+            auto newLabel = label.toAdjusted(_code.periodBits(), _code.numKept);
+            newLabel.index += _labelDelay;
+            outputPort->postLabel(newLabel);
+        }
+    }
+
+private:
+    //! Steps decoded per call, which bounds the memory for the decisions
+    static const size_t MAX_STEPS = 4096;
+
+    void updateTrellis(void)
+    {
+        const size_t K = _code.K;
+        _trellis.half = size_t(1) << (K-2);
+        _trellis.e0.resize(_trellis.half);
+        _trellis.e1.resize(_trellis.half);
+        for (size_t i = 0; i < _trellis.half; i++)
+        {
+            const unsigned c = _code.outputs(unsigned(2*i));
+            _trellis.e0[i] = ((c >> 0) & 0x1)?-1:0;
+            _trellis.e1[i] = ((c >> 1) & 0x1)?-1:0;
+        }
+
+        //the oldest register bit distinguishes B from A, the newest bit is the input
+        const int top = 1 << (K-1);
+        const auto &g = _code.polys;
+        _trellis.selB0 = branchSelect((g[0] & top) != 0, (g[1] & top) != 0);
+        _trellis.selA1 = branchSelect((g[0] & 1) != 0, (g[1] & 1) != 0);
+        _trellis.selB1 = branchSelect(((g[0] & top) != 0) != ((g[0] & 1) != 0), ((g[1] & top) != 0) != ((g[1] & 1) != 0));
+        _trellis.mirrored = (_trellis.selB0 == 3 and _trellis.selA1 == 3);
+
+        const size_t numStates = 2*_trellis.half;
+        _metrics.resize(numStates);
+        _tmp.resize(numStates);
+        _decisions.resize((_depth + MAX_STEPS)*decisionBytes(_trellis.half));
+        _l0.resize(MAX_STEPS);
+        _l1.resize(MAX_STEPS);
+        this->resetState();
+    }
+
+    void resetState(void)
+    {
+        //the encoder starts in the zero state
+        std::fill(_metrics.begin(), _metrics.end(), int16_t(-4096));
+        _metrics[0] = 0;
+        _numDecisions = 0;
+        _phase = 0;
+    }
+
+    ConvolutionalCode _code;
+    ViterbiTrellis _trellis;
+    size_t _depth;
+    float _scale;
+    size_t _phase; //position in the puncture pattern
+    std::vector<int16_t> _metrics, _tmp;
+    std::vector<uint8_t> _decisions; //one bit per state per step
+    size_t _numDecisions; //steps of history in the decisions
+    std::vector<int16_t> _l0, _l1;
+    size_t _labelDelay;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *ViterbiDecoderFactory(const Pothos::DType &dtype)
+{
+    if (dtype == Pothos::DType(typeid(float))) return new ViterbiDecoder<float>();
+    if (dtype == Pothos::DType(typeid(int8_t))) return new ViterbiDecoder<int8_t>();
+    if (dtype == Pothos::DType(typeid(uint8_t))) return new ViterbiDecoder<uint8_t>();
+    throw Pothos::InvalidArgumentException("ViterbiDecoderFactory("+dtype.toString()+")", "unsupported type");
+}
+
+static Pothos::BlockRegistry registerViterbiDecoder(
+    "/comms/viterbi_decoder", &ViterbiDecoderFactory);
@@ -5,7 +5,9 @@
 #include <cstdint>
 #include <complex>
 #include <cmath>
+#include <memory>
 #include "FFTAux.h"
+#include "FFTBatch.h"
 
 /***********************************************************************
  * |PothosDoc FFT
@@ -17,11 +19,16 @@
  * |keywords dft fft fast fourier transform
  *
  * |param dtype[Data Type] The data type of the input and output element stream.
- * |widget DTypeChooser(cfloat=1, cint=1)
+ * A dimension greater than 1 selects a batched transform over a multi-channel stream:
+ * each element holds one sample per channel, and every channel is transformed
+ * independently in the same call, with the output in the same channel-interleaved layout.
+ * |widget DTypeChooser(cfloat=1, cint=1, dim=1)
  * |default "complex_float32"
  * |preview disable
  *
  * |param numBins[Num FFT Bins] The number of bins per fourier transform.
+ * Any size is supported. For floating point types, sizes with a prime factor
+ * of 41 or more use a Bluestein (chirp-z) plan.
  * |default 1024
  * |option 512
  * |option 1024
@@ -34,27 +41,73 @@
  * |option [Inverse] true
  * |default false
  *
+ * |param numThreads[Num Threads] The number of threads used for large transforms.
+ * When greater than 1, transforms of at least the thread threshold size
+ * are decomposed into a four-step FFT with rows split across threads.
+ * Only supported by floating point types with a dimension of 1.
+ * |default 1
+ * |preview valid
+ * |tab Threading
+ *
+ * |param threadThreshold[Thread Threshold] The minimum FFT size for the threaded transform.
+ * |default 1048576
+ * |preview valid
+ * |tab Threading
+ *
  * |factory /comms/fft(dtype, numBins, inverse)
+ * |setter setNumThreads(numThreads)
+ * |setter setThreadThreshold(threadThreshold)
  **********************************************************************/
 template <typename Type>
 class FFT : public Pothos::Block
 {
 public:
-    FFT(const size_t numBins, const bool inverse):
+    FFT(const size_t numBins, const bool inverse, const size_t dimension):
         _numBins(numBins),
         _inverse(inverse),
-        _fftAux(numBins, inverse)
+        _dimension(dimension),
+        _numThreads(1),
+        _threadThreshold(1 << 20)
     {
-        this->setupInput(0, typeid(Type));
-        this->setupOutput(0, typeid(Type));
+        if (_dimension == 1) _fftAux.reset(new FFTAux<Type>(numBins, inverse));
+        else _fftBatch.reset(new FFTBatch<Type>(numBins, inverse, _dimension));
+        this->setupInput(0, Pothos::DType(typeid(Type), _dimension));
+        this->setupOutput(0, Pothos::DType(typeid(Type), _dimension));
         this->input(0)->setReserve(_numBins);
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, setNumThreads));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, getNumThreads));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, setThreadThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, getThreadThreshold));
+    }
+
+    void setNumThreads(const size_t numThreads)
+    {
+        if (numThreads == 0) throw Pothos::InvalidArgumentException("FFT::setNumThreads()", "number of threads cannot be 0");
+        _numThreads = numThreads;
+        if (_fftAux) _fftAux->setThreading(_numThreads, _threadThreshold);
+    }
+
+    size_t getNumThreads(void) const
+    {
+        return _numThreads;
+    }
+
+    void setThreadThreshold(const size_t threshold)
+    {
+        _threadThreshold = threshold;
+        if (_fftAux) _fftAux->setThreading(_numThreads, _threadThreshold);
+    }
+
+    size_t getThreadThreshold(void) const
+    {
+        return _threadThreshold;
     }
 
     //! Custom output buffer manager with slabs large enough for the fft result
     Pothos::BufferManager::Sptr getOutputBufferManager(const std::string &, const std::string &)
     {
         Pothos::BufferManagerArgs args;
-        args.bufferSize = _numBins*sizeof(Type);
+        args.bufferSize = _numBins*_dimension*sizeof(Type);
         return Pothos::BufferManager::make("generic", args);
     }
 
@@ -63,9 +116,10 @@ public:
         auto inPort = this->input(0);
         auto outPort = this->output(0);
 
-        _fftAux.transform(
-            inPort->buffer().template as<const Type*>(),
-            outPort->buffer().template as<Type*>());
+        const Type *in = inPort->buffer();
+        Type *out = outPort->buffer();
+        if (_fftAux) _fftAux->transform(in, out);
+        else _fftBatch->transform(in, out);
 
         inPort->consume(_numBins);
         outPort->produce(_numBins);
@@ -74,7 +128,11 @@ public:
 private:
     const size_t _numBins;
     const bool _inverse;
-    FFTAux<Type> _fftAux;
+    const size_t _dimension;
+    size_t _numThreads;
+    size_t _threadThreshold;
+    std::unique_ptr<FFTAux<Type>> _fftAux;
+    std::unique_ptr<FFTBatch<Type>> _fftBatch;
 };
 
 /***********************************************************************
@@ -83,7 +141,8 @@ private:
 static Pothos::Block *FFTFactory(const Pothos::DType &dtype, const size_t numBins, const bool inverse)
 {
     #define ifTypeDeclareFactory__(Type) \
-        if (dtype == Pothos::DType(typeid(Type))) return new FFT<Type>(numBins, inverse);
+        if (Pothos::DType::fromDType(dtype, 1) == Pothos::DType(typeid(Type))) \
+            return new FFT<Type>(numBins, inverse, dtype.dimension());
     #define ifTypeDeclareFactory(Type) \
         ifTypeDeclareFactory__(std::complex<Type>)
     ifTypeDeclareFactory(double);
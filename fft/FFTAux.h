@@ -1,9 +1,15 @@
 #pragma once
 
 #include <complex>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
 
 #include "kissfft.hh"
 #include "kiss_fft.h"
+#include "FFTBluestein.h"
+#include "FFTFourStep.h"
 
 template<typename Type>
 class FFTAux {
@@ -13,36 +19,133 @@ private:
     FFTAux(size_t numBins, bool inverse) = delete;
 };
 
+/*!
+ * Largest prime factor of n.
+ * kissfft has specialized butterflies for radix 2, 3, 4, and 5,
+ * any other factor falls back to the O(p^2) generic butterfly.
+ */
+static inline size_t fftLargestPrimeFactor(size_t n)
+{
+    size_t largest = 1;
+    for (size_t p = 2; p*p <= n; p++)
+    {
+        while (n % p == 0)
+        {
+            largest = p;
+            n /= p;
+        }
+    }
+    return std::max(largest, n);
+}
+
+/*!
+ * Use the Bluestein plan when the largest prime factor is at least this.
+ * The generic butterfly costs O(p) per sample for a prime factor p,
+ * while Bluestein costs three power of two transforms of at least 2N-1 points.
+ * Measured with kissfft, the mixed radix plan wins up to a factor of about 37.
+ */
+static const size_t FFT_BLUESTEIN_MIN_PRIME = 41;
+
+static inline bool fftUseBluestein(const size_t n)
+{
+    return fftLargestPrimeFactor(n) >= FFT_BLUESTEIN_MIN_PRIME;
+}
+
 template<typename Type>
 class FFTAux<std::complex<Type>> {
 public:
-    inline FFTAux(size_t numBins, bool inverse) : _fftFloat(numBins, inverse) {}
+    inline FFTAux(size_t numBins, bool inverse):
+        _numBins(numBins),
+        _inverse(inverse)
+    {
+        if (fftUseBluestein(numBins)) _fftBluestein.reset(new FFTBluestein<Type>(numBins, inverse));
+        else _fftFloat.reset(new kissfft<Type>(int(numBins), inverse));
+    }
+
+    /*!
+     * Enable the multi-threaded four-step plan for large sizes.
+     * The plan is used when numThreads > 1 and the size is at least threshold.
+     */
+    inline void setThreading(size_t numThreads, size_t threshold) {
+        _fftFourStep.reset();
+        if (numThreads <= 1 or _numBins < threshold) return;
+        if (FFTFourStep<Type, FFTAux>::rowSize(_numBins) == 1) return; //prime size
+        _fftFourStep.reset(new FFTFourStep<Type, FFTAux>(_numBins, _inverse, numThreads));
+    }
 
     inline void transform(const std::complex<Type> *input, std::complex<Type> *output) {
-        _fftFloat.transform(input, output);
+        if (_fftFourStep) _fftFourStep->transform(input, output);
+        else if (_fftBluestein) _fftBluestein->transform(input, output);
+        else _fftFloat->transform(input, output);
+    }
+
+    //! True when the Bluestein plan was selected for this size
+    inline bool usesBluestein(void) const {
+        return bool(_fftBluestein);
     }
 
 private:
-    kissfft<Type> _fftFloat;
+    const size_t _numBins;
+    const bool _inverse;
+    std::unique_ptr<kissfft<Type>> _fftFloat;
+    std::unique_ptr<FFTBluestein<Type>> _fftBluestein;
+    std::unique_ptr<FFTFourStep<Type, FFTAux>> _fftFourStep;
+};
+
+/*!
+ * Heap buffer with its start aligned to a 64 byte cache line.
+ */
+class FFTAlignedBuffer {
+public:
+    static const size_t ALIGNMENT = 64;
+
+    inline FFTAlignedBuffer(void) : _data(nullptr) {}
+
+    inline void resize(const size_t numBytes) {
+        _storage.reset(new char[numBytes + ALIGNMENT]);
+        const auto addr = reinterpret_cast<size_t>(_storage.get());
+        _data = _storage.get() + ((ALIGNMENT - (addr % ALIGNMENT)) % ALIGNMENT);
+    }
+
+    inline void *data(void) const {
+        return _data;
+    }
+
+private:
+    std::unique_ptr<char[]> _storage;
+    char *_data;
 };
 
 template<>
 class FFTAux<std::complex<kiss_fft_scalar>> {
 public:
-    inline FFTAux(size_t numBins, bool inverse) : _fftFixed(nullptr) {
-        _fftFixed = kiss_fft_alloc(numBins, inverse, nullptr, nullptr);
-    }
+    inline FFTAux(size_t numBins, bool inverse) : _numBins(numBins), _fftFixed(nullptr) {
+        //place the config and twiddles in aligned memory owned by this object
+        size_t lenmem = 0;
+        kiss_fft_alloc(int(numBins), inverse, nullptr, &lenmem);
+        _cfgMem.resize(lenmem);
+        _fftFixed = kiss_fft_alloc(int(numBins), inverse, _cfgMem.data(), &lenmem);
 
-    inline ~FFTAux() {
-        kiss_fft_free(_fftFixed);
+        //preallocate generic butterfly scratch so transform() never allocates
+        _scratchMem.resize(std::max<size_t>(kiss_fft_scratch_size(_fftFixed), 1)*sizeof(kiss_fft_cpx));
     }
 
+    //! The threaded plan is only available for floating point types
+    inline void setThreading(size_t, size_t) {}
+
     inline void transform(const std::complex<kiss_fft_scalar> *input, std::complex<kiss_fft_scalar> *output) {
-        kiss_fft(_fftFixed,
+        //kissfft is out-of-place only, in-place would need a temporary buffer per call
+        if (input < output+_numBins and output < input+_numBins) throw std::invalid_argument(
+            "FFTAux::transform() input and output buffers overlap");
+        kiss_fft_scratch(_fftFixed,
             reinterpret_cast<const kiss_fft_cpx*>(input),
-            reinterpret_cast<kiss_fft_cpx*>(output));
+            reinterpret_cast<kiss_fft_cpx*>(output),
+            reinterpret_cast<kiss_fft_cpx*>(_scratchMem.data()));
     }
 
 private:
+    const size_t _numBins;
+    FFTAlignedBuffer _cfgMem;
+    FFTAlignedBuffer _scratchMem;
     kiss_fft_cfg _fftFixed;
 };
@@ -0,0 +1,319 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <complex>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <algorithm>
+
+#include "FFTAux.h"
+
+/***********************************************************************
+ * Batched FFT over channel-interleaved frames.
+ *
+ * The input is numBins elements of numChans channels each,
+ * so channel c of bin n is at in[n*numChans + c].
+ * Every channel is transformed independently, and the output
+ * uses the same interleaved layout.
+ **********************************************************************/
+template<typename Type>
+class FFTBatch {
+private:
+    // Don't allow to use this class without specialization.
+    FFTBatch() = delete;
+    FFTBatch(size_t numBins, bool inverse, size_t numChans) = delete;
+};
+
+/***********************************************************************
+ * Floating point: mixed radix kernel with channels as the inner loop.
+ * Each butterfly loads its twiddle once and applies it to every channel,
+ * so the inner loop is unit stride and vectorizes across channels.
+ * Radix 2, 3, 4 and 5 have specialized butterflies like kissfft.
+ * Sizes with a large prime factor de-interleave each channel
+ * through FFTAux instead, which uses the Bluestein plan.
+ **********************************************************************/
+template<typename Type>
+class FFTBatch<std::complex<Type>> {
+public:
+    typedef std::complex<Type> cpx_type;
+
+    inline FFTBatch(size_t numBins, bool inverse, size_t numChans):
+        _nfft(numBins),
+        _numChans(numChans),
+        _inverse(inverse)
+    {
+        if (fftUseBluestein(numBins))
+        {
+            _fallback.reset(new FFTAux<cpx_type>(numBins, inverse));
+            _chanIn.resize(numBins);
+            _chanOut.resize(numBins);
+            return;
+        }
+
+        const double pi = 3.141592653589793238462643383279502884;
+        const double phinc = (inverse?2:-2)*pi/double(numBins);
+        _twiddles.resize(numBins);
+        for (size_t i = 0; i < numBins; i++) _twiddles[i] = std::polar<Type>(1, Type(phinc*double(i)));
+
+        //factor out 4's, then 2's, then odd factors, same as kissfft
+        size_t n = numBins, p = 4, maxRadix = 1;
+        do {
+            while (n % p)
+            {
+                p = (p == 4)?2:((p == 2)?3:p+2);
+                if (p*p > n) p = n;
+            }
+            n /= p;
+            _stageRadix.push_back(p);
+            _stageRemainder.push_back(n);
+            maxRadix = std::max(maxRadix, p);
+        } while (n > 1);
+
+        _scratch.resize(maxRadix*numChans);
+    }
+
+    inline void transform(const cpx_type *input, cpx_type *output)
+    {
+        if (not _fallback) return this->work(0, output, input, 1);
+        for (size_t c = 0; c < _numChans; c++)
+        {
+            for (size_t n = 0; n < _nfft; n++) _chanIn[n] = input[n*_numChans + c];
+            _fallback->transform(_chanIn.data(), _chanOut.data());
+            for (size_t n = 0; n < _nfft; n++) output[n*_numChans + c] = _chanOut[n];
+        }
+    }
+
+private:
+    //! complex multiply without the NaN/Inf recovery of operator*, which blocks vectorization
+    static inline cpx_type cmul(const cpx_type &a, const cpx_type &b)
+    {
+        return cpx_type(a.real()*b.real() - a.imag()*b.imag(), a.real()*b.imag() + a.imag()*b.real());
+    }
+
+    void work(const size_t stage, cpx_type *Fout, const cpx_type *f, const size_t fstride)
+    {
+        const size_t D = _numChans;
+        const size_t p = _stageRadix[stage];
+        const size_t m = _stageRemainder[stage];
+
+        if (m == 1)
+        {
+            for (size_t q = 0; q < p; q++)
+            {
+                const auto src = f + q*fstride*D;
+                for (size_t c = 0; c < D; c++) Fout[q*D + c] = src[c];
+            }
+        }
+        else
+        {
+            //p smaller DFTs of size m, each on a decimated input
+            for (size_t q = 0; q < p; q++)
+            {
+                this->work(stage+1, Fout + q*m*D, f + q*fstride*D, fstride*p);
+            }
+        }
+
+        switch (p)
+        {
+        case 2: this->bfly2(Fout, fstride, m); break;
+        case 3: this->bfly3(Fout, fstride, m); break;
+        case 4: this->bfly4(Fout, fstride, m); break;
+        case 5: this->bfly5(Fout, fstride, m); break;
+        default: this->bflyGeneric(Fout, fstride, m, p); break;
+        }
+    }
+
+    void bfly2(cpx_type *Fout, const size_t fstride, const size_t m)
+    {
+        const size_t D = _numChans;
+        for (size_t k = 0; k < m; k++)
+        {
+            const auto tw = _twiddles[k*fstride];
+            auto F0 = Fout + k*D;
+            auto F1 = Fout + (k+m)*D;
+            for (size_t c = 0; c < D; c++)
+            {
+                const auto t = cmul(F1[c], tw);
+                F1[c] = F0[c] - t;
+                F0[c] += t;
+            }
+        }
+    }
+
+    void bfly3(cpx_type *Fout, const size_t fstride, const size_t m)
+    {
+        const size_t D = _numChans;
+        const Type epi3 = _twiddles[fstride*m].imag();
+        for (size_t k = 0; k < m; k++)
+        {
+            const auto tw1 = _twiddles[k*fstride];
+            const auto tw2 = _twiddles[k*fstride*2];
+            auto F0 = Fout + k*D;
+            auto F1 = Fout + (k+m)*D;
+            auto F2 = Fout + (k+2*m)*D;
+            for (size_t c = 0; c < D; c++)
+            {
+                const auto s1 = cmul(F1[c], tw1);
+                const auto s2 = cmul(F2[c], tw2);
+                const auto s3 = s1 + s2;
+                const auto s0 = (s1 - s2)*epi3;
+                const auto f1 = F0[c] - s3*Type(0.5);
+                F0[c] += s3;
+                F1[c] = cpx_type(f1.real() - s0.imag(), f1.imag() + s0.real());
+                F2[c] = cpx_type(f1.real() + s0.imag(), f1.imag() - s0.real());
+            }
+        }
+    }
+
+    void bfly4(cpx_type *Fout, const size_t fstride, const size_t m)
+    {
+        const size_t D = _numChans;
+        const Type sign = _inverse?-1:1;
+        for (size_t k = 0; k < m; k++)
+        {
+            const auto tw1 = _twiddles[k*fstride];
+            const auto tw2 = _twiddles[k*fstride*2];
+            const auto tw3 = _twiddles[k*fstride*3];
+            auto F0 = Fout + k*D;
+            auto F1 = Fout + (k+m)*D;
+            auto F2 = Fout + (k+2*m)*D;
+            auto F3 = Fout + (k+3*m)*D;
+            for (size_t c = 0; c < D; c++)
+            {
+                const auto s0 = cmul(F1[c], tw1);
+                const auto s1 = cmul(F2[c], tw2);
+                const auto s2 = cmul(F3[c], tw3);
+                const auto s5 = F0[c] - s1;
+                const auto s3 = s0 + s2;
+                const auto s4 = s0 - s2;
+                const cpx_type s4rot(s4.imag()*sign, -s4.real()*sign);
+                const auto f0 = F0[c] + s1;
+                F2[c] = f0 - s3;
+                F0[c] = f0 + s3;
+                F1[c] = s5 + s4rot;
+                F3[c] = s5 - s4rot;
+            }
+        }
+    }
+
+    void bfly5(cpx_type *Fout, const size_t fstride, const size_t m)
+    {
+        const size_t D = _numChans;
+        const auto ya = _twiddles[fstride*m];
+        const auto yb = _twiddles[fstride*2*m];
+        for (size_t k = 0; k < m; k++)
+        {
+            const auto tw1 = _twiddles[k*fstride];
+            const auto tw2 = _twiddles[k*fstride*2];
+            const auto tw3 = _twiddles[k*fstride*3];
+            const auto tw4 = _twiddles[k*fstride*4];
+            auto F0 = Fout + k*D;
+            auto F1 = Fout + (k+m)*D;
+            auto F2 = Fout + (k+2*m)*D;
+            auto F3 = Fout + (k+3*m)*D;
+            auto F4 = Fout + (k+4*m)*D;
+            for (size_t c = 0; c < D; c++)
+            {
+                const auto s0 = F0[c];
+                const auto s1 = cmul(F1[c], tw1);
+                const auto s2 = cmul(F2[c], tw2);
+                const auto s3 = cmul(F3[c], tw3);
+                const auto s4 = cmul(F4[c], tw4);
+                const auto s7 = s1 + s4;
+                const auto s10 = s1 - s4;
+                const auto s8 = s2 + s3;
+                const auto s9 = s2 - s3;
+                F0[c] = s0 + s7 + s8;
+
+                const auto s5 = s0 + s7*ya.real() + s8*yb.real();
+                const cpx_type s6(s10.imag()*ya.imag() + s9.imag()*yb.imag(), -s10.real()*ya.imag() - s9.real()*yb.imag());
+                F1[c] = s5 - s6;
+                F4[c] = s5 + s6;
+
+                const auto s11 = s0 + s7*yb.real() + s8*ya.real();
+                const cpx_type s12(s9.imag()*ya.imag() - s10.imag()*yb.imag(), s10.real()*yb.imag() - s9.real()*ya.imag());
+                F2[c] = s11 + s12;
+                F3[c] = s11 - s12;
+            }
+        }
+    }
+
+    void bflyGeneric(cpx_type *Fout, const size_t fstride, const size_t m, const size_t p)
+    {
+        const size_t D = _numChans;
+        for (size_t u = 0; u < m; u++)
+        {
+            for (size_t q = 0; q < p; q++)
+            {
+                const auto src = Fout + (u + q*m)*D;
+                for (size_t c = 0; c < D; c++) _scratch[q*D + c] = src[c];
+            }
+
+            size_t k = u;
+            for (size_t q1 = 0; q1 < p; q1++)
+            {
+                auto dst = Fout + k*D;
+                for (size_t c = 0; c < D; c++) dst[c] = _scratch[c];
+                size_t twidx = 0;
+                for (size_t q = 1; q < p; q++)
+                {
+                    twidx += fstride*k;
+                    if (twidx >= _nfft) twidx -= _nfft;
+                    const auto tw = _twiddles[twidx];
+                    const auto src = _scratch.data() + q*D;
+                    for (size_t c = 0; c < D; c++) dst[c] += cmul(src[c], tw);
+                }
+                k += m;
+            }
+        }
+    }
+
+    const size_t _nfft;
+    const size_t _numChans;
+    const bool _inverse;
+    std::vector<cpx_type> _twiddles;
+    std::vector<size_t> _stageRadix;
+    std::vector<size_t> _stageRemainder;
+    std::vector<cpx_type> _scratch;
+    std::unique_ptr<FFTAux<cpx_type>> _fallback;
+    std::vector<cpx_type> _chanIn;
+    std::vector<cpx_type> _chanOut;
+};
+
+/***********************************************************************
+ * Fixed point: de-interleave each channel through the kiss_fft path,
+ * which handles the per-stage scaling for the integer type.
+ **********************************************************************/
+template<>
+class FFTBatch<std::complex<kiss_fft_scalar>> {
+public:
+    typedef std::complex<kiss_fft_scalar> cpx_type;
+
+    inline FFTBatch(size_t numBins, bool inverse, size_t numChans):
+        _nfft(numBins),
+        _numChans(numChans),
+        _fft(numBins, inverse),
+        _chanIn(numBins),
+        _chanOut(numBins)
+    {}
+
+    inline void transform(const cpx_type *input, cpx_type *output)
+    {
+        for (size_t c = 0; c < _numChans; c++)
+        {
+            for (size_t n = 0; n < _nfft; n++) _chanIn[n] = input[n*_numChans + c];
+            _fft.transform(_chanIn.data(), _chanOut.data());
+            for (size_t n = 0; n < _nfft; n++) output[n*_numChans + c] = _chanOut[n];
+        }
+    }
+
+private:
+    const size_t _nfft;
+    const size_t _numChans;
+    FFTAux<cpx_type> _fft;
+    std::vector<cpx_type> _chanIn;
+    std::vector<cpx_type> _chanOut;
+};
@@ -0,0 +1,96 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <complex>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+#include "kissfft.hh"
+
+/***********************************************************************
+ * Bluestein (chirp-z) FFT for arbitrary sizes.
+ *
+ * The N-point DFT is re-expressed as a circular convolution
+ * of length M >= 2N-1, where M is a power of two.
+ * The convolution runs on kissfft with only radix 2/4 butterflies,
+ * so sizes with large prime factors avoid the generic O(p^2) butterfly.
+ * https://en.wikipedia.org/wiki/Chirp_Z-transform#Bluestein.27s_algorithm
+ **********************************************************************/
+template <typename Type>
+class FFTBluestein
+{
+public:
+    typedef std::complex<Type> cpx_type;
+
+    FFTBluestein(const size_t nfft, const bool inverse):
+        _nfft(nfft),
+        _mfft(convolutionSize(nfft)),
+        _fwd(int(_mfft), false),
+        _inv(int(_mfft), true),
+        _chirp(nfft),
+        _kernel(_mfft),
+        _work0(_mfft),
+        _work1(_mfft)
+    {
+        //chirp w[n] = exp(-+j*pi*n^2/N), the index n^2 is reduced mod 2N
+        //so the phase argument stays small and accurate for large sizes
+        const double pi = 3.141592653589793238462643383279502884;
+        const double sign = inverse?1.0:-1.0;
+        const unsigned long long mod = 2*(unsigned long long)(_nfft);
+        for (size_t n = 0; n < _nfft; n++)
+        {
+            const unsigned long long nsq = ((unsigned long long)(n)*n) % mod;
+            const double phase = sign*pi*double(nsq)/double(_nfft);
+            _chirp[n] = cpx_type(Type(std::cos(phase)), Type(std::sin(phase)));
+        }
+
+        //convolution kernel is the conjugate chirp, wrapped for circular convolution
+        std::vector<cpx_type> kernel(_mfft, cpx_type(0));
+        kernel[0] = std::conj(_chirp[0]);
+        for (size_t n = 1; n < _nfft; n++)
+        {
+            kernel[n] = kernel[_mfft-n] = std::conj(_chirp[n]);
+        }
+
+        //store the kernel spectrum pre-scaled by the inverse transform gain
+        _fwd.transform(kernel.data(), _kernel.data());
+        const Type scale = Type(1)/Type(_mfft);
+        for (auto &k : _kernel) k *= scale;
+    }
+
+    void transform(const cpx_type *input, cpx_type *output)
+    {
+        //modulate and zero pad the input
+        for (size_t n = 0; n < _nfft; n++) _work0[n] = input[n]*_chirp[n];
+        for (size_t n = _nfft; n < _mfft; n++) _work0[n] = cpx_type(0);
+
+        //fast convolution with the chirp kernel
+        _fwd.transform(_work0.data(), _work1.data());
+        for (size_t n = 0; n < _mfft; n++) _work1[n] *= _kernel[n];
+        _inv.transform(_work1.data(), _work0.data());
+
+        //demodulate the result
+        for (size_t n = 0; n < _nfft; n++) output[n] = _work0[n]*_chirp[n];
+    }
+
+    //! The power of two convolution length used for an N-point transform
+    static size_t convolutionSize(const size_t nfft)
+    {
+        size_t m = 1;
+        while (m < 2*nfft-1) m <<= 1;
+        return m;
+    }
+
+private:
+    const size_t _nfft;
+    const size_t _mfft;
+    kissfft<Type> _fwd;
+    kissfft<Type> _inv;
+    std::vector<cpx_type> _chirp;
+    std::vector<cpx_type> _kernel;
+    std::vector<cpx_type> _work0;
+    std::vector<cpx_type> _work1;
+};
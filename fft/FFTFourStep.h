@@ -0,0 +1,157 @@
+// Copyright (c) 2026 Pothos Comms contributors
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include "common/ThreadPool.hpp"
+#include <complex>
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+/***********************************************************************
+ * Multi-threaded four-step (six-step with transposes) FFT.
+ *
+ * The N-point transform is factored as N = N1*N2 and computed as
+ * N2 row FFTs of size N1, a twiddle multiply, and N1 row FFTs of size N2.
+ * Cache-blocked transposes keep every row FFT on contiguous memory,
+ * and the rows of each pass are split across worker threads.
+ * https://en.wikipedia.org/wiki/Cooley%E2%80%93Tukey_FFT_algorithm
+ *
+ * SubFFT provides the row transforms: SubFFT(size, inverse) and
+ * SubFFT::transform(in, out). Each task of a pass owns its own sub-plans,
+ * so the sub-plans do not need to be re-entrant.
+ * The worker threads are created once with the plan and reused by every transform.
+ **********************************************************************/
+template <typename Type, typename SubFFT>
+class FFTFourStep
+{
+public:
+    typedef std::complex<Type> cpx_type;
+
+    FFTFourStep(const size_t nfft, const bool inverse, const size_t numThreads):
+        _n1(rowSize(nfft)),
+        _n2(nfft/_n1),
+        _numThreads(std::max<size_t>(numThreads, 1)),
+        _pool(new ThreadPool(_numThreads)),
+        _work0(nfft),
+        _work1(nfft)
+    {
+        for (size_t i = 0; i < _numThreads; i++)
+        {
+            _fft1.emplace_back(new SubFFT(_n1, inverse));
+            _fft2.emplace_back(new SubFFT(_n2, inverse));
+        }
+
+        //twiddle W^m = coarse[m/n1]*fine[m%n1], where W = exp(-+j*2*pi/N)
+        //two small tables replace an N-entry table for very large sizes
+        const double pi = 3.141592653589793238462643383279502884;
+        const double phinc = (inverse?2:-2)*pi/double(nfft);
+        _twFine.resize(_n1);
+        for (size_t i = 0; i < _n1; i++) _twFine[i] = std::polar<double>(1.0, phinc*double(i));
+        _twCoarse.resize(_n2);
+        for (size_t i = 0; i < _n2; i++) _twCoarse[i] = std::polar<double>(1.0, phinc*double(i*_n1));
+    }
+
+    void transform(const cpx_type *input, cpx_type *output)
+    {
+        //input viewed as n1 rows by n2 columns -> n2 rows of n1 samples
+        this->transpose(input, _work0.data(), _n1, _n2);
+
+        //row FFTs of size n1 and twiddle multiply W^(row*col)
+        this->parallelFor(_n2, [this](const size_t task, const size_t begin, const size_t end)
+        {
+            for (size_t r = begin; r < end; r++)
+            {
+                auto row = _work1.data() + r*_n1;
+                _fft1[task]->transform(_work0.data() + r*_n1, row);
+                //track m = r*c mod N as hi*n1 + lo without a division per sample
+                const size_t incHi = r/_n1, incLo = r%_n1;
+                size_t hi = 0, lo = 0;
+                for (size_t c = 0; c < _n1; c++)
+                {
+                    const auto tw = _twCoarse[hi]*_twFine[lo];
+                    row[c] *= cpx_type(Type(tw.real()), Type(tw.imag()));
+                    hi += incHi; lo += incLo;
+                    if (lo >= _n1) {lo -= _n1; hi++;}
+                    if (hi >= _n2) hi -= _n2;
+                }
+            }
+        });
+
+        //n2 rows by n1 columns -> n1 rows of n2 samples
+        this->transpose(_work1.data(), _work0.data(), _n2, _n1);
+
+        //row FFTs of size n2
+        this->parallelFor(_n1, [this](const size_t task, const size_t begin, const size_t end)
+        {
+            for (size_t r = begin; r < end; r++)
+            {
+                _fft2[task]->transform(_work0.data() + r*_n2, _work1.data() + r*_n2);
+            }
+        });
+
+        //bin k1 + n1*k2 is at row k1, column k2
+        this->transpose(_work1.data(), output, _n1, _n2);
+    }
+
+    /*!
+     * The row size n1 for an N-point transform:
+     * the largest divisor of N that is not larger than sqrt(N).
+     * A result of 1 means N is prime and cannot be decomposed.
+     */
+    static size_t rowSize(const size_t nfft)
+    {
+        size_t n1 = size_t(std::sqrt(double(nfft)));
+        while (n1 > 1 and (nfft % n1) != 0) n1--;
+        return std::max<size_t>(n1, 1);
+    }
+
+private:
+    //! Cache-blocked transpose of a rows x cols matrix, split across threads
+    void transpose(const cpx_type *in, cpx_type *out, const size_t rows, const size_t cols)
+    {
+        static const size_t BLOCK = 32;
+        const size_t numRowBlocks = (rows + BLOCK - 1)/BLOCK;
+        this->parallelFor(numRowBlocks, [=](const size_t, const size_t begin, const size_t end)
+        {
+            for (size_t rb = begin*BLOCK; rb < std::min(end*BLOCK, rows); rb += BLOCK)
+            {
+                const size_t rEnd = std::min(rb+BLOCK, rows);
+                for (size_t cb = 0; cb < cols; cb += BLOCK)
+                {
+                    const size_t cEnd = std::min(cb+BLOCK, cols);
+                    for (size_t r = rb; r < rEnd; r++)
+                    {
+                        for (size_t c = cb; c < cEnd; c++) out[c*rows + r] = in[r*cols + c];
+                    }
+                }
+            }
+        });
+    }
+
+    //! Run fcn(task, begin, end) over [0, count) split into up to _numThreads tasks
+    template <typename Fcn>
+    void parallelFor(const size_t count, const Fcn &fcn)
+    {
+        const size_t numTasks = std::min(_numThreads, count);
+        if (numTasks <= 1) return fcn(0, 0, count);
+        _pool->run(numTasks, [&](const size_t task)
+        {
+            fcn(task, (count*task)/numTasks, (count*(task+1))/numTasks);
+        });
+    }
+
+    const size_t _n1;
+    const size_t _n2;
+    const size_t _numThreads;
+    std::unique_ptr<ThreadPool> _pool;
+    std::vector<std::unique_ptr<SubFFT>> _fft1;
+    std::vector<std::unique_ptr<SubFFT>> _fft2;
+    std::vector<std::complex<double>> _twFine;
+    std::vector<std::complex<double>> _twCoarse;
+    std::vector<cpx_type> _work0;
+    std::vector<cpx_type> _work1;
+};
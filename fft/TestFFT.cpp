@@ -4,9 +4,14 @@
 #include <Pothos/Testing.hpp>
 #include <Pothos/Framework.hpp>
 #include <Pothos/Proxy.hpp>
+#include "FFTAux.h"
 #include <iostream>
 #include <vector>
 #include <complex>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
 
 POTHOS_TEST_BLOCK("/comms/tests", test_fft_float)
 {
@@ -156,3 +161,251 @@ POTHOS_TEST_BLOCK("/comms/tests", test_fft_short)
         POTHOS_TEST_TRUE(std::abs(pb[i].imag()-input[i].imag()) < 0.01);
     }
 }
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fft_prime_size)
+{
+    //a prime size exercises the Bluestein plan selection
+    const size_t numBins = 1009;
+    std::vector<std::complex<double>> input(numBins);
+    for (auto &x : input) x = std::complex<double>((std::rand()%2000)/1000.0-1.0, (std::rand()%2000)/1000.0-1.0);
+
+    //create blocks
+    const auto dtype = Pothos::DType(typeid(std::complex<double>));
+    auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+    source.call("setElements", input);
+    source.call("setMode", "ONCE");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+    auto fft = Pothos::BlockRegistry::make("/comms/fft", dtype, numBins, false);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(source, 0, fft, 0);
+        topology.connect(fft, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check a few bins against a direct DFT
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), numBins);
+    auto pb = buff.as<const std::complex<double> *>();
+    for (size_t k = 0; k < numBins; k += 97)
+    {
+        std::complex<double> expected(0);
+        for (size_t n = 0; n < numBins; n++)
+        {
+            expected += input[n]*std::polar(1.0, -2*M_PI*double((k*n)%numBins)/numBins);
+        }
+        POTHOS_TEST_TRUE(std::abs(pb[k]-expected) < 1e-6);
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fft_bluestein_large_prime)
+{
+    //the plan only depends on the largest prime factor
+    POTHOS_TEST_TRUE(not FFTAux<std::complex<double>>(1024, false).usesBluestein());
+    POTHOS_TEST_TRUE(not FFTAux<std::complex<double>>(4*37, false).usesBluestein());
+    POTHOS_TEST_TRUE(FFTAux<std::complex<double>>(8*41, false).usesBluestein());
+
+    const size_t numBins = 65537;
+    FFTAux<std::complex<double>> fft(numBins, false);
+    POTHOS_TEST_TRUE(fft.usesBluestein());
+
+    std::vector<std::complex<double>> input(numBins), output(numBins);
+    for (auto &x : input) x = std::complex<double>((std::rand()%2000)/1000.0-1.0, (std::rand()%2000)/1000.0-1.0);
+    fft.transform(input.data(), output.data());
+
+    //check a few bins against a direct DFT
+    for (size_t k = 0; k < numBins; k += 4099)
+    {
+        std::complex<double> expected(0);
+        for (size_t n = 0; n < numBins; n++)
+        {
+            expected += input[n]*std::polar(1.0, -2*M_PI*double((k*n)%numBins)/numBins);
+        }
+        POTHOS_TEST_TRUE(std::abs(output[k]-expected) < 1e-6);
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fft_threaded)
+{
+    //the four-step plan on worker threads matches the single-threaded plan
+    const size_t numBins = 1 << 18;
+    const size_t numFFTs = 3;
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    auto b0 = Pothos::BufferChunk(dtype, numBins*numFFTs);
+    auto p0 = b0.as<std::complex<float> *>();
+    for (size_t i = 0; i < numBins*numFFTs; i++)
+    {
+        p0[i] = std::complex<float>((std::rand()%2000)/1000.0f-1.0f, (std::rand()%2000)/1000.0f-1.0f);
+    }
+
+    std::vector<Pothos::BufferChunk> outputs;
+    for (const size_t numThreads : {size_t(1), size_t(4)})
+    {
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+        auto fft = Pothos::BlockRegistry::make("/comms/fft", dtype, numBins, false);
+        fft.call("setNumThreads", numThreads);
+        fft.call("setThreadThreshold", numBins);
+        feeder.call("feedBuffer", b0);
+        {
+            Pothos::Topology topology;
+            topology.connect(feeder, 0, fft, 0);
+            topology.connect(fft, 0, collector, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+        outputs.push_back(collector.call<Pothos::BufferChunk>("getBuffer"));
+        POTHOS_TEST_EQUAL(outputs.back().elements(), numBins*numFFTs);
+    }
+
+    //bins are about sqrt(numBins) in magnitude, allow for float rounding
+    auto pSingle = outputs[0].as<const std::complex<float> *>();
+    auto pThreaded = outputs[1].as<const std::complex<float> *>();
+    float maxErr = 0;
+    for (size_t i = 0; i < numBins*numFFTs; i++) maxErr = std::max(maxErr, std::abs(pSingle[i]-pThreaded[i]));
+    std::cout << "threaded FFT max error " << maxErr << std::endl;
+    POTHOS_TEST_TRUE(maxErr < 0.05f);
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fft_batched)
+{
+    //same vectors as test_fft_float: channel 0 is the input, channel 1 is twice the input
+    const std::vector<std::complex<float>> input{{0.4f, 0.6f}, {-0.7f, 0.6f}, {-0.2f, 0.8f}, {0.9f, 0.2f}};
+    const std::vector<std::complex<float>> result{{0.4f, 2.2f}, {1.0f, 1.4f}, {0.0f, 0.6f}, {0.2f, -1.8f}};
+    const size_t numChans = 2;
+
+    //create blocks
+    const auto dtype = Pothos::DType(typeid(std::complex<float>), numChans);
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+    auto fft = Pothos::BlockRegistry::make("/comms/fft", dtype, input.size(), false);
+
+    //load the interleaved channels
+    auto b0 = Pothos::BufferChunk(dtype, input.size());
+    auto p0 = b0.as<std::complex<float> *>();
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        p0[i*numChans + 0] = input[i];
+        p0[i*numChans + 1] = input[i]*2.0f;
+    }
+    feeder.call("feedBuffer", b0);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, fft, 0);
+        topology.connect(fft, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the buffer
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), result.size());
+    auto pb = buff.as<const std::complex<float> *>();
+    for (size_t i = 0; i < result.size(); i++)
+    {
+        for (size_t c = 0; c < numChans; c++)
+        {
+            const auto expected = result[i]*float(c+1);
+            const auto actual = pb[i*numChans + c];
+            POTHOS_TEST_TRUE(std::abs(actual.real()-expected.real()) < 0.01);
+            POTHOS_TEST_TRUE(std::abs(actual.imag()-expected.imag()) < 0.01);
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fft_batched_sizes)
+{
+    //radix 3 and 5 butterflies, the generic butterfly, and the per-channel Bluestein fallback
+    const size_t numChans = 3;
+    const auto dtype = Pothos::DType(typeid(std::complex<double>), numChans);
+    for (const size_t numBins : {size_t(60), size_t(45), size_t(125), size_t(63), size_t(41), size_t(1009)})
+    {
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+        auto fft = Pothos::BlockRegistry::make("/comms/fft", dtype, numBins, false);
+
+        auto b0 = Pothos::BufferChunk(dtype, numBins);
+        auto p0 = b0.as<std::complex<double> *>();
+        for (size_t i = 0; i < numBins*numChans; i++)
+        {
+            p0[i] = std::complex<double>((std::rand()%2000)/1000.0-1.0, (std::rand()%2000)/1000.0-1.0);
+        }
+        feeder.call("feedBuffer", b0);
+
+        {
+            Pothos::Topology topology;
+            topology.connect(feeder, 0, fft, 0);
+            topology.connect(fft, 0, collector, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+
+        //every channel matches the single channel transform
+        Pothos::BufferChunk buff = collector.call("getBuffer");
+        POTHOS_TEST_EQUAL(buff.elements(), numBins);
+        auto pb = buff.as<const std::complex<double> *>();
+        FFTAux<std::complex<double>> ref(numBins, false);
+        std::vector<std::complex<double>> chanIn(numBins), chanOut(numBins);
+        for (size_t c = 0; c < numChans; c++)
+        {
+            for (size_t n = 0; n < numBins; n++) chanIn[n] = p0[n*numChans + c];
+            ref.transform(chanIn.data(), chanOut.data());
+            for (size_t n = 0; n < numBins; n++)
+            {
+                POTHOS_TEST_TRUE(std::abs(pb[n*numChans + c]-chanOut[n]) < 1e-9);
+            }
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fft_fixed_generic_radix)
+{
+    //radix 7 and 11 run the generic butterfly of the fixed point plan on the preallocated scratch
+    typedef std::complex<kiss_fft_scalar> FixedType;
+    const size_t numBins = 7*11;
+    FFTAux<FixedType> fft(numBins, false);
+
+    //the scratch is reused across calls, so transform several inputs with one plan
+    std::vector<FixedType> input(numBins), output(numBins);
+    for (size_t iter = 0; iter < 3; iter++)
+    {
+        for (auto &x : input) x = FixedType(kiss_fft_scalar(std::rand()%20000-10000), kiss_fft_scalar(std::rand()%20000-10000));
+        fft.transform(input.data(), output.data());
+
+        //the fixed point forward transform is scaled by 1/numBins,
+        //allow for a few LSBs of rounding in each stage
+        for (size_t k = 0; k < numBins; k++)
+        {
+            std::complex<double> expected(0);
+            for (size_t n = 0; n < numBins; n++)
+            {
+                const std::complex<double> x(input[n].real(), input[n].imag());
+                expected += x*std::polar(1.0, -2*M_PI*double((k*n)%numBins)/numBins);
+            }
+            expected /= double(numBins);
+            const std::complex<double> actual(output[k].real(), output[k].imag());
+            POTHOS_TEST_TRUE(std::abs(actual-expected) < 8.0);
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fft_fixed_overlap)
+{
+    //the fixed point plan is out-of-place only and rejects aliased buffers
+    typedef std::complex<kiss_fft_scalar> FixedType;
+    const size_t numBins = 7*11;
+    FFTAux<FixedType> fft(numBins, false);
+    std::vector<FixedType> buff(2*numBins);
+    POTHOS_TEST_THROWS(fft.transform(buff.data(), buff.data()), std::invalid_argument);
+    POTHOS_TEST_THROWS(fft.transform(buff.data(), buff.data()+1), std::invalid_argument);
+    POTHOS_TEST_THROWS(fft.transform(buff.data()+numBins-1, buff.data()), std::invalid_argument);
+
+    //adjacent buffers do not overlap
+    fft.transform(buff.data(), buff.data()+numBins);
+    fft.transform(buff.data()+numBins, buff.data());
+}
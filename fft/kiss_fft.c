@@ -200,7 +200,8 @@ static void kf_bfly_generic(
         const size_t fstride,
         const kiss_fft_cfg st,
         int m,
-        int p
+        int p,
+        kiss_fft_cpx * userScratch
         )
 {
     int u,k,q1,q;
@@ -208,7 +209,8 @@ static void kf_bfly_generic(
     kiss_fft_cpx t;
     int Norig = st->nfft;
 
-    kiss_fft_cpx * scratch = (kiss_fft_cpx*)KISS_FFT_TMP_ALLOC(sizeof(kiss_fft_cpx)*p);
+    /* use the caller's preallocated scratch when provided */
+    kiss_fft_cpx * scratch = userScratch?userScratch:(kiss_fft_cpx*)KISS_FFT_TMP_ALLOC(sizeof(kiss_fft_cpx)*p);
 
     for ( u=0; u<m; ++u ) {
         k=u;
@@ -231,7 +233,7 @@ static void kf_bfly_generic(
             k += m;
         }
     }
-    KISS_FFT_TMP_FREE(scratch);
+    if (!userScratch) KISS_FFT_TMP_FREE(scratch);
 }
 
 static
@@ -241,7 +243,8 @@ void kf_work(
         const size_t fstride,
         int in_stride,
         int * factors,
-        const kiss_fft_cfg st
+        const kiss_fft_cfg st,
+        kiss_fft_cpx * scratch
         )
 {
     kiss_fft_cpx * Fout_beg=Fout;
@@ -259,7 +262,7 @@ void kf_work(
         // execute the p different work units in different threads
 #       pragma omp parallel for
         for (k=0;k<p;++k) 
-            kf_work( Fout +k*m, f+ fstride*in_stride*k,fstride*p,in_stride,factors,st);
+            kf_work( Fout +k*m, f+ fstride*in_stride*k,fstride*p,in_stride,factors,st,NULL);
         // all threads have joined by this point
 
         switch (p) {
@@ -267,7 +270,7 @@ void kf_work(
             case 3: kf_bfly3(Fout,fstride,st,m); break; 
             case 4: kf_bfly4(Fout,fstride,st,m); break;
             case 5: kf_bfly5(Fout,fstride,st,m); break; 
-            default: kf_bfly_generic(Fout,fstride,st,m,p); break;
+            default: kf_bfly_generic(Fout,fstride,st,m,p,scratch); break;
         }
         return;
     }
@@ -284,7 +287,7 @@ void kf_work(
             // DFT of size m*p performed by doing
             // p instances of smaller DFTs of size m, 
             // each one takes a decimated version of the input
-            kf_work( Fout , f, fstride*p, in_stride, factors,st);
+            kf_work( Fout , f, fstride*p, in_stride, factors,st,scratch);
             f += fstride*in_stride;
         }while( (Fout += m) != Fout_end );
     }
@@ -297,7 +300,7 @@ void kf_work(
         case 3: kf_bfly3(Fout,fstride,st,m); break; 
         case 4: kf_bfly4(Fout,fstride,st,m); break;
         case 5: kf_bfly5(Fout,fstride,st,m); break; 
-        default: kf_bfly_generic(Fout,fstride,st,m,p); break;
+        default: kf_bfly_generic(Fout,fstride,st,m,p,scratch); break;
     }
 }
 
@@ -374,11 +377,11 @@ void kiss_fft_stride(kiss_fft_cfg st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout,
         //NOTE: this is not really an in-place FFT algorithm.
         //It just performs an out-of-place FFT into a temp buffer
         kiss_fft_cpx * tmpbuf = (kiss_fft_cpx*)KISS_FFT_TMP_ALLOC( sizeof(kiss_fft_cpx)*st->nfft);
-        kf_work(tmpbuf,fin,1,in_stride, st->factors,st);
+        kf_work(tmpbuf,fin,1,in_stride, st->factors,st,NULL);
         memcpy(fout,tmpbuf,sizeof(kiss_fft_cpx)*st->nfft);
         KISS_FFT_TMP_FREE(tmpbuf);
     }else{
-        kf_work( fout, fin, 1,in_stride, st->factors,st );
+        kf_work( fout, fin, 1,in_stride, st->factors,st,NULL );
     }
 }
 
@@ -387,6 +390,25 @@ void kiss_fft(kiss_fft_cfg cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout)
     kiss_fft_stride(cfg,fin,fout,1);
 }
 
+size_t kiss_fft_scratch_size(kiss_fft_cfg st)
+{
+    size_t maxRadix = 0;
+    const int * factors = st->factors;
+    int m;
+    do {
+        const int p = *factors++;
+        m = *factors++;
+        /* only the generic butterfly uses scratch space */
+        if (p > 5 && (size_t)p > maxRadix) maxRadix = (size_t)p;
+    } while (m > 1);
+    return maxRadix;
+}
+
+void kiss_fft_scratch(kiss_fft_cfg st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout,kiss_fft_cpx *scratch)
+{
+    kf_work( fout, fin, 1, 1, st->factors, st, scratch );
+}
+
 
 void kiss_fft_cleanup(void)
 {
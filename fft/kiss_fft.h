@@ -103,6 +103,24 @@ void kiss_fft(kiss_fft_cfg cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout);
  * */
 void kiss_fft_stride(kiss_fft_cfg cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout,int fin_stride);
 
+/*
+ * kiss_fft_scratch_size(cfg)
+ *
+ * The number of kiss_fft_cpx elements of scratch space needed by kiss_fft_scratch().
+ * The result is 0 when the factorization of nfft only uses radix 2, 3, 4, and 5.
+ * */
+size_t kiss_fft_scratch_size(kiss_fft_cfg cfg);
+
+/*
+ * kiss_fft_scratch(cfg,fin,fout,scratch)
+ *
+ * Perform an out-of-place FFT using caller-provided scratch space
+ * of at least kiss_fft_scratch_size(cfg) elements,
+ * so that no temporary memory is allocated during the transform.
+ * fin and fout must not overlap.
+ * */
+void kiss_fft_scratch(kiss_fft_cfg cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout,kiss_fft_cpx *scratch);
+
 /* If kiss_fft_alloc allocated a buffer, it is one contiguous 
    buffer and can be simply free()d when no longer needed*/
 #define kiss_fft_free free
@@ -3,14 +3,6 @@
 #include <complex>
 #include <vector>
 
-#ifdef _MSC_VER
-#include <malloc.h> //alloca
-#endif //_MSC_VER
-
-#ifdef HAS_ALLOCA_H
-#include <alloca.h>
-#endif //HAS_ALLOCA_H
-
 namespace kissfft_utils {
 
 template <typename T_scalar>
@@ -76,6 +68,10 @@ class kissfft
             :_nfft(nfft),_inverse(inverse),_traits(traits)
         {
             _traits.prepare(_twiddles, _nfft,_inverse ,_stageRadix, _stageRemainder);
+            int maxRadix = 1;
+            for (size_t i=0;i<_stageRadix.size();++i)
+                if (_stageRadix[i] > maxRadix) maxRadix = _stageRadix[i];
+            _scratchbuf.resize(maxRadix);
         }
 
         void transform(const cpx_type * src , cpx_type * dst)
@@ -273,11 +269,8 @@ class kissfft
             cpx_type * twiddles = &_twiddles[0];
             cpx_type t;
             int Norig = _nfft;
-            #ifdef KISS_FFT_USE_ALLOCA
-            cpx_type *scratchbuf = (cpx_type *)alloca(p*sizeof(cpx_type));
-            #else
-            cpx_type scratchbuf[p];
-            #endif
+            //preallocated in the constructor: no per-call stack or heap allocation
+            cpx_type *scratchbuf = &_scratchbuf[0];
 
             for ( u=0; u<m; ++u ) {
                 k=u;
@@ -307,6 +300,7 @@ class kissfft
         std::vector<cpx_type> _twiddles;
         std::vector<int> _stageRadix;
         std::vector<int> _stageRemainder;
+        std::vector<cpx_type> _scratchbuf;
         traits_type _traits;
 };
 #endif
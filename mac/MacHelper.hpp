@@ -3,30 +3,49 @@
 
 #pragma once
 #include <Pothos/Config.hpp>
+#include <Pothos/Framework.hpp>
+#include "common/Crc.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <cstring> //memcpy
 
-//https://chromium.googlesource.com/chromiumos/platform/vboot_reference/+/master/firmware/lib/crc8.c
-/* Copyright (c) 2013 The Chromium OS Authors. All rights reserved.
-* Use of this source code is governed by a BSD-style license that can be
-* found in the LICENSE file.
-*/
+/**
+* Return CRC-8 of the data, using x^8 + x^2 + x + 1 polynomial.
+* The table-based engine keeps the CRC cheap for large packets. */
+inline uint8_t Crc8(const void *vptr, const size_t len)
+{
+    static const CrcEngine crc("Crc8()", "CRC-8");
+    return uint8_t(crc.compute(vptr, len));
+}
 
 /**
-* Return CRC-8 of the data, using x^8 + x^2 + x + 1 polynomial. A table-based
-* algorithm would be faster, but for only a few bytes it isn't worth the code
-* size. */
-inline uint8_t Crc8(const void *vptr, int len)
+* Allocate a payload of length bytes with headroom bytes of unused space in front,
+* so that lower layers can write their headers in place. */
+inline Pothos::BufferChunk allocPayload(const size_t length, const size_t headroom)
 {
-    const uint8_t *data = (const uint8_t *)vptr;
-    unsigned crc = 0;
-    int i, j;
-    for (j = len; j; j--, data++) {
-    crc ^= (*data << 8);
-    for(i = 8; i; i--) {
-    if (crc & 0x8000)
-    crc ^= (0x1070 << 3);
-    crc <<= 1;
-    }
+    Pothos::BufferChunk buff(headroom + length);
+    buff.address += headroom;
+    buff.length = length;
+    return buff;
+}
+
+/**
+* Make room for a header of headerSize bytes in front of the payload.
+* When the payload is the only reference to its buffer and has enough headroom,
+* the payload grows in place over the headroom without a copy.
+* Otherwise the payload is copied into a new buffer with the given headroom.
+* The header bytes are left for the caller to fill in. */
+inline void prependHeader(Pothos::BufferChunk &payload, const size_t headerSize, const size_t headroom)
+{
+    const auto &buffer = payload.getBuffer();
+    if (payload.unique() and buffer.getAlias() == 0 and payload.address >= buffer.getAddress() + headerSize)
+    {
+        payload.address -= headerSize;
+        payload.length += headerSize;
+        return;
     }
-    return (uint8_t)(crc >> 8);
+    auto buff = allocPayload(headerSize + payload.length, headroom);
+    buff.dtype = payload.dtype;
+    std::memcpy(buff.as<uint8_t *>() + headerSize, payload.as<const uint8_t *>(), payload.length);
+    payload = buff;
 }
@@ -9,7 +9,7 @@
 #include <chrono>
 #include <iostream>
 #include <cstdint>
-#include <cstring> //memcpy
+#include "MacHelper.hpp"
 
 /***********************************************************************
  * |PothosDoc Simple LLC
@@ -31,6 +31,14 @@
  * The port number is used for both source and destination addressing.
  * Communicating pairs of LLC blocks should use the same port number.
  *
+ * <h3>Header in place</h3>
+ * The LLC writes its 4-byte header in front of the user data without a copy
+ * when the payload buffer is unique and has at least 4 bytes of unused space in front.
+ * Otherwise the payload is copied into a new buffer that reserves the headroom bytes
+ * in front of the LLC header, so that the Simple MAC can write its header in place.
+ * Because the LLC keeps the data packets for resending,
+ * the MAC copies data packets and only writes the header of control packets in place.
+ *
  * <h2>Interfaces</h2>
  * The Simple LLC block has 4 ports that operate on packet streams:
  * <ul>
@@ -67,12 +75,18 @@
  * |param windowSize[Window Size] The number of packets allowed out before an acknowledgment is required.
  * |default 4
  *
+ * |param headroom[Headroom] The unused bytes in front of the packets that the LLC allocates.
+ * The default leaves room for the Simple MAC header.
+ * |default 7
+ * |preview valid
+ *
  * |factory /comms/simple_llc()
  * |setter setPort(port)
  * |setter setRecipient(recipient)
  * |setter setResendTimeout(resendTimeout)
  * |setter setExpireTimeout(expireTimeout)
  * |setter setWindowSize(windowSize)
+ * |setter setHeadroom(headroom)
  **********************************************************************/
 class SimpleLlc : public Pothos::Block
 {
@@ -86,6 +100,7 @@ public:
         _port(0),
         _recipient(0),
         _windowSize(0),
+        _headroom(7),
         _seqBase(0),
         _seqOut(0),
         _reqSeq(0),
@@ -100,6 +115,8 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(SimpleLlc, setResendTimeout));
         this->registerCall(this, POTHOS_FCN_TUPLE(SimpleLlc, setExpireTimeout));
         this->registerCall(this, POTHOS_FCN_TUPLE(SimpleLlc, setWindowSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SimpleLlc, setHeadroom));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SimpleLlc, getHeadroom));
         this->registerCall(this, POTHOS_FCN_TUPLE(SimpleLlc, getResendCount));
         this->registerCall(this, POTHOS_FCN_TUPLE(SimpleLlc, getExpiredCount));
         this->registerProbe("getResendCount");
@@ -188,6 +205,16 @@ public:
         _sentPackets.set_capacity(_windowSize);
     }
 
+    void setHeadroom(const size_t headroom)
+    {
+        _headroom = headroom;
+    }
+
+    size_t getHeadroom(void) const
+    {
+        return _headroom;
+    }
+
     unsigned long long getResendCount(void) const
     {
         return _resendCount;
@@ -276,17 +303,13 @@ public:
         {
             //extract the packet
             auto msg = _dataIn->popMessage();
-            const auto &pktIn = msg.extract<Pothos::Packet>();
-            const auto &data = pktIn.payload;
+            Pothos::Packet pktOut = msg.extract<Pothos::Packet>();
+            msg = Pothos::Object(); //release the message so the payload can be unique
 
-            //append the LLC header
-            Pothos::Packet pktOut = pktIn;
+            //prepend the LLC header
             pktOut.metadata = _metadata;
-            pktOut.payload = Pothos::BufferChunk(data.length + 4);
-            pktOut.payload.dtype = pktIn.payload.dtype;
-            uint8_t *byteBuf = pktOut.payload;
-            fillHeader(byteBuf, _seqOut++, PSH);
-            std::memcpy(byteBuf + 4, data.as<const uint8_t*>(), data.length);
+            prependHeader(pktOut.payload, 4, _headroom);
+            fillHeader(pktOut.payload.as<uint8_t *>(), _seqOut++, PSH);
             _macOut->postMessage(pktOut);
 
             //save the packet for resending
@@ -324,7 +347,7 @@ private:
         // that previous packet could be reused, so as to avoid reallocation of buffer space that happens below
         Pothos::Packet packet;
         packet.metadata = _metadata;
-        packet.payload = Pothos::BufferChunk(4);
+        packet.payload = allocPayload(4, _headroom);
         fillHeader(packet.payload.as<uint8_t *>(), nonce, control);
         _macOut->postMessage(std::move(packet));
     }
@@ -359,6 +382,7 @@ private:
     std::chrono::high_resolution_clock::duration _resendTimeout;
     std::chrono::high_resolution_clock::duration _expireTimeout;
     uint16_t _windowSize;
+    size_t _headroom;
 
     //sender side state
     Pothos::Util::SpinLock _lock;
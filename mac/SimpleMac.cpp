@@ -15,6 +15,13 @@
  *
  * https://en.wikipedia.org/wiki/Media_access_control
  *
+ * <h3>Header in place</h3>
+ * The MAC writes its 7-byte header in front of the payload without a copy
+ * when the payload buffer is unique and has at least 7 bytes of unused space in front,
+ * like the payloads that the Simple LLC block allocates.
+ * Otherwise the payload is copied into a new buffer that reserves the headroom bytes
+ * in front of the header for the headers of lower layers.
+ *
  * <h3>Error recovery</h3>
  * When the simple MAC detects a packet checksum error, it simply drops the packet.
  * The MAC block does not handle packet loss, error recovery, or resending of data.
@@ -43,14 +50,20 @@
  * and is used to check the recipient ID for incoming PHY packets.
  * |default 0
  *
+ * |param headroom[Headroom] The unused bytes in front of the PHY packets that the MAC allocates.
+ * |default 0
+ * |preview valid
+ *
  * |factory /comms/simple_mac()
  * |setter setMacId(macId)
+ * |setter setHeadroom(headroom)
  **********************************************************************/
 class SimpleMac : public Pothos::Block
 {
 public:
     SimpleMac(void):
         _id(0),
+        _headroom(0),
         _errorCount(0)
     {
         this->setupInput("phyIn");
@@ -59,6 +72,8 @@ public:
         this->setupOutput("macOut");
         this->registerCall(this, POTHOS_FCN_TUPLE(SimpleMac, setMacId));
         this->registerCall(this, POTHOS_FCN_TUPLE(SimpleMac, getMacId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SimpleMac, setHeadroom));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SimpleMac, getHeadroom));
         this->registerCall(this, POTHOS_FCN_TUPLE(SimpleMac, getErrorCount));
         this->registerProbe("getErrorCount");
     }
@@ -86,6 +101,16 @@ public:
         return _id;
     }
 
+    void setHeadroom(const size_t headroom)
+    {
+        _headroom = headroom;
+    }
+
+    size_t getHeadroom(void) const
+    {
+        return _headroom;
+    }
+
     unsigned long long getErrorCount(void) const
     {
         return _errorCount;
@@ -106,6 +131,7 @@ public:
 
         // checking for the unfinished packet
         if (packetLength > pkt.payload.length) return Pothos::BufferChunk();
+        if (packetLength < headerSize) return Pothos::BufferChunk();
 
         if (recipientId != _id) return Pothos::BufferChunk();
 
@@ -145,21 +171,19 @@ public:
         if (_macIn->hasMessage())
         {
             auto msg = _macIn->popMessage();
-            const auto &pktIn = msg.extract<Pothos::Packet>();
-            const auto &data = pktIn.payload;
+            Pothos::Packet pktOut = msg.extract<Pothos::Packet>();
+            msg = Pothos::Object(); //release the message so the payload can be unique
 
-            auto recipientIdIter = pktIn.metadata.find("recipient");
-            if (recipientIdIter == pktIn.metadata.end())
+            auto recipientIdIter = pktOut.metadata.find("recipient");
+            if (recipientIdIter == pktOut.metadata.end())
             {
                 _errorCount++;
                 return;
             }
             auto recipientId = recipientIdIter->second.convert<uint16_t>();
-    
-            auto packetLength = data.length + 7;
-            Pothos::Packet pktOut = pktIn;
-            pktOut.payload = Pothos::BufferChunk(packetLength);
-            pktOut.payload.dtype = pktIn.payload.dtype;
+
+            prependHeader(pktOut.payload, 7, _headroom);
+            auto packetLength = pktOut.payload.length;
             auto byteBuf = pktOut.payload.as<uint8_t *>();
 
             // Data byte format: CRC SENDER_MSB SENDER_LSB RECIPIENT_MSB RECIPIENT_LSB LENGTH_MSB LENGTH_LSB
@@ -169,7 +193,6 @@ public:
             byteBuf[4] = recipientId & 0xFF;
             byteBuf[5] = packetLength >> 8;
             byteBuf[6] = packetLength & 0xFF;
-            std::memcpy(byteBuf + 7, data.as<const uint8_t*>(), data.length);
             byteBuf[0] = Crc8(byteBuf + 1, packetLength - 1);
 
             _phyOut->postMessage(std::move(pktOut));
@@ -178,6 +201,7 @@ public:
 
 private:
     size_t _id;
+    size_t _headroom;
     unsigned long long _errorCount;
     Pothos::OutputPort *_phyOut;
     Pothos::OutputPort *_macOut;
@@ -198,3 +198,52 @@ POTHOS_TEST_BLOCK("/comms/tests", test_simple_llc_harsh)
     collectorA.call("verifyTestPlan", expectedB2A);
     collectorB.call("verifyTestPlan", expectedA2B);
 }
+
+POTHOS_TEST_BLOCK("/comms/tests", test_simple_llc_headroom)
+{
+    //create test blocks, with long timeouts so that the LLC sends once
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+    auto llcCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+    auto phyCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+    auto llc = Pothos::BlockRegistry::make("/comms/simple_llc");
+    llc.call("setRecipient", 0xB);
+    llc.call("setResendTimeout", 10.0);
+    llc.call("setExpireTimeout", 10.0);
+    auto mac = Pothos::BlockRegistry::make("/comms/simple_mac");
+    mac.call("setMacId", 0xA);
+
+    //create a test packet
+    Pothos::Packet pkt0;
+    pkt0.payload = Pothos::BufferChunk("uint8", 100);
+    for (size_t i = 0; i < pkt0.payload.elements(); i++)
+        pkt0.payload.as<unsigned char *>()[i] = std::rand() & 0xff;
+    feeder.call("feedPacket", pkt0);
+
+    //setup the topology
+    Pothos::Topology topology;
+    topology.connect(feeder, 0, llc, "dataIn");
+    topology.connect(llc, "macOut", mac, "macIn");
+    topology.connect(llc, "macOut", llcCollector, 0);
+    topology.connect(mac, "phyOut", phyCollector, 0);
+
+    //run the design
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+
+    //the LLC copies the shared user data into a buffer with headroom for the MAC
+    const std::vector<Pothos::Packet> llcPackets = llcCollector.call("getPackets");
+    POTHOS_TEST_EQUAL(llcPackets.size(), 1);
+    const auto &llcPayload = llcPackets.at(0).payload;
+    POTHOS_TEST_EQUAL(llcPayload.elements(), 4 + pkt0.payload.elements());
+    POTHOS_TEST_EQUAL(llcPayload.address, llcPayload.getBuffer().getAddress() + 7);
+    POTHOS_TEST_EQUALA(llcPayload.as<const unsigned char *>() + 4,
+        pkt0.payload.as<const unsigned char *>(), pkt0.payload.elements());
+
+    //the LLC keeps the data packet for resending, so the MAC copies it
+    const std::vector<Pothos::Packet> phyPackets = phyCollector.call("getPackets");
+    POTHOS_TEST_EQUAL(phyPackets.size(), 1);
+    POTHOS_TEST_TRUE(phyPackets.at(0).payload.address != llcPayload.address - 7);
+    POTHOS_TEST_EQUAL(phyPackets.at(0).payload.elements(), 7 + llcPayload.elements());
+    POTHOS_TEST_EQUALA(phyPackets.at(0).payload.as<const unsigned char *>() + 7,
+        llcPayload.as<const unsigned char *>(), llcPayload.elements());
+}
@@ -5,6 +5,8 @@
 #include <Pothos/Framework.hpp>
 #include <Pothos/Proxy.hpp>
 #include <iostream>
+#include <cstring> //memcpy, memset
+#include <vector>
 
 POTHOS_TEST_BLOCK("/comms/tests", test_simple_mac)
 {
@@ -55,3 +57,85 @@ POTHOS_TEST_BLOCK("/comms/tests", test_simple_mac)
     POTHOS_TEST_TRUE(topology.waitInactive());
     POTHOS_TEST_EQUAL(mac.call<unsigned long long>("getErrorCount"), 1);
 }
+
+/***********************************************************************
+ * A payload of random bytes with 7 bytes of unused space in front,
+ * and the front bytes set to a marker to detect writes
+ **********************************************************************/
+static Pothos::BufferChunk makeHeadroomPayload(const std::vector<unsigned char> &data)
+{
+    auto buff = Pothos::BufferChunk("uint8", 7 + data.size());
+    std::memset(buff.as<void *>(), 0xa5, 7);
+    buff.address += 7;
+    buff.length = data.size();
+    std::memcpy(buff.as<void *>(), data.data(), data.size());
+    return buff;
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_simple_mac_headroom)
+{
+    //create test blocks
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+    auto phyCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+    auto mac = Pothos::BlockRegistry::make("/comms/simple_mac");
+    const unsigned short macId = std::rand() & 0xffff;
+    mac.call("setMacId", macId);
+
+    std::vector<std::vector<unsigned char>> expected(2, std::vector<unsigned char>(1000));
+    for (auto &data : expected) for (auto &byte : data) byte = std::rand() & 0xff;
+
+    //only the feeder holds the first payload, so the header is written in place
+    size_t uniqueAddress = 0;
+    {
+        Pothos::Packet pkt0;
+        pkt0.payload = makeHeadroomPayload(expected[0]);
+        pkt0.metadata["recipient"] = Pothos::Object(macId);
+        uniqueAddress = pkt0.payload.address;
+        feeder.call("feedPacket", pkt0);
+    }
+
+    //the test keeps the second payload, so it is shared and the MAC copies it
+    Pothos::Packet pkt1;
+    pkt1.payload = makeHeadroomPayload(expected[1]);
+    pkt1.metadata["recipient"] = Pothos::Object(macId);
+    feeder.call("feedPacket", pkt1);
+
+    //setup the topology
+    Pothos::Topology topology;
+    topology.connect(feeder, 0, mac, "macIn");
+    topology.connect(mac, "macOut", collector, 0);
+    topology.connect(mac, "phyOut", mac, "phyIn"); //loopback phy data path
+    topology.connect(mac, "phyOut", phyCollector, 0);
+
+    //run the design
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+
+    //the phy packets have the header in front of the payload
+    const std::vector<Pothos::Packet> phyPackets = phyCollector.call("getPackets");
+    POTHOS_TEST_EQUAL(phyPackets.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        POTHOS_TEST_EQUAL(phyPackets.at(i).payload.elements(), 7 + expected[i].size());
+        POTHOS_TEST_EQUALA(phyPackets.at(i).payload.as<const unsigned char *>() + 7, expected[i].data(), expected[i].size());
+    }
+
+    //the unique payload grows in place, the shared payload is copied
+    POTHOS_TEST_EQUAL(phyPackets.at(0).payload.address, uniqueAddress - 7);
+    POTHOS_TEST_TRUE(phyPackets.at(1).payload.address != pkt1.payload.address - 7);
+
+    //the copy leaves the bytes in front of the shared payload alone
+    const std::vector<unsigned char> marker(7, 0xa5);
+    POTHOS_TEST_EQUALA(pkt1.payload.as<const unsigned char *>() - 7, marker.data(), marker.size());
+
+    //check the result
+    POTHOS_TEST_EQUAL(mac.call<unsigned long long>("getErrorCount"), 0);
+    const std::vector<Pothos::Packet> packets = collector.call("getPackets");
+    POTHOS_TEST_EQUAL(packets.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        POTHOS_TEST_EQUAL(packets.at(i).payload.elements(), expected[i].size());
+        POTHOS_TEST_EQUALA(packets.at(i).payload.as<const unsigned char *>(), expected[i].data(), expected[i].size());
+    }
+}